@@ -69,3 +69,52 @@ function(amdinfer_add_targets targets target_objects base_targets
   set(${targets} ${new_targets} PARENT_SCOPE)
   set(${target_objects} ${new_target_objects} PARENT_SCOPE)
 endfunction()
+
+# Get the objects of the object and static libraries that the targets pull in,
+# following their interface link libraries
+function(amdinfer_get_target_objects target_objects)
+  set(objects "")
+  set(visited "")
+  set(pending ${ARGN})
+  while(pending)
+    list(POP_FRONT pending target)
+    if(target MATCHES "^\\$<TARGET_OBJECTS:(.+)>$")
+      set(target ${CMAKE_MATCH_1})
+    endif()
+    if(NOT TARGET ${target} OR target IN_LIST visited)
+      continue()
+    endif()
+    list(APPEND visited ${target})
+
+    get_target_property(imported ${target} IMPORTED)
+    if(imported)
+      continue()
+    endif()
+    get_target_property(type ${target} TYPE)
+    if(type STREQUAL "OBJECT_LIBRARY" OR type STREQUAL "STATIC_LIBRARY")
+      list(APPEND objects "$<TARGET_OBJECTS:${target}>")
+    endif()
+    get_target_property(links ${target} INTERFACE_LINK_LIBRARIES)
+    if(links)
+      list(APPEND pending ${links})
+    endif()
+  endwhile()
+
+  set(${target_objects} ${objects} PARENT_SCOPE)
+endfunction()
+
+# Link the targets into one of the output libraries. Static libraries aren't
+# linked so the targets' objects are archived instead and the targets are only
+# used for their usage requirements while building
+function(amdinfer_link_output_library library)
+  if(${AMDINFER_BUILD_SHARED})
+    target_link_libraries(${library} PRIVATE ${ARGN})
+  else()
+    amdinfer_get_target_objects(objects ${ARGN})
+    target_sources(${library} PRIVATE ${objects})
+
+    set(build_targets ${ARGN})
+    list(TRANSFORM build_targets REPLACE "^(.+)$" "$<BUILD_INTERFACE:\\1>")
+    target_link_libraries(${library} PRIVATE ${build_targets})
+  endif()
+endfunction()
@@ -22,6 +22,7 @@
 #include "amdinfer/clients/http.hpp"
 #include "amdinfer/clients/native.hpp"
 #include "amdinfer/core/data_types.hpp"
+#include "amdinfer/core/endpoint_handle.hpp"
 #include "amdinfer/core/exceptions.hpp"
 #include "amdinfer/core/inference_request.hpp"
 #include "amdinfer/core/inference_response.hpp"
@@ -102,6 +102,17 @@ class Client {
    */
   void modelUnload(const std::string& model,
                    const std::string& version = "") const;
+  /**
+   * @brief Changes how a loaded model batches requests and how many workers
+   * it has without reloading it. Batching changes apply from the next batch.
+   *
+   * @param model name of the loaded model
+   * @param parameters any of "batch_size", up to the batch size the model was
+   * loaded with, "timeout" in milliseconds and "workers"
+   * @param version version of the model to change
+   */
+  void modelConfigure(const std::string& model, const ParameterMap& parameters,
+                      const std::string& version = "") const;
 
   /**
    * @brief Makes a synchronous inference request to the given model/worker. The
@@ -211,6 +222,17 @@ class Client {
    */
   virtual void modelUnloadImpl(const std::string& model,
                                const std::string& version) const = 0;
+  /**
+   * @brief Changes how a loaded model batches requests and how many workers
+   * it has without reloading it
+   *
+   * @param model name of the loaded model
+   * @param parameters the batching parameters and worker count to change
+   * @param version version of the model to change
+   */
+  virtual void modelConfigureImpl(const std::string& model,
+                                  const ParameterMap& parameters,
+                                  const std::string& version) const = 0;
 
   /**
    * @brief Makes a synchronous inference request to the given model/worker. The
@@ -173,6 +173,16 @@ class HttpClient : public Client {
    */
   void modelUnloadImpl(const std::string& model,
                        const std::string& version) const override;
+  /**
+   * @brief Changes how a loaded model batches requests and how many workers
+   * it has without reloading it
+   *
+   * @param model name of the loaded model
+   * @param parameters the batching parameters and worker count to change
+   */
+  void modelConfigureImpl(const std::string& model,
+                          const ParameterMap& parameters,
+                          const std::string& version) const override;
 
   /**
    * @brief Makes a synchronous inference request to the given model/worker. The
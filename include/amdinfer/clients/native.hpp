@@ -26,8 +26,9 @@
 #include <string>  // for string
 #include <vector>  // for vector
 
-#include "amdinfer/clients/client.hpp"  // IWYU pragma: export
-#include "amdinfer/declarations.hpp"    // for InferenceResponseFuture
+#include "amdinfer/clients/client.hpp"        // IWYU pragma: export
+#include "amdinfer/core/endpoint_handle.hpp"  // IWYU pragma: export
+#include "amdinfer/declarations.hpp"          // for InferenceResponseFuture
 
 namespace amdinfer {
 
@@ -127,6 +128,58 @@ class NativeClient : public Client {
   [[nodiscard]] bool hasHardware(const std::string& name,
                                  int num) const override;
 
+  /**
+   * @brief Replaces a loaded model with a version from the model repository
+   * without dropping requests. The new version is loaded and warmed up
+   * alongside the old one and new requests are then redirected to it. The old
+   * version finishes the requests it already has before it's unloaded.
+   *
+   * @param model name of the loaded model to replace
+   * @param parameters load-time parameters for the new version
+   * @param version version to load from the model repository directory. Empty
+   * to reload the default version
+   * @throws invalid_argument if the model is not loaded
+   */
+  void modelSwap(const std::string& model, const ParameterMap& parameters,
+                 const std::string& version = "") const;
+
+  using Client::modelInfer;
+  using Client::modelInferAsync;
+
+  /**
+   * @brief Resolves a model to a handle that can be reused to make inference
+   * requests to it without looking up the model by name each time
+   *
+   * @param model name of the model/worker
+   * @param version version of the model
+   * @return EndpointHandle
+   * @throws invalid_argument if the model is not loaded
+   */
+  [[nodiscard]] EndpointHandle modelHandle(
+    const std::string& model, const std::string& version = "") const;
+  /**
+   * @brief Makes a synchronous inference request to the model identified by
+   * the handle. If the model has been reloaded since the handle was resolved,
+   * the handle is resolved again and updated.
+   *
+   * @param handle handle to the model from modelHandle
+   * @param request the request
+   * @return InferenceResponse
+   */
+  [[nodiscard]] InferenceResponse modelInfer(
+    EndpointHandle* handle, const InferenceRequest& request) const;
+  /**
+   * @brief Makes an asynchronous inference request to the model identified by
+   * the handle. If the model has been reloaded since the handle was resolved,
+   * the handle is resolved again and updated.
+   *
+   * @param handle handle to the model from modelHandle
+   * @param request the request
+   * @return InferenceResponseFuture
+   */
+  [[nodiscard]] InferenceResponseFuture modelInferAsync(
+    EndpointHandle* handle, const InferenceRequest& request) const;
+
  private:
   struct NativeClientImpl;
   std::unique_ptr<NativeClientImpl> impl_;
@@ -167,6 +220,16 @@ class NativeClient : public Client {
    */
   void modelUnloadImpl(const std::string& model,
                        const std::string& version) const override;
+  /**
+   * @brief Changes how a loaded model batches requests and how many workers
+   * it has without reloading it
+   *
+   * @param model name of the loaded model
+   * @param parameters the batching parameters and worker count to change
+   */
+  void modelConfigureImpl(const std::string& model,
+                          const ParameterMap& parameters,
+                          const std::string& version) const override;
 
   /**
    * @brief Makes a synchronous inference request to the given model/worker. The
@@ -149,6 +149,26 @@ class WebSocketClient : public Client {
    * @return std::string a JSON object encoded as a string
    */
   [[nodiscard]] std::string modelRecv() const;
+  /**
+   * @brief Makes a websocket inference request to the given model/worker using
+   * binary frames. Unlike modelInferWs, the tensor data is sent as raw bytes
+   * without any text encoding and the response contains all the outputs, not
+   * just the first one. Use modelRecvBinary to get the responses.
+   *
+   * @param model
+   * @param request
+   */
+  void modelInferWsBinary(const std::string& model,
+                          const InferenceRequest& request) const;
+  /**
+   * @brief Gets one message from the websocket server sent in response to a
+   * modelInferWsBinary request. Like modelRecv, the user should call this
+   * method once for each expected message.
+   *
+   * @return InferenceResponse
+   * @throws invalid_argument if the message is not a binary response frame
+   */
+  [[nodiscard]] InferenceResponse modelRecvBinary() const;
   /**
    * @brief Closes the websocket connection
    *
@@ -195,6 +215,16 @@ class WebSocketClient : public Client {
    */
   void modelUnloadImpl(const std::string& model,
                        const std::string& version) const override;
+  /**
+   * @brief Changes how a loaded model batches requests and how many workers
+   * it has without reloading it
+   *
+   * @param model name of the loaded model
+   * @param parameters the batching parameters and worker count to change
+   */
+  void modelConfigureImpl(const std::string& model,
+                          const ParameterMap& parameters,
+                          const std::string& version) const override;
 
   /**
    * @brief Makes a synchronous inference request to the given model/worker. The
@@ -0,0 +1,49 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines the EndpointHandle used to send requests without looking up
+ * the model by name each time
+ */
+
+#ifndef GUARD_AMDINFER_CORE_ENDPOINT_HANDLE
+#define GUARD_AMDINFER_CORE_ENDPOINT_HANDLE
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <string>   // for string
+
+namespace amdinfer {
+
+/**
+ * @brief A model and version resolved to a loaded endpoint on the server. The
+ * index and generation identify the endpoint directly. If the endpoint is
+ * unloaded or reloaded, its generation changes and the handle is resolved
+ * again from the model and version the next time it's used.
+ */
+struct EndpointHandle {
+  /// Name of the model
+  std::string model;
+  /// Version of the model. Empty for the default version
+  std::string version;
+  /// Position of the endpoint in the server's endpoint table
+  size_t index = 0;
+  /// Generation of the endpoint. Zero is never valid
+  uint64_t generation = 0;
+};
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_CORE_ENDPOINT_HANDLE
@@ -95,7 +95,7 @@ class InferenceResponse {
   explicit InferenceResponse(const std::string &error);
 
   /// Gets a vector of the requested output information
-  [[nodiscard]] std::vector<InferenceResponseOutput> getOutputs() const;
+  [[nodiscard]] const std::vector<InferenceResponseOutput> &getOutputs() const;
   /**
    * @brief Adds an output tensor to the response
    *
@@ -110,7 +110,7 @@ class InferenceResponse {
   /// sets the model name of the response
   void setModel(const std::string &model);
   /// gets the model name of the response
-  std::string getModel();
+  std::string getModel() const;
 
   /// Checks if this is an error response
   bool isError() const;
@@ -130,6 +130,12 @@ class InferenceResponse {
 
   /// Gets a pointer to the parameters associated with this response
   ParameterMap *getParameters() { return this->parameters_.get(); }
+  /// Gets a pointer to the parameters associated with this response
+  [[nodiscard]] const ParameterMap *getParameters() const {
+    return this->parameters_.get();
+  }
+  /// Sets the parameters associated with this response
+  void setParameters(ParameterMap parameters);
 
   /// Provides an implementation to print the class with std::cout to an ostream
   friend std::ostream &operator<<(std::ostream &os,
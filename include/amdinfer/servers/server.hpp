@@ -16,12 +16,72 @@
 #ifndef GUARD_AMDINFER_SERVERS_SERVER
 #define GUARD_AMDINFER_SERVERS_SERVER
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <string>
+#include <vector>
+
+#include "amdinfer/build_options.hpp"
 
 namespace amdinfer {
 
+/// Options to configure compression of responses sent by the servers
+struct CompressionOptions {
+  /// Compress responses if the client accepts a supported encoding
+  bool enable = true;
+  /// Responses smaller than this size in bytes are sent uncompressed
+  size_t threshold = kDefaultCompressionThreshold;
+  /**
+   * @brief Compression level passed to the compression library e.g. 1-9 for
+   * gzip. A negative value uses the library's default level. For gRPC, this
+   * maps to gRPC's none/low/medium/high levels.
+   */
+  int level = -1;
+};
+
+/// An address for the HTTP server to listen on
+struct HttpListener {
+  /// IP address to bind to e.g. 0.0.0.0 or 127.0.0.1
+  std::string address;
+  /// Port to bind to. If zero, the port passed to startHttp() is used
+  uint16_t port = 0;
+};
+
+/// Options to configure the HTTP server's connection handling
+struct HttpOptions {
+  /// Number of IO threads. If zero, one thread per CPU core is used
+  size_t threads = kDefaultDrogonThreads;
+  /// Addresses to listen on
+  std::vector<HttpListener> listeners{{"0.0.0.0", 0}};
+  /// Close connections after this many requests. Zero means no limit
+  size_t keepalive_requests = 0;
+  /// Maximum number of pipelined requests per connection. Zero means no limit
+  size_t pipelining_requests = 0;
+  /// Close connections that are idle for this many seconds. Zero means never
+  size_t idle_timeout = kDefaultHttpIdleTimeout;
+  /// Maximum size of a request body in bytes, after any decompression
+  size_t max_body_size = kMaxClientBodySize;
+  /// Add an "Access-Control-Allow-Origin: *" header to all responses
+  bool cors = false;
+};
+
+/// Options to load models from the model repository when they're first used
+struct ModelCacheOptions {
+  /**
+   * @brief Unload the least recently used idle models once more than this
+   * many are loaded on demand. Zero means no limit
+   */
+  size_t max_models = 0;
+  /**
+   * @brief Unload the least recently used idle models once the size of the
+   * files of the models loaded on demand exceeds this many bytes. Zero means
+   * no limit
+   */
+  size_t max_bytes = 0;
+};
+
 class Server {
  public:
   /// Constructs a new Server object
@@ -53,6 +113,20 @@ class Server {
   void startGrpc(uint16_t port) const;
   /// Stop the gRPC server
   void stopGrpc() const;
+  /**
+   * @brief Set how the servers compress responses. This must be called before
+   * starting the servers to take effect.
+   *
+   * @param options compression options
+   */
+  void setCompression(const CompressionOptions& options);
+  /**
+   * @brief Set how the HTTP server handles connections. This must be called
+   * before starting the HTTP server to take effect.
+   *
+   * @param options HTTP options
+   */
+  void setHttpOptions(const HttpOptions& options);
 
   /**
    * @brief Set the path to the model repository associated with this server
@@ -72,6 +146,23 @@ class Server {
    * platforms.
    */
   void enableRepositoryMonitoring(bool use_polling);
+  /**
+   * @brief Load models from the model repository on the first inference
+   * request that targets them. Requests wait while the model loads. A model
+   * repository must be set with setModelRepository() before calling this
+   * method.
+   *
+   * @param options limits on the models loaded on demand
+   */
+  void enableModelCache(const ModelCacheOptions& options);
+  /**
+   * @brief Set the byte budget shared by the response caches of the models
+   * loaded with the "response_cache" parameter set. The least recently used
+   * responses are evicted to stay within it.
+   *
+   * @param max_bytes the byte budget. Zero disables response caching
+   */
+  void setResponseCacheSize(size_t max_bytes);
 
   friend class NativeClient;
 
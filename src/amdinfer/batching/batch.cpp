@@ -19,9 +19,11 @@
 
 #include "amdinfer/batching/batch.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 #include "amdinfer/buffers/buffer.hpp"
+#include "amdinfer/core/inference_request.hpp"
 #include "amdinfer/observation/tracing.hpp"
 
 namespace amdinfer {
@@ -69,6 +71,27 @@ size_t Batch::getInputSize() const { return input_buffers_.size(); }
 
 size_t Batch::getOutputSize() const { return output_buffers_.size(); }
 
+void Batch::setRagged(bool ragged) { ragged_ = ragged; }
+
+bool Batch::isRagged() const { return ragged_; }
+
+void Batch::setPaddedSize(size_t padded_size) { padded_size_ = padded_size; }
+
+size_t Batch::getPaddedSize() const {
+  return std::max(padded_size_, requests_.size());
+}
+
+std::vector<size_t> Batch::getInputOffsets(size_t input) const {
+  std::vector<size_t> offsets;
+  offsets.reserve(requests_.size() + 1);
+  offsets.push_back(0);
+  for (const auto& request : requests_) {
+    const auto& tensor = request->getInputs().at(input);
+    offsets.push_back(offsets.back() + tensor.getSize());
+  }
+  return offsets;
+}
+
 void Batch::setBuffers(BufferPtrs inputs, BufferPtrs outputs) {
   input_buffers_ = std::move(inputs);
   output_buffers_ = std::move(outputs);
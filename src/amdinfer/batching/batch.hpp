@@ -20,6 +20,9 @@
 #ifndef GUARD_AMDINFER_BATCHING_BATCH
 #define GUARD_AMDINFER_BATCHING_BATCH
 
+#include <cstddef>  // for size_t
+#include <vector>   // for vector
+
 #include "amdinfer/build_options.hpp"
 #include "amdinfer/declarations.hpp"
 
@@ -47,6 +50,31 @@ class Batch {
   [[nodiscard]] size_t getInputSize() const;
   [[nodiscard]] size_t getOutputSize() const;
 
+  /// Mark the batch as ragged: its requests' inputs may differ in length
+  void setRagged(bool ragged);
+  /// Check if the requests' inputs may differ in length
+  [[nodiscard]] bool isRagged() const;
+  /**
+   * @brief Get the boundaries of each request's data in an input buffer. The
+   * requests' data are packed contiguously so request i's data is between
+   * elements offsets[i] and offsets[i + 1] of the buffer.
+   *
+   * @param input index of the input tensor
+   * @return std::vector<size_t> batch size + 1 offsets in elements
+   */
+  [[nodiscard]] std::vector<size_t> getInputOffsets(size_t input) const;
+
+  /**
+   * @brief Set the batch size the batch's buffers are padded to. The slots
+   * after the requests' are filled by the batcher and have no requests so no
+   * responses are made for them.
+   *
+   * @param padded_size the batch size to run the batch at
+   */
+  void setPaddedSize(size_t padded_size);
+  /// Get the batch size to run the batch at, at least the number of requests
+  [[nodiscard]] size_t getPaddedSize() const;
+
   const std::string& getModel(size_t index) const;
   void setModel(size_t index, std::string model);
   void addModel(std::string model);
@@ -68,6 +96,8 @@ class Batch {
   std::vector<BufferPtr> input_buffers_;
   std::vector<BufferPtr> output_buffers_;
   std::vector<std::string> models_;
+  bool ragged_ = false;
+  size_t padded_size_ = 0;
 #ifdef AMDINFER_ENABLE_TRACING
   std::vector<TracePtr> traces_;
 #endif
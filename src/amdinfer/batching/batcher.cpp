@@ -20,19 +20,40 @@
 
 #include "amdinfer/batching/batcher.hpp"
 
-#include <cassert>  // for assert
-#include <memory>   // for shared_ptr, make_shared
-#include <string>   // for string
-#include <utility>  // for move
+#include <algorithm>      // for max, find_if, sort
+#include <cassert>        // for assert
+#include <chrono>         // for microseconds
+#include <cstddef>        // for size_t, byte
+#include <cstdint>        // for int32_t, int64_t
+#include <memory>         // for shared_ptr, make_shared
+#include <mutex>          // for lock_guard
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for move
+#include <vector>         // for vector
 
+#include "amdinfer/batching/coalesce.hpp"       // for Coalescer
+#include "amdinfer/batching/fair_queue.hpp"     // for FairQueue
+#include "amdinfer/batching/split.hpp"          // for splitRequest
 #include "amdinfer/buffers/buffer.hpp"          // IWYU pragma: keep
+#include "amdinfer/core/exceptions.hpp"         // for runtime_error
+#include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
 #include "amdinfer/core/memory_pool/pool.hpp"   // for MemoryPool
 #include "amdinfer/core/request_container.hpp"  // for InferenceRequestInput
+#include "amdinfer/core/tensor.hpp"             // for Tensor
 #include "amdinfer/core/worker_info.hpp"        // for WorkerInfo
 #include "amdinfer/observation/logging.hpp"  // for Logger, Loggers, Logger...
+#include "amdinfer/observation/metrics.hpp"     // for Metrics, MetricCounterIDs
 
 namespace amdinfer {
 
+namespace {
+
+/// By default, requests with more input data than this aren't coalesced
+constexpr int32_t kDefaultCoalesceMaxBytes = 1 << 20;
+
+}  // namespace
+
 /**
  * @brief The C++ RequestContainer class encapsulates incoming requests from the
  * C++ API to the batcher.
@@ -52,15 +73,43 @@ Batcher::Batcher(MemoryPool* pool, ParameterMap* parameters) : Batcher(pool) {
   if (parameters != nullptr) {
     this->parameters_ = *parameters;
   }
+  if (this->parameters_.has("coalesce_requests") &&
+      this->parameters_.get<bool>("coalesce_requests")) {
+    auto max_bytes = kDefaultCoalesceMaxBytes;
+    if (this->parameters_.has("coalesce_max_bytes")) {
+      max_bytes = this->parameters_.get<int32_t>("coalesce_max_bytes");
+    }
+    this->coalescer_ =
+      std::make_shared<Coalescer>(static_cast<size_t>(max_bytes));
+  }
+  if (this->parameters_.has("fair_queuing") &&
+      this->parameters_.get<bool>("fair_queuing")) {
+    std::unordered_map<std::string, double> weights;
+    if (this->parameters_.has("client_weights")) {
+      weights = parseClientWeights(
+        this->parameters_.get<std::string>("client_weights"));
+    }
+    this->fair_queue_ = std::make_shared<FairQueue>(this->input_queue_.get(),
+                                                    std::move(weights));
+  }
+  this->split_requests_ = this->parameters_.has("split_requests") &&
+                          this->parameters_.get<bool>("split_requests");
 }
 
 Batcher::Batcher(const Batcher& batcher)
   : batch_size_(batcher.batch_size_),
+    batch_sizes_(batcher.batch_sizes_),
+    padding_(batcher.padding_),
+    streaming_(batcher.streaming_),
     input_queue_(batcher.input_queue_),
     output_queue_(batcher.output_queue_),
     model_(batcher.model_),
-    pool_(batcher.pool_) {
+    parameters_(batcher.parameters_),
+    pool_(batcher.pool_),
+    coalescer_(batcher.coalescer_),
+    fair_queue_(batcher.fair_queue_) {
   this->status_ = BatcherStatus::New;
+  this->split_requests_ = batcher.split_requests_.load();
 #ifdef AMDINFER_ENABLE_LOGGING
   this->logger_ = Logger(Loggers::Server);
 #endif
@@ -75,6 +124,171 @@ void Batcher::setBatchSize(size_t batch_size) {
   this->batch_size_ = batch_size;
 }
 
+void Batcher::setBatchSizes(std::vector<size_t> batch_sizes,
+                            BatchPadding padding) {
+  std::sort(batch_sizes.begin(), batch_sizes.end());
+  this->batch_sizes_ = std::move(batch_sizes);
+  this->padding_ = padding;
+}
+
+void Batcher::setStreaming(bool streaming) { this->streaming_ = streaming; }
+
+bool Batcher::isStreaming() const { return this->streaming_; }
+
+void Batcher::configure(const ParameterMap& parameters) {
+  const std::lock_guard lock{this->changes_mutex_};
+  for (const auto& [key, value] : parameters) {
+    this->changes_.put(key, value);
+  }
+  // enqueue() reads this on the callers' threads so it can't wait for the
+  // batcher thread to apply the change to parameters_
+  if (parameters.has("split_requests")) {
+    this->split_requests_ = parameters.get<bool>("split_requests");
+  }
+  this->changed_ = true;
+}
+
+bool Batcher::reconfigure() {
+  if (!this->changed_.exchange(false)) {
+    return false;
+  }
+  const std::lock_guard lock{this->changes_mutex_};
+  for (const auto& [key, value] : this->changes_) {
+    this->parameters_.put(key, value);
+  }
+  if (this->changes_.has("batch_size")) {
+    this->batch_size_ = this->changes_.get<int32_t>("batch_size");
+  }
+  this->changes_ = ParameterMap{};
+  return true;
+}
+
+bool Batcher::isRagged() const {
+  return this->parameters_.has("ragged") &&
+         this->parameters_.get<bool>("ragged");
+}
+
+bool Batcher::fitsRagged(const Batch& batch, const InferenceRequest& request) {
+  if (batch.empty()) {
+    return true;
+  }
+  const auto& inputs = request.getInputs();
+  const auto& batch_inputs = batch.getRequests().front()->getInputs();
+  if (inputs.size() != batch_inputs.size()) {
+    return false;
+  }
+  for (auto i = 0U; i < inputs.size(); ++i) {
+    if (inputs[i].getDatatype() != batch_inputs[i].getDatatype()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Batcher::packRagged(
+  Batch* batch, const std::vector<MemoryAllocators>& allocators) const {
+  const auto& requests = batch->getRequests();
+  const auto input_size = requests.front()->getInputs().size();
+
+  std::vector<BufferPtr> input_buffers;
+  input_buffers.reserve(input_size);
+  try {
+    for (auto i = 0U; i < input_size; ++i) {
+      const auto& input = requests.front()->getInputs()[i];
+      const auto offsets = batch->getInputOffsets(i);
+      // the buffer holds every request's data, at least one element so it's
+      // never empty
+      const auto length = std::max(offsets.back(), size_t{1});
+      const Tensor tensor{input.getName(),
+                          {static_cast<int64_t>(length)},
+                          input.getDatatype()};
+      input_buffers.push_back(pool_->get(allocators, tensor, 1));
+    }
+  } catch (const runtime_error& e) {
+    for (const auto& request : requests) {
+      for (const auto& input : request->getInputs()) {
+        pool_->put(MemoryAllocators::Cpu, input.getData());
+      }
+      request->runCallbackError(e.what());
+    }
+    return false;
+  }
+
+  for (auto i = 0U; i < input_size; ++i) {
+    const auto& input_buffer = input_buffers[i];
+    size_t offset = 0;
+    for (const auto& request : requests) {
+      const auto& input = request->getInputs()[i];
+      auto new_offset =
+        input_buffer->write(input.getData(), offset,
+                            input.getSize() * input.getDatatype().size());
+      pool_->put(MemoryAllocators::Cpu, input.getData());
+      request->setInputTensorData(i, input_buffer->data(offset));
+      offset = new_offset;
+    }
+  }
+  batch->setBuffers(std::move(input_buffers), {});
+  batch->setRagged(true);
+  return true;
+}
+
+size_t Batcher::getBufferBatchSize() const {
+  // a configured batch size may be smaller than what the worker supports so
+  // leave space to pad complete batches to a supported size
+  const auto supported = std::lower_bound(batch_sizes_.begin(),
+                                          batch_sizes_.end(), batch_size_);
+  return supported == batch_sizes_.end() ? batch_size_ : *supported;
+}
+
+void Batcher::pad(Batch* batch) const {
+  if (batch_sizes_.empty()) {
+    return;
+  }
+  const auto batch_size = batch->size();
+  // the buffers only have space for getBufferBatchSize() requests
+  const auto buffer_batch_size = this->getBufferBatchSize();
+  const auto supported = std::find_if(
+    batch_sizes_.begin(), batch_sizes_.end(), [&](size_t size) {
+      return size >= batch_size && size <= buffer_batch_size;
+    });
+  const auto padded_size =
+    supported == batch_sizes_.end() ? batch_size : *supported;
+
+  const auto& request = batch->getRequest(0);
+  const auto& input_buffers = batch->getInputBuffers();
+  for (auto i = 0U; i < input_buffers.size() && padded_size > batch_size;
+       ++i) {
+    const auto& input = request->getInputs()[i];
+    const auto& input_buffer = input_buffers[i];
+    const auto size = input.getSize() * input.getDatatype().size();
+    std::vector<std::byte> zeros;
+    void* source = input_buffer->data(0);
+    if (padding_ == BatchPadding::Zeros) {
+      zeros.resize(size);
+      source = zeros.data();
+    }
+    for (auto slot = batch_size; slot < padded_size; ++slot) {
+      input_buffer->write(source, slot * size, size);
+    }
+  }
+  batch->setPaddedSize(padded_size);
+
+#ifdef AMDINFER_ENABLE_METRICS
+  Metrics::getInstance().incrementCounter(MetricCounterIDs::BatchSlotsRequest,
+                                          batch_size);
+  Metrics::getInstance().incrementCounter(MetricCounterIDs::BatchSlotsPadding,
+                                          padded_size - batch_size);
+#endif
+}
+
+void Batcher::rejectRequest(const InferenceRequestPtr& request,
+                            const std::string& error) const {
+  for (const auto& input : request->getInputs()) {
+    this->pool_->put(MemoryAllocators::Cpu, input.getData());
+  }
+  request->runCallbackError(error);
+}
+
 void Batcher::setName(const std::string& name) { this->model_ = name; }
 
 std::string Batcher::getName() const { return this->model_; }
@@ -85,10 +299,63 @@ BlockingQueue<RequestContainerPtr>* Batcher::getInputQueue() {
 
 BatchPtrQueue* Batcher::getOutputQueue() { return this->output_queue_.get(); }
 
+size_t Batcher::getQueueSize() const {
+  if (this->fair_queue_ != nullptr) {
+    return this->fair_queue_->size();
+  }
+  return this->input_queue_->size_approx();
+}
+
+bool Batcher::tryDequeue(RequestContainerPtr* request) {
+  if (this->fair_queue_ != nullptr) {
+    return this->fair_queue_->tryDequeue(request);
+  }
+  return this->input_queue_->try_dequeue(*request);
+}
+
+void Batcher::dequeue(RequestContainerPtr* request) {
+  if (this->fair_queue_ != nullptr) {
+    this->fair_queue_->dequeue(request);
+  } else {
+    this->input_queue_->wait_dequeue(*request);
+  }
+}
+
+bool Batcher::dequeue(RequestContainerPtr* request,
+                      std::chrono::microseconds timeout) {
+  if (this->fair_queue_ != nullptr) {
+    return this->fair_queue_->dequeue(request, timeout);
+  }
+  return this->input_queue_->wait_dequeue_timed(*request, timeout);
+}
+
 void Batcher::enqueue(RequestContainerPtr request) const {
+  // the steps of a stateful sequence must each run even if they're identical
+  // and the requests attached to a streamed one would miss its later responses
+  if (request != nullptr && this->coalescer_ != nullptr &&
+      !this->isStateful() && !this->streaming_ &&
+      this->coalescer_->attach(request.get(), this->pool_)) {
+    return;
+  }
+  if (request != nullptr && this->split_requests_) {
+    try {
+      auto samples = splitRequest(request.get(), this->pool_);
+      if (!samples.empty()) {
+        for (auto& sample : samples) {
+          this->input_queue_->enqueue(std::move(sample));
+        }
+        return;
+      }
+    } catch (const runtime_error& e) {
+      request->request->runCallbackError(e.what());
+      return;
+    }
+  }
   this->input_queue_->enqueue(std::move(request));
 }
 
+bool Batcher::isStateful() const { return false; }
+
 void Batcher::run(const std::vector<MemoryAllocators>& allocators) {
   this->doRun(allocators);
   this->status_ = BatcherStatus::Inactive;
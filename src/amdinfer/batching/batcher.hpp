@@ -21,8 +21,11 @@
 #ifndef GUARD_AMDINFER_BATCHING_BATCHER
 #define GUARD_AMDINFER_BATCHING_BATCHER
 
+#include <atomic>   // for atomic
+#include <chrono>   // for microseconds
 #include <cstddef>  // for size_t
 #include <memory>   // for unique_ptr, shared_ptr
+#include <mutex>    // for mutex
 #include <string>   // for string
 #include <thread>   // for thread
 #include <vector>   // for vector
@@ -37,6 +40,8 @@
 
 namespace amdinfer {
 class Buffer;
+class Coalescer;
+class FairQueue;
 class WorkerInfo;
 class MemoryPool;
 enum class MemoryAllocators;
@@ -46,6 +51,9 @@ namespace amdinfer {
 
 enum class BatcherStatus { New, Run, Inactive, Dead };
 
+/// Defines what fills the slots of a batch padded to a supported batch size
+enum class BatchPadding { Zeros, Replicate };
+
 using BatchPtrQueue = BlockingQueue<BatchPtr>;
 
 /**
@@ -84,6 +92,35 @@ class Batcher {
    * @param batch_size target batch size
    */
   void setBatchSize(size_t batch_size);
+  /**
+   * @brief Set the batch sizes the worker supports. Complete batches are padded
+   * to the smallest of these sizes that fits them. If the batch size is
+   * configured below a supported size, the buffers are allocated for the
+   * smallest supported size above it so batches can still be padded. If empty,
+   * batches aren't padded.
+   *
+   * @param batch_sizes supported batch sizes
+   * @param padding what to fill the padded slots with
+   */
+  void setBatchSizes(std::vector<size_t> batch_sizes, BatchPadding padding);
+  /**
+   * @brief Set whether the worker may respond to a request more than once.
+   * Requests to streaming workers aren't coalesced because the requests
+   * attached to one would only get its first response.
+   *
+   * @param streaming whether the worker streams responses
+   */
+  void setStreaming(bool streaming);
+  /// Check if the worker may respond to a request more than once
+  [[nodiscard]] bool isStreaming() const;
+  /**
+   * @brief Change the batcher's batch size and parameters, such as the
+   * timeout, while it runs. They take effect when the batcher starts its next
+   * batch so a batch in progress finishes with the old values.
+   *
+   * @param parameters the parameters to change. Others keep their values
+   */
+  void configure(const ParameterMap& parameters);
   /**
    * @brief Set the name of the batcher (i.e. the batcher's worker group
    * endpoint)
@@ -98,13 +135,27 @@ class Batcher {
   BlockingQueue<RequestContainerPtr>* getInputQueue();
   /// Get the batcher's output queue (used to push batches to the worker group)
   BatchPtrQueue* getOutputQueue();
+  /// Get the approximate number of requests waiting to be batched
+  [[nodiscard]] size_t getQueueSize() const;
+  /**
+   * @brief Take the next waiting request without blocking
+   *
+   * @param request the next request
+   * @return bool false if no request was waiting
+   */
+  bool tryDequeue(RequestContainerPtr* request);
 
   void run(const std::vector<MemoryAllocators>& allocators);
 
   BatcherStatus getStatus() const;
 
   /**
-   * @brief Enqueue a new request to the batcher
+   * @brief Enqueue a new request to the batcher. If the "coalesce_requests"
+   * parameter is set, a request that's identical to one in flight shares its
+   * response instead of being enqueued. If the "split_requests" parameter is
+   * set, a request with many samples is enqueued as one request per sample so
+   * each sample takes one slot of a batch and the samples can be spread over
+   * multiple batches.
    *
    * @param request
    */
@@ -113,12 +164,102 @@ class Batcher {
   /// End the batcher
   void end();
 
+  /**
+   * @brief Check if the batcher's requests depend on state kept by the worker
+   * that ran the requests before them, so the worker group can only have one
+   * worker
+   *
+   * @return bool
+   */
+  [[nodiscard]] virtual bool isStateful() const;
+
  protected:
 #ifdef AMDINFER_ENABLE_LOGGING
   [[nodiscard]] const Logger& getLogger() const;
 #endif
+  /**
+   * @brief Apply the changes passed to configure() since the last call. The
+   * batcher calls this at the start of each batch.
+   *
+   * @return bool true if the parameters changed
+   */
+  bool reconfigure();
+
+  /**
+   * @brief Check if the batcher makes ragged batches, set by the "ragged"
+   * parameter. The requests in a ragged batch may have inputs of different
+   * lengths and their data is copied into buffers once the batch is complete.
+   *
+   * @return bool
+   */
+  [[nodiscard]] bool isRagged() const;
+  /**
+   * @brief Check if a request can be added to a ragged batch. It must have the
+   * same number of inputs with the same datatypes as the batch's requests.
+   *
+   * @param batch the batch being made
+   * @param request the request to add
+   * @return bool
+   */
+  [[nodiscard]] static bool fitsRagged(const Batch& batch,
+                                       const InferenceRequest& request);
+  /**
+   * @brief Copy the inputs of a complete ragged batch's requests contiguously
+   * into buffers sized for their total length. If the buffers can't be
+   * allocated, the requests are failed.
+   *
+   * @param batch the batch to pack
+   * @param allocators allocators that may be used to get the buffers
+   * @return bool true if the batch was packed
+   */
+  bool packRagged(Batch* batch,
+                  const std::vector<MemoryAllocators>& allocators) const;
+  /**
+   * @brief Get the number of requests a batch's input buffers are allocated
+   * for. It's the smallest supported batch size that's at least the batch
+   * size, or the batch size if there's none.
+   *
+   * @return size_t
+   */
+  [[nodiscard]] size_t getBufferBatchSize() const;
+  /**
+   * @brief Pad a complete batch to the smallest supported batch size that fits
+   * it by filling the unused slots of its input buffers
+   *
+   * @param batch the batch to pad
+   */
+  void pad(Batch* batch) const;
+  /**
+   * @brief Return a request's input buffers to the pool and respond to it with
+   * an error. Used for requests that are dropped before they join a batch.
+   *
+   * @param request the request to reject
+   * @param error the error message
+   */
+  void rejectRequest(const InferenceRequestPtr& request,
+                     const std::string& error) const;
+
+  /**
+   * @brief Wait for the next request to batch. If the "fair_queuing" parameter
+   * is set, waiting requests are taken in weighted fair order across clients
+   * instead of the order they arrived in.
+   *
+   * @param request the next request
+   */
+  void dequeue(RequestContainerPtr* request);
+  /**
+   * @brief Wait up to a timeout for the next request to batch
+   *
+   * @param request the next request
+   * @param timeout how long to wait
+   * @return bool false if there was no request in time
+   */
+  bool dequeue(RequestContainerPtr* request, std::chrono::microseconds timeout);
 
   size_t batch_size_ = 1;
+  std::vector<size_t> batch_sizes_;
+  BatchPadding padding_ = BatchPadding::Zeros;
+  bool streaming_ = false;
   std::shared_ptr<BlockingQueue<RequestContainerPtr>> input_queue_;
   std::shared_ptr<BatchPtrQueue> output_queue_;
   std::thread thread_;
@@ -127,6 +268,11 @@ class Batcher {
   MemoryPool* pool_;
 
  private:
+  /// Shares the responses of identical requests in flight, if enabled
+  std::shared_ptr<Coalescer> coalescer_;
+  /// Orders the waiting requests across clients, if enabled
+  std::shared_ptr<FairQueue> fair_queue_;
+
   /**
    * @brief The doRun method defines the exact process by which the batcher
    * consumes incoming RequestContainer objects and uses them to create batches.
@@ -135,7 +281,13 @@ class Batcher {
    */
   virtual void doRun(const std::vector<MemoryAllocators>& allocators) = 0;
 
-  BatcherStatus status_;
+  std::atomic<BatcherStatus> status_;
+  /// Changes from configure() that the batcher hasn't applied yet
+  ParameterMap changes_;
+  std::mutex changes_mutex_;
+  std::atomic<bool> changed_ = false;
+  /// The "split_requests" parameter, kept apart so enqueue() can read it
+  std::atomic<bool> split_requests_ = false;
 
 #ifdef AMDINFER_ENABLE_LOGGING
   Logger logger_{Loggers::Server};
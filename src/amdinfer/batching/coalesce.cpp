@@ -0,0 +1,154 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements how identical requests in flight share one execution
+ */
+
+#include "amdinfer/batching/coalesce.hpp"
+
+#include <cstddef>   // for size_t
+#include <cstdint>   // for int64_t
+#include <optional>  // for optional, nullopt
+#include <string>    // for string
+#include <utility>   // for move, pair
+#include <variant>   // for visit
+#include <vector>    // for vector
+
+#include "amdinfer/build_options.hpp"            // for AMDINFER_ENABLE_METRICS
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"    // for MemoryPool
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/core/request_container.hpp"   // for RequestContainer
+#include "amdinfer/observation/metrics.hpp"      // for Metrics, MetricCoun...
+
+namespace amdinfer {
+
+/// A request in flight and the requests attached to it
+struct Coalescer::Flight {
+  std::string key;
+  /// The ID and callback of each attached request
+  std::vector<std::pair<std::string, Callback>> waiters;
+};
+
+namespace {
+
+/// Append the bytes of a value to the key
+template <typename T>
+void append(std::string* key, const T& value) {
+  key->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// Append a string and its length to the key so strings can't run together
+void append(std::string* key, const std::string& value) {
+  append(key, value.size());
+  key->append(value);
+}
+
+void append(std::string* key, const ParameterMap& parameters) {
+  append(key, parameters.size());
+  for (const auto& [name, value] : parameters) {
+    append(key, name);
+    append(key, value.index());
+    std::visit([&](const auto& param) { append(key, param); }, value);
+  }
+}
+
+}  // namespace
+
+std::optional<std::string> makeRequestKey(const InferenceRequest& request,
+                                          size_t max_bytes) {
+  const auto& inputs = request.getInputs();
+  size_t data_size = 0;
+  for (const auto& input : inputs) {
+    data_size += input.getSize() * input.getDatatype().size();
+  }
+  if (data_size > max_bytes) {
+    return std::nullopt;
+  }
+
+  std::string key;
+  key.reserve(data_size);
+  append(&key, request.getParameters());
+  append(&key, inputs.size());
+  for (const auto& input : inputs) {
+    append(&key, input.getName());
+    append(&key, input.getDatatype().str());
+    const auto& shape = input.getShape();
+    append(&key, shape.size());
+    key.append(reinterpret_cast<const char*>(shape.data()),
+               shape.size() * sizeof(int64_t));
+    append(&key, input.getParameters());
+    key.append(static_cast<const char*>(input.getData()),
+               input.getSize() * input.getDatatype().size());
+  }
+  for (const auto& output : request.getOutputs()) {
+    append(&key, output.getName());
+  }
+  return key;
+}
+
+Coalescer::Coalescer(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+bool Coalescer::attach(RequestContainer* request, const MemoryPool* pool) {
+  const auto& original = request->request;
+  auto key = makeRequestKey(*original, max_bytes_);
+  if (!key.has_value()) {
+    return false;
+  }
+
+  const std::lock_guard lock{mutex_};
+  if (auto found = flights_.find(key.value()); found != flights_.end()) {
+    found->second->waiters.emplace_back(original->getID(),
+                                        original->getCallback());
+    for (const auto& input : original->getInputs()) {
+      pool->put(MemoryAllocators::Cpu, input.getData());
+    }
+#ifdef AMDINFER_ENABLE_METRICS
+    Metrics::getInstance().incrementCounter(
+      MetricCounterIDs::RequestsCoalesced);
+#endif
+    return true;
+  }
+
+  auto flight = std::make_shared<Flight>();
+  flight->key = std::move(key.value());
+  flights_.emplace(flight->key, flight);
+  original->setCallback(
+    [self = shared_from_this(), flight,
+     callback = original->getCallback()](const InferenceResponse& response) {
+      std::vector<std::pair<std::string, Callback>> waiters;
+      {
+        const std::lock_guard lock{self->mutex_};
+        // a later request with the same key may be in flight if the worker
+        // responds more than once
+        if (auto found = self->flights_.find(flight->key);
+            found != self->flights_.end() && found->second == flight) {
+          self->flights_.erase(found);
+        }
+        waiters.swap(flight->waiters);
+      }
+      callback(response);
+      for (const auto& [id, waiter] : waiters) {
+        auto copy = response;
+        copy.setID(id);
+        waiter(copy);
+      }
+    });
+  return false;
+}
+
+}  // namespace amdinfer
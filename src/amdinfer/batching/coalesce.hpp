@@ -0,0 +1,89 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines how identical requests in flight share one execution
+ */
+
+#ifndef GUARD_AMDINFER_BATCHING_COALESCE
+#define GUARD_AMDINFER_BATCHING_COALESCE
+
+#include <cstddef>        // for size_t
+#include <memory>         // for shared_ptr, enable_shared_from_this
+#include <mutex>          // for mutex
+#include <optional>       // for optional
+#include <string>         // for string
+#include <string_view>    // for string_view
+#include <unordered_map>  // for unordered_map
+
+#include "amdinfer/declarations.hpp"  // for RequestContainer
+
+namespace amdinfer {
+
+class InferenceRequest;
+class MemoryPool;
+
+/**
+ * @brief Make a key that's the same for identical requests from the request's
+ * parameters, its inputs with their data and the outputs it asks for
+ *
+ * @param request the request
+ * @param max_bytes the most input data a request may have to get a key
+ * @return std::optional<std::string> the key or nothing if the request has too
+ * much input data
+ */
+std::optional<std::string> makeRequestKey(const InferenceRequest& request,
+                                          size_t max_bytes);
+
+/**
+ * @brief The Coalescer attaches requests to an identical request that's
+ * already in flight so they share its execution and response. Requests are
+ * identical if they have the same parameters, requested outputs and inputs,
+ * including the inputs' data. Comparing the data costs time so requests with
+ * more input data than a limit are never coalesced.
+ */
+class Coalescer : public std::enable_shared_from_this<Coalescer> {
+ public:
+  /**
+   * @brief Construct a new Coalescer object
+   *
+   * @param max_bytes requests with more input data than this are not coalesced
+   */
+  explicit Coalescer(size_t max_bytes);
+
+  /**
+   * @brief Attach the request to an identical one in flight, if there is one.
+   * Otherwise, later identical requests attach to this one until it responds.
+   * Each attached request gets a copy of the response with its own ID.
+   *
+   * @param request the request to attach. If it's attached, its input data is
+   * returned to the pool
+   * @param pool the memory pool the request's input data came from
+   * @return bool true if the request was attached and shouldn't run itself
+   */
+  bool attach(RequestContainer* request, const MemoryPool* pool);
+
+ private:
+  struct Flight;
+
+  size_t max_bytes_;
+  std::mutex mutex_;
+  /// The requests in flight by their key, which is owned by the Flight
+  std::unordered_map<std::string_view, std::shared_ptr<Flight>> flights_;
+};
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_BATCHING_COALESCE
@@ -0,0 +1,171 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements the weighted fair queue of requests waiting to be batched
+ */
+
+#include "amdinfer/batching/fair_queue.hpp"
+
+#include <algorithm>  // for max
+#include <exception>  // for exception
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "amdinfer/core/exceptions.hpp"         // for invalid_argument
+#include "amdinfer/core/request_container.hpp"  // for RequestContainer
+#include "amdinfer/util/string.hpp"             // for split
+
+namespace amdinfer {
+
+std::unordered_map<std::string, double> parseClientWeights(
+  const std::string& weights) {
+  std::unordered_map<std::string, double> parsed;
+  for (const auto& entry : util::split(weights, ",")) {
+    const auto separator = entry.rfind(':');
+    if (separator != std::string::npos && separator > 0) {
+      try {
+        const auto weight = std::stod(entry.substr(separator + 1));
+        if (weight > 0) {
+          parsed[entry.substr(0, separator)] = weight;
+          continue;
+        }
+      } catch (const std::exception&) {
+        // fall through to the error below
+      }
+    }
+    throw invalid_argument("Invalid client weight in client_weights: " +
+                           entry);
+  }
+  return parsed;
+}
+
+FairQueue::FairQueue(BlockingQueue<RequestContainerPtr>* input,
+                     std::unordered_map<std::string, double> weights)
+  : input_(input), weights_(std::move(weights)) {}
+
+void FairQueue::dequeue(RequestContainerPtr* request) {
+  this->dequeueUntil(request, std::chrono::steady_clock::time_point::max());
+}
+
+bool FairQueue::dequeue(RequestContainerPtr* request,
+                        std::chrono::microseconds timeout) {
+  return this->dequeueUntil(request,
+                            std::chrono::steady_clock::now() + timeout);
+}
+
+bool FairQueue::dequeueUntil(RequestContainerPtr* request,
+                             std::chrono::steady_clock::time_point deadline) {
+  const auto forever = deadline == std::chrono::steady_clock::time_point::max();
+  std::unique_lock lock{mutex_};
+  while (!this->take(request)) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      return false;
+    }
+    // another caller is already waiting on the input queue so wait for it to
+    // add a request or leave
+    if (waiting_) {
+      if (forever) {
+        cv_.wait(lock);
+      } else {
+        cv_.wait_until(lock, deadline);
+      }
+      continue;
+    }
+
+    waiting_ = true;
+    lock.unlock();
+    RequestContainerPtr next;
+    bool received = true;
+    if (forever) {
+      input_->wait_dequeue(next);
+    } else {
+      received = input_->wait_dequeue_timed(
+        next, std::chrono::duration_cast<std::chrono::microseconds>(deadline -
+                                                                     now));
+    }
+    lock.lock();
+    waiting_ = false;
+    if (received) {
+      this->push(std::move(next));
+    } else {
+      // let another caller take over waiting on the input queue
+      cv_.notify_all();
+    }
+  }
+  return true;
+}
+
+bool FairQueue::tryDequeue(RequestContainerPtr* request) {
+  const std::lock_guard lock{mutex_};
+  return this->take(request);
+}
+
+bool FairQueue::take(RequestContainerPtr* request) {
+  // take everything that has arrived so it's ordered with what's waiting
+  RequestContainerPtr next;
+  while (stops_ == 0 && input_->try_dequeue(next)) {
+    this->push(std::move(next));
+  }
+  if (this->pop(request)) {
+    return true;
+  }
+  if (stops_ > 0) {
+    --stops_;
+    *request = nullptr;
+    return true;
+  }
+  return false;
+}
+
+size_t FairQueue::size() const {
+  const std::lock_guard lock{mutex_};
+  return requests_.size() + input_->size_approx();
+}
+
+void FairQueue::push(RequestContainerPtr request) {
+  // wake the callers waiting for the input queue's waiter
+  cv_.notify_all();
+  if (request == nullptr) {
+    ++stops_;
+    return;
+  }
+  double weight = 1;
+  if (auto found = weights_.find(request->client); found != weights_.end()) {
+    weight = found->second;
+  }
+  auto& finish = finishes_[request->client];
+  finish = std::max(finish, virtual_time_) + 1 / weight;
+  requests_.emplace(std::make_pair(finish, arrivals_++), std::move(request));
+}
+
+bool FairQueue::pop(RequestContainerPtr* request) {
+  if (requests_.empty()) {
+    return false;
+  }
+  auto next = requests_.begin();
+  virtual_time_ = next->first.first;
+  *request = std::move(next->second);
+  requests_.erase(next);
+  // a client with nothing waiting starts again from the virtual time
+  if (auto found = finishes_.find((*request)->client);
+      found != finishes_.end() && found->second <= virtual_time_) {
+    finishes_.erase(found);
+  }
+  return true;
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,128 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines the weighted fair queue of requests waiting to be batched
+ */
+
+#ifndef GUARD_AMDINFER_BATCHING_FAIR_QUEUE
+#define GUARD_AMDINFER_BATCHING_FAIR_QUEUE
+
+#include <chrono>              // for microseconds, steady_clock
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint64_t
+#include <map>                 // for map
+#include <mutex>               // for mutex
+#include <string>              // for string
+#include <unordered_map>       // for unordered_map
+#include <utility>             // for pair
+
+#include "amdinfer/declarations.hpp"  // for RequestContainerPtr
+#include "amdinfer/util/queue.hpp"    // for BlockingQueue
+
+namespace amdinfer {
+
+/**
+ * @brief Parse a comma-separated list of client weights
+ *
+ * @param weights the list, e.g. "alice:2,bob:0.5"
+ * @return std::unordered_map<std::string, double> client -> weight
+ * @throws invalid_argument if an entry isn't a client and a positive weight
+ */
+std::unordered_map<std::string, double> parseClientWeights(
+  const std::string& weights);
+
+/**
+ * @brief The FairQueue hands out the requests waiting in a batcher's input
+ * queue in weighted fair order across clients so one client with many requests
+ * can't take all the batch slots. Each request gets a virtual finish time that
+ * grows by the inverse of its client's weight for every request the client
+ * already has waiting and requests are taken in order of their finish times.
+ * Requests from one client stay in the order they arrived. The stop signals of
+ * the input queue are passed on once the requests before them are taken.
+ *
+ * Batchers sharing the queue wait for requests without polling: one of them at
+ * a time waits on the input queue and the others wait to be notified that it
+ * has added a request or stopped waiting.
+ */
+class FairQueue {
+ public:
+  /**
+   * @brief Construct a new FairQueue object
+   *
+   * @param input the queue requests arrive on
+   * @param weights client -> weight. Other clients have a weight of one
+   */
+  FairQueue(BlockingQueue<RequestContainerPtr>* input,
+            std::unordered_map<std::string, double> weights);
+
+  /// Wait for the next request
+  void dequeue(RequestContainerPtr* request);
+  /**
+   * @brief Wait up to a timeout for the next request
+   *
+   * @param request the next request
+   * @param timeout how long to wait
+   * @return bool false if there was no request in time
+   */
+  bool dequeue(RequestContainerPtr* request, std::chrono::microseconds timeout);
+  /// Take the next request if there's one waiting
+  bool tryDequeue(RequestContainerPtr* request);
+  /// Get the approximate number of waiting requests
+  [[nodiscard]] size_t size() const;
+
+ private:
+  /**
+   * @brief Wait until a deadline for the next request
+   *
+   * @param request the next request
+   * @param deadline when to stop waiting. The maximum time point waits forever
+   * @return bool false if there was no request in time
+   */
+  bool dequeueUntil(RequestContainerPtr* request,
+                    std::chrono::steady_clock::time_point deadline);
+  /**
+   * @brief Take the next request or stop signal, adding everything that has
+   * arrived on the input queue first. Must be called with mutex_ held
+   */
+  bool take(RequestContainerPtr* request);
+  /// Add a request from the input queue. Must be called with mutex_ held
+  void push(RequestContainerPtr request);
+  /// Take the next request, if any. Must be called with mutex_ held
+  bool pop(RequestContainerPtr* request);
+
+  BlockingQueue<RequestContainerPtr>* input_;
+  std::unordered_map<std::string, double> weights_;
+
+  mutable std::mutex mutex_;
+  /// Notified when a request is added or the input queue's waiter leaves
+  std::condition_variable cv_;
+  /// Whether a caller is waiting on the input queue
+  bool waiting_ = false;
+  /// (finish time, arrival) -> request
+  std::map<std::pair<double, uint64_t>, RequestContainerPtr> requests_;
+  /// client -> finish time of its last waiting request
+  std::unordered_map<std::string, double> finishes_;
+  /// The finish time of the last request taken
+  double virtual_time_ = 0;
+  uint64_t arrivals_ = 0;
+  /// Stop signals taken from the input queue but not handed out yet
+  size_t stops_ = 0;
+};
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_BATCHING_FAIR_QUEUE
@@ -48,6 +48,7 @@ void HardBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
   util::setThreadName(thread_name);
   RequestContainerPtr req;
   bool run = true;
+  const bool ragged = this->isRagged();
 
   while (run) {
     auto batch = std::make_unique<Batch>();
@@ -59,13 +60,17 @@ void HardBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
     bool first_request = true;
 
     do {
-      this->input_queue_->wait_dequeue(req);
+      this->dequeue(&req);
 
       if (req == nullptr) {
         run = false;
         break;
       }
 
+      if (first_request) {
+        this->reconfigure();
+      }
+
 #ifdef AMDINFER_ENABLE_TRACING
       auto& trace = req->trace;
       trace->startSpan("hard_batcher");
@@ -84,7 +89,16 @@ void HardBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
         continue;
       }
 
-      if (first_request) {
+      if (ragged) {
+        // the buffers are allocated once the batch is complete and its total
+        // length is known
+        if (!fitsRagged(*batch, *request)) {
+          this->rejectRequest(
+            request,
+            "Inputs don't match the other requests in the ragged batch");
+          continue;
+        }
+      } else if (first_request) {
         std::vector<BufferPtr> input_buffers;
         input_buffers.reserve(input_size);
         // auto output_sizes = req->getOutputSizes();
@@ -96,7 +110,8 @@ void HardBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
         // output_buffers.reserve(output_sizes.size());
         // std::vector<size_t> output_offset(output_buffers.size(), 0);
         for (const auto& input : inputs) {
-          input_buffers.push_back(pool_->get(allocators, input, batch_size_));
+          input_buffers.push_back(
+            pool_->get(allocators, input, this->getBufferBatchSize()));
         }
         // for(const auto& tensor_size : output_sizes) {
         //   output_buffers.push_back(pool_->get(allocators, tensor_size));
@@ -108,17 +123,19 @@ void HardBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
       const auto& input_buffers = batch->getInputBuffers();
 
       auto old_input_offset = input_offset;
-      for (auto i = 0U; i < input_size; ++i) {
-        const auto& input = inputs[i];
-        const auto& input_buffer = input_buffers.at(i);
-        auto& offset = input_offset[i];
-
-        auto new_offset =
-          input_buffer->write(input.getData(), offset,
-                              input.getSize() * input.getDatatype().size());
-        pool_->put(MemoryAllocators::Cpu, input.getData());
-        request->setInputTensorData(i, input_buffer->data(offset));
-        offset = new_offset;
+      if (!ragged) {
+        for (auto i = 0U; i < input_size; ++i) {
+          const auto& input = inputs[i];
+          const auto& input_buffer = input_buffers.at(i);
+          auto& offset = input_offset[i];
+
+          auto new_offset =
+            input_buffer->write(input.getData(), offset,
+                                input.getSize() * input.getDatatype().size());
+          pool_->put(MemoryAllocators::Cpu, input.getData());
+          request->setInputTensorData(i, input_buffer->data(offset));
+          offset = new_offset;
+        }
       }
 
       batch->addRequest(request);
@@ -134,6 +151,14 @@ void HardBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
       first_request = false;
     } while (batch_size % this->batch_size_ != 0);
 
+    if (ragged && !batch->empty() &&
+        !this->packRagged(batch.get(), allocators)) {
+      continue;
+    }
+    if (!ragged && !batch->empty()) {
+      this->pad(batch.get());
+    }
+
     if (!batch->empty()) {
       this->output_queue_->enqueue(std::move(batch));
 #ifdef AMDINFER_ENABLE_METRICS
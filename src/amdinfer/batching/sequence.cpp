@@ -0,0 +1,393 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Implements the sequence batcher
+ */
+
+#include "amdinfer/batching/sequence.hpp"
+
+#include <algorithm>      // for max, min
+#include <chrono>         // for steady_clock, milliseconds, duration_cast
+#include <cstddef>        // for size_t
+#include <cstdint>        // for int32_t
+#include <deque>          // for deque
+#include <memory>         // for make_shared, make_unique, unique_ptr
+#include <mutex>          // for mutex, lock_guard
+#include <string>         // for string, to_string
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for move
+#include <variant>        // for bad_variant_access
+#include <vector>         // for vector
+
+#include "amdinfer/buffers/buffer.hpp"           // IWYU pragma: keep
+#include "amdinfer/build_options.hpp"            // for AMDINFER_ENABLE_METRICS
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"    // for MemoryPool
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/core/request_container.hpp"   // for RequestContainer
+#include "amdinfer/declarations.hpp"             // for RequestContainerPtr
+#include "amdinfer/observation/logging.hpp"      // for Logger, AMDINFER_LOG...
+#include "amdinfer/observation/metrics.hpp"      // for Metrics, MetricCount...
+#include "amdinfer/observation/tracing.hpp"      // for Trace
+#include "amdinfer/util/queue.hpp"               // for BlockingConcurrentQueue
+#include "amdinfer/util/thread.hpp"              // for setThreadName
+
+namespace {
+
+// default batcher timeout in milliseconds
+constexpr auto kDefaultTimeout = 100;
+// default time in milliseconds before an idle sequence is ended
+constexpr auto kDefaultIdleTimeout = 60000;
+
+using Clock = std::chrono::steady_clock;
+
+/// Get the sequence ID, which may be a string or an integer
+std::string getSequenceId(const amdinfer::ParameterMap& parameters) {
+  try {
+    return parameters.get<std::string>("sequence_id");
+  } catch (const std::bad_variant_access&) {
+    return std::to_string(parameters.get<int32_t>("sequence_id"));
+  }
+}
+
+bool getFlag(const amdinfer::ParameterMap& parameters, const char* key) {
+  return parameters.has(key) && parameters.get<bool>(key);
+}
+
+/// Fail a request that won't be batched and return its data to the pool
+void reject(const amdinfer::RequestContainer& request,
+            const amdinfer::MemoryPool* pool, const std::string& error) {
+  for (const auto& input : request.request->getInputs()) {
+    pool->put(amdinfer::MemoryAllocators::Cpu, input.getData());
+  }
+  request.request->runCallbackError(error);
+}
+
+}  // namespace
+
+namespace amdinfer {
+
+struct SequenceBatcher::Sequences {
+  /// A sequence of related requests that has been assigned a slot
+  struct Sequence {
+    std::string id;
+    /// Requests for the sequence's next steps, in the order they arrived
+    std::deque<RequestContainerPtr> steps;
+    /// A step of the sequence is in a batch that hasn't responded yet
+    bool busy = false;
+    /// The sequence's last step has been batched
+    bool ending = false;
+    Clock::time_point last_active;
+  };
+
+  /// Check if the sequence has been idle for at least the timeout
+  static bool expired(const Sequence& sequence, Clock::time_point now,
+                      std::chrono::milliseconds idle_timeout) {
+    return !sequence.busy && sequence.steps.empty() &&
+           now - sequence.last_active >= idle_timeout;
+  }
+
+  /// End the sequence in the slot, failing any steps it still has
+  void end(size_t slot, const std::string& error) {
+    auto& sequence = slots.at(slot);
+    for (const auto& step : sequence->steps) {
+      reject(*step, pool, error);
+    }
+    ids.erase(sequence->id);
+    sequence.reset();
+  }
+
+  MemoryPool* pool;
+  /**
+   * @brief The batcher's input queue. When a step responds and its sequence
+   * has more steps waiting, a RequestContainer without a request is sent on it
+   * to wake the batcher
+   */
+  std::shared_ptr<BlockingQueue<RequestContainerPtr>> input;
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Sequence>> slots;
+  std::unordered_map<std::string, size_t> ids;
+};
+
+SequenceBatcher::SequenceBatcher(MemoryPool* pool, ParameterMap* parameters)
+  : Batcher(pool, parameters), sequences_(std::make_shared<Sequences>()) {
+  sequences_->pool = pool;
+  sequences_->input = input_queue_;
+}
+
+bool SequenceBatcher::isStateful() const { return true; }
+
+void SequenceBatcher::admit(RequestContainerPtr request) const {
+  // a response woke the batcher so its sequence's next step can be batched
+  if (request->request == nullptr) {
+    return;
+  }
+  const auto& parameters = request->request->getParameters();
+  if (!parameters.has("sequence_id")) {
+    reject(*request, pool_,
+           "Requests to this model must have a sequence_id parameter");
+    return;
+  }
+  std::string id;
+  try {
+    id = getSequenceId(parameters);
+  } catch (const std::bad_variant_access&) {
+    reject(*request, pool_,
+           "The sequence_id parameter must be a string or an integer");
+    return;
+  }
+
+  const auto idle_timeout = this->getIdleTimeout();
+  const auto now = Clock::now();
+  const std::lock_guard lock{sequences_->mutex};
+  auto& slots = sequences_->slots;
+  auto& ids = sequences_->ids;
+  if (auto iterator = ids.find(id); iterator != ids.end()) {
+    const auto slot = iterator->second;
+    auto& sequence = slots[slot];
+    // the sequence may have timed out since the batcher last checked
+    if (Sequences::expired(*sequence, now, idle_timeout)) {
+      sequences_->end(slot, "Sequence " + id + " timed out");
+    } else {
+      if (sequence->ending) {
+        reject(*request, pool_, "Sequence " + id + " has ended");
+        return;
+      }
+      sequence->steps.push_back(std::move(request));
+      sequence->last_active = now;
+      return;
+    }
+  }
+
+  if (!getFlag(parameters, "sequence_start")) {
+    reject(*request, pool_,
+           "Sequence " + id + " hasn't started or has timed out");
+    return;
+  }
+  // slots beyond the batch size are only kept for existing sequences if the
+  // batch size shrinks
+  if (slots.size() < batch_size_) {
+    slots.resize(batch_size_);
+  }
+  for (auto slot = 0U; slot < batch_size_; ++slot) {
+    if (slots[slot] == nullptr) {
+      auto& sequence = *(slots[slot] = std::make_unique<Sequences::Sequence>());
+      sequence.id = id;
+      sequence.steps.push_back(std::move(request));
+      sequence.last_active = now;
+      ids.emplace(id, slot);
+      return;
+    }
+  }
+  reject(*request, pool_,
+         "All " + std::to_string(batch_size_) + " sequence slots are in use");
+}
+
+void SequenceBatcher::fill(Batch* batch) const {
+  const std::lock_guard lock{sequences_->mutex};
+  auto& slots = sequences_->slots;
+  for (auto slot = 0U; slot < slots.size(); ++slot) {
+    auto& sequence = slots[slot];
+    if (sequence == nullptr || sequence->busy || sequence->steps.empty() ||
+        !fitsRagged(*batch, *sequence->steps.front()->request)) {
+      continue;
+    }
+    auto req = std::move(sequence->steps.front());
+    sequence->steps.pop_front();
+    sequence->busy = true;
+
+    const auto& request = req->request;
+    auto parameters = request->getParameters();
+    const auto sequence_slot = static_cast<int32_t>(slot);
+    parameters.put("sequence_slot", sequence_slot);
+    sequence->ending = getFlag(parameters, "sequence_end");
+    request->setParameters(std::move(parameters));
+
+    // the sequence's next step can be batched once this one responds
+    request->setCallback([sequences = sequences_, slot, id = sequence->id,
+                          callback = request->getCallback()](
+                           const InferenceResponse& response) {
+      {
+        const std::lock_guard lock{sequences->mutex};
+        auto& responded = sequences->slots.at(slot);
+        // the sequence may have ended already if the worker streams responses
+        if (responded != nullptr && responded->id == id && responded->busy) {
+          responded->busy = false;
+          responded->last_active = Clock::now();
+          if (responded->ending) {
+            sequences->end(slot, "Sequence " + id + " has ended");
+          } else if (!responded->steps.empty()) {
+            sequences->input->enqueue(std::make_unique<RequestContainer>());
+          }
+        }
+      }
+      callback(response);
+    });
+
+#ifdef AMDINFER_ENABLE_TRACING
+    auto& trace = req->trace;
+    trace->startSpan("sequence_batcher");
+#endif
+#ifdef AMDINFER_ENABLE_METRICS
+    Metrics::getInstance().incrementCounter(
+      MetricCounterIDs::PipelineIngressBatcher);
+#endif
+    batch->addRequest(request);
+    batch->addModel("");
+#ifdef AMDINFER_ENABLE_TRACING
+    trace->endSpan();
+    batch->addTrace(std::move(trace));
+#endif
+#ifdef AMDINFER_ENABLE_METRICS
+    batch->addTime(req->start_time);
+#endif
+  }
+}
+
+bool SequenceBatcher::full(const Batch& batch) const {
+  if (batch.size() >= batch_size_) {
+    return true;
+  }
+  // waiting for steps of sequences already in a batch would serialize them
+  // so only sequences that are between steps can still join
+  const std::lock_guard lock{sequences_->mutex};
+  for (const auto& sequence : sequences_->slots) {
+    if (sequence != nullptr && !sequence->busy) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::chrono::milliseconds SequenceBatcher::getIdleTimeout() const {
+  return std::chrono::milliseconds{
+    parameters_.has("sequence_idle_timeout")
+      ? parameters_.get<int32_t>("sequence_idle_timeout")
+      : kDefaultIdleTimeout};
+}
+
+Clock::time_point SequenceBatcher::expire() const {
+  const auto idle_timeout = this->getIdleTimeout();
+  const auto now = Clock::now();
+  auto next = Clock::time_point::max();
+
+  const std::lock_guard lock{sequences_->mutex};
+  auto& slots = sequences_->slots;
+  for (auto slot = 0U; slot < slots.size(); ++slot) {
+    const auto& sequence = slots[slot];
+    if (sequence == nullptr || sequence->busy || !sequence->steps.empty()) {
+      continue;
+    }
+    if (Sequences::expired(*sequence, now, idle_timeout)) {
+      sequences_->end(slot, "Sequence " + sequence->id + " timed out");
+    } else {
+      next = std::min(next, sequence->last_active + idle_timeout);
+    }
+  }
+  return next;
+}
+
+void SequenceBatcher::endAll() const {
+  const std::lock_guard lock{sequences_->mutex};
+  auto& slots = sequences_->slots;
+  for (auto slot = 0U; slot < slots.size(); ++slot) {
+    if (slots[slot] != nullptr) {
+      sequences_->end(slot, "Sequence " + slots[slot]->id +
+                              " ended because its batcher stopped");
+    }
+  }
+}
+
+void SequenceBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
+  auto thread_name = "batch" + this->getName();
+  util::setThreadName(thread_name);
+#ifdef AMDINFER_ENABLE_LOGGING
+  [[maybe_unused]] const auto& logger = this->getLogger();
+#endif
+
+  bool run = true;
+  auto timeout = kDefaultTimeout;
+  if (this->parameters_.has("timeout")) {
+    timeout = this->parameters_.get<int32_t>("timeout");
+  }
+
+  while (run) {
+    if (this->reconfigure() && this->parameters_.has("timeout")) {
+      timeout = this->parameters_.get<int32_t>("timeout");
+    }
+
+    auto batch = std::make_unique<Batch>();
+    Clock::time_point deadline;
+    while (run) {
+      // admit everything that has arrived before adding steps to the batch
+      RequestContainerPtr req;
+      while (this->input_queue_->try_dequeue(req)) {
+        if (req == nullptr) {
+          run = false;
+          break;
+        }
+        this->admit(std::move(req));
+      }
+      if (!run) {
+        break;
+      }
+      const auto expiry = this->expire();
+
+      const auto empty = batch->empty();
+      this->fill(batch.get());
+      if (empty && !batch->empty()) {
+        deadline = Clock::now() + std::chrono::milliseconds{timeout};
+      }
+      if (!batch->empty() &&
+          (this->full(*batch) || Clock::now() >= deadline)) {
+        break;
+      }
+
+      // wait for a new request, a response that lets a sequence's next step
+      // be batched, the batch's timeout or an idle sequence's timeout
+      const auto wake = batch->empty() ? expiry : std::min(expiry, deadline);
+      if (wake == Clock::time_point::max()) {
+        this->input_queue_->wait_dequeue(req);
+      } else if (!this->input_queue_->wait_dequeue_timed(
+                   req, std::max(std::chrono::duration_cast<
+                                   std::chrono::microseconds>(wake - Clock::now()),
+                                 std::chrono::microseconds{0}))) {
+        continue;
+      }
+      if (req == nullptr) {
+        run = false;
+        break;
+      }
+      this->admit(std::move(req));
+    }
+
+    if (batch->empty() || !this->packRagged(batch.get(), allocators)) {
+      continue;
+    }
+    AMDINFER_LOG_DEBUG(logger, "Enqueuing batch for " + this->model_ +
+                                 " of size " + std::to_string(batch->size()));
+    this->output_queue_->enqueue(std::move(batch));
+#ifdef AMDINFER_ENABLE_METRICS
+    Metrics::getInstance().incrementCounter(
+      MetricCounterIDs::PipelineEgressBatcher);
+#endif
+  }
+  this->endAll();
+}
+
+}  // namespace amdinfer
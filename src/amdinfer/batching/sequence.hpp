@@ -0,0 +1,80 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Defines the sequence batcher implementation
+ */
+
+#ifndef GUARD_AMDINFER_BATCHING_SEQUENCE
+#define GUARD_AMDINFER_BATCHING_SEQUENCE
+
+#include <chrono>  // for steady_clock, milliseconds
+#include <memory>  // for shared_ptr
+#include <vector>  // for vector
+
+#include "amdinfer/batching/batcher.hpp"  // IWYU pragma: export
+
+namespace amdinfer {
+enum class MemoryAllocators;
+}  // namespace amdinfer
+
+namespace amdinfer {
+
+/**
+ * @brief The SequenceBatcher batches the steps of stateful sequences of
+ * related requests. Requests are grouped by their "sequence_id" parameter and
+ * a request with "sequence_start" set assigns its sequence a slot, up to the
+ * batch size, which it keeps until a request with "sequence_end" set finishes
+ * or it has been idle for "sequence_idle_timeout" milliseconds. Each batch has
+ * at most one step of a sequence and a sequence's next step isn't batched
+ * until its last one has responded so workers can keep each sequence's state
+ * by its slot, which is passed to them in the "sequence_slot" parameter.
+ */
+class SequenceBatcher : public Batcher {
+ public:
+  SequenceBatcher(MemoryPool* pool, ParameterMap* parameters);
+
+  [[nodiscard]] bool isStateful() const override;
+
+ private:
+  void doRun(const std::vector<MemoryAllocators>& allocators) override;
+
+  /// Add a new request to its sequence's steps
+  void admit(RequestContainerPtr request) const;
+  /// Add the next step of each sequence that's ready to the batch
+  void fill(Batch* batch) const;
+  /// Check if no more sequences can add a step to the batch
+  [[nodiscard]] bool full(const Batch& batch) const;
+  /// Get how long a sequence can be idle before it's ended
+  [[nodiscard]] std::chrono::milliseconds getIdleTimeout() const;
+  /**
+   * @brief End the sequences that have been idle for longer than the timeout
+   *
+   * @return std::chrono::steady_clock::time_point when the next sequence will
+   * time out if it stays idle or the maximum time point if none can
+   */
+  std::chrono::steady_clock::time_point expire() const;
+  /// Fail the steps of all the open sequences once the batcher stops
+  void endAll() const;
+
+  struct Sequences;
+  /// The active sequences, shared by the copies of this batcher
+  std::shared_ptr<Sequences> sequences_;
+};
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_BATCHING_SEQUENCE
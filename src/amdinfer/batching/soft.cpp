@@ -21,6 +21,7 @@
 #include "amdinfer/batching/soft.hpp"
 
 #include <algorithm>  // for max
+#include <chrono>     // for microseconds
 #include <cstddef>    // for size_t
 #include <cstdint>    // for int32_t
 #include <memory>     // for unique_ptr, allocator
@@ -58,6 +59,7 @@ void SoftBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
 #endif
 
   bool run = true;
+  const bool ragged = this->isRagged();
 
   auto timeout = kDefaultTimeout;
   if (this->parameters_.has("timeout")) {
@@ -74,7 +76,7 @@ void SoftBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
 #ifdef AMDINFER_ENABLE_METRICS
     Metrics::getInstance().setGauge(
       MetricGaugeIDs::QueuesBatcherInput,
-      static_cast<double>(input_queue_->size_approx()));
+      static_cast<double>(this->getQueueSize()));
     Metrics::getInstance().setGauge(
       MetricGaugeIDs::QueuesBatcherOutput,
       static_cast<double>(output_queue_->size_approx()));
@@ -87,8 +89,12 @@ void SoftBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
       RequestContainerPtr req;
       if (first_request) {
         // wait for the first request
-        this->input_queue_->wait_dequeue(req);
+        this->dequeue(&req);
         timer.add("start");
+        // changes made while waiting apply to the batch this request starts
+        if (this->reconfigure() && this->parameters_.has("timeout")) {
+          timeout = this->parameters_.get<int32_t>("timeout");
+        }
         AMDINFER_LOG_DEBUG(logger,
                            "Got request of a new batch for " + this->model_);
       } else {
@@ -96,8 +102,9 @@ void SoftBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
 
         auto remaining_time = timeout - timer.count<std::milli, int>();
         // convert duration from milliseconds to microseconds for function
-        auto duration = std::max(remaining_time, 0) * std::kilo::num;
-        bool valid = this->input_queue_->wait_dequeue_timed(req, duration);
+        auto duration = std::chrono::microseconds{std::max(remaining_time, 0) *
+                                                  std::kilo::num};
+        bool valid = this->dequeue(&req, duration);
         if (!valid) {
           break;
         }
@@ -116,7 +123,16 @@ void SoftBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
         continue;
       }
 
-      if (first_request) {
+      if (ragged) {
+        // the buffers are allocated once the batch is complete and its total
+        // length is known
+        if (!fitsRagged(*batch, *request)) {
+          this->rejectRequest(
+            request,
+            "Inputs don't match the other requests in the ragged batch");
+          continue;
+        }
+      } else if (first_request) {
         std::vector<BufferPtr> input_buffers;
         input_buffers.reserve(input_size);
         // auto output_sizes = req->getOutputSizes();
@@ -128,7 +144,8 @@ void SoftBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
         // output_buffers.reserve(output_sizes.size());
         // std::vector<size_t> output_offset(output_buffers.size(), 0);
         for (const auto& input : inputs) {
-          input_buffers.push_back(pool_->get(allocators, input, batch_size_));
+          input_buffers.push_back(
+            pool_->get(allocators, input, this->getBufferBatchSize()));
         }
         // for(const auto& tensor_size : output_sizes) {
         //   output_buffers.push_back(pool_->get(allocators, tensor_size));
@@ -151,17 +168,19 @@ void SoftBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
 
       auto old_input_offset = input_offset;
 
-      for (auto i = 0U; i < input_size; ++i) {
-        const auto& input = inputs[i];
-        const auto& input_buffer = input_buffers.at(i);
-        auto& offset = input_offset[i];
-
-        auto new_offset =
-          input_buffer->write(input.getData(), offset,
-                              input.getSize() * input.getDatatype().size());
-        pool_->put(MemoryAllocators::Cpu, input.getData());
-        request->setInputTensorData(i, input_buffer->data(offset));
-        offset = new_offset;
+      if (!ragged) {
+        for (auto i = 0U; i < input_size; ++i) {
+          const auto& input = inputs[i];
+          const auto& input_buffer = input_buffers.at(i);
+          auto& offset = input_offset[i];
+
+          auto new_offset =
+            input_buffer->write(input.getData(), offset,
+                                input.getSize() * input.getDatatype().size());
+          pool_->put(MemoryAllocators::Cpu, input.getData());
+          request->setInputTensorData(i, input_buffer->data(offset));
+          offset = new_offset;
+        }
       }
 
       batch->addRequest(request);
@@ -177,6 +196,14 @@ void SoftBatcher::doRun(const std::vector<MemoryAllocators>& allocators) {
       first_request = false;
     } while (batch_size % this->batch_size_ != 0 && run);
 
+    if (ragged && !batch->empty() &&
+        !this->packRagged(batch.get(), allocators)) {
+      continue;
+    }
+    if (!ragged && !batch->empty()) {
+      this->pad(batch.get());
+    }
+
     if (!batch->empty()) {
       AMDINFER_LOG_DEBUG(logger, "Enqueuing batch for " + this->model_ +
                                    " of size " + std::to_string(batch_size));
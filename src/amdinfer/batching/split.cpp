@@ -0,0 +1,234 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Implements how requests with many samples are split across batches
+ */
+
+#include "amdinfer/batching/split.hpp"
+
+#include <cstddef>   // for size_t, byte
+#include <cstdint>   // for int64_t
+#include <cstring>   // for memcpy
+#include <memory>    // for make_shared, make_unique, shared_ptr
+#include <mutex>     // for mutex, lock_guard
+#include <optional>  // for optional
+#include <string>    // for string, to_string
+#include <utility>   // for move
+#include <vector>    // for vector
+
+#include "amdinfer/buffers/buffer.hpp"           // for Buffer
+#include "amdinfer/build_options.hpp"            // for AMDINFER_ENABLE_TRACING
+#include "amdinfer/core/exceptions.hpp"          // for runtime_error
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"    // for MemoryPool
+#include "amdinfer/core/request_container.hpp"   // for RequestContainer
+#include "amdinfer/core/tensor.hpp"              // for Tensor
+#include "amdinfer/observation/tracing.hpp"      // for startTrace, Trace
+
+namespace amdinfer {
+
+namespace {
+
+/// Collects the responses of a split request's samples
+struct SplitResponses {
+  std::mutex mutex;
+  Callback callback;
+  std::string id;
+  std::vector<std::optional<InferenceResponse>> responses;
+  size_t remaining;
+};
+
+/**
+ * @brief Concatenate the samples' outputs in order into one response
+ *
+ * @param responses a successful response for each sample
+ * @return InferenceResponse
+ */
+InferenceResponse combine(
+  const std::vector<std::optional<InferenceResponse>>& responses) {
+  const auto& first = *responses.front();
+  InferenceResponse response;
+  response.setModel(first.getModel());
+  if (const auto* parameters = first.getParameters(); parameters != nullptr) {
+    response.setParameters(*parameters);
+  }
+
+  const auto output_count = first.getOutputs().size();
+  for (auto i = 0U; i < output_count; ++i) {
+    const auto& first_output = first.getOutputs()[i];
+    const auto datatype = first_output.getDatatype();
+    auto shape = first_output.getShape();
+    if (shape.empty()) {
+      shape.push_back(1);
+    }
+
+    int64_t leading = 0;
+    std::vector<std::byte> data;
+    for (const auto& sample : responses) {
+      const auto& outputs = sample->getOutputs();
+      if (outputs.size() != output_count ||
+          outputs[i].getDatatype() != datatype) {
+        return InferenceResponse{
+          "The outputs of the request's samples could not be combined"};
+      }
+      const auto& output = outputs[i];
+      const auto& output_shape = output.getShape();
+      leading += output_shape.empty() ? 1 : output_shape.front();
+      const auto* output_data = static_cast<std::byte*>(output.getData());
+      data.insert(data.end(), output_data,
+                  output_data + output.getSize() * datatype.size());
+    }
+    shape.front() = leading;
+
+    InferenceResponseOutput output;
+    output.setName(first_output.getName());
+    output.setDatatype(datatype);
+    output.setShape(shape);
+    output.setParameters(first_output.getParameters());
+    output.setData(std::move(data));
+    response.addOutput(output);
+  }
+  return response;
+}
+
+/// Record a sample's response and respond to the request once all are in
+void respond(const std::shared_ptr<SplitResponses>& state, size_t index,
+             const InferenceResponse& response) {
+  {
+    const std::lock_guard lock{state->mutex};
+    auto& sample = state->responses.at(index);
+    // a sample only counts once even if its worker responds more than once
+    if (sample.has_value()) {
+      return;
+    }
+    sample = response;
+    if (--state->remaining > 0) {
+      return;
+    }
+  }
+
+  // all samples have responded so no other thread touches the state now
+  std::optional<InferenceResponse> result;
+  for (auto i = 0U; i < state->responses.size(); ++i) {
+    const auto& sample = *state->responses[i];
+    if (sample.isError()) {
+      result = InferenceResponse{"Sample " + std::to_string(i) + " of " +
+                                 std::to_string(state->responses.size()) +
+                                 " failed: " + sample.getError()};
+      break;
+    }
+  }
+  if (!result.has_value()) {
+    result = combine(state->responses);
+  }
+  result->setID(state->id);
+  state->callback(*result);
+}
+
+}  // namespace
+
+std::vector<RequestContainerPtr> splitRequest(RequestContainer* request,
+                                              const MemoryPool* pool) {
+  const auto& original = request->request;
+  const auto& inputs = original->getInputs();
+  if (inputs.empty()) {
+    return {};
+  }
+  int64_t samples = -1;
+  for (const auto& input : inputs) {
+    const auto& shape = input.getShape();
+    if (shape.empty() || (samples != -1 && shape.front() != samples)) {
+      return {};
+    }
+    samples = shape.front();
+  }
+  if (samples <= 1) {
+    return {};
+  }
+  const auto count = static_cast<size_t>(samples);
+
+  // allocate everything first so a failure leaves nothing behind
+  std::vector<std::vector<void*>> data(count);
+  try {
+    for (auto& sample_data : data) {
+      for (const auto& input : inputs) {
+        auto shape = input.getShape();
+        shape.front() = 1;
+        const Tensor tensor{input.getName(), shape, input.getDatatype()};
+        sample_data.push_back(
+          pool->get({MemoryAllocators::Cpu}, tensor, 1)->data(0));
+      }
+    }
+  } catch (const runtime_error&) {
+    for (const auto& sample_data : data) {
+      for (auto* memory : sample_data) {
+        pool->put(MemoryAllocators::Cpu, memory);
+      }
+    }
+    throw;
+  }
+
+  auto state = std::make_shared<SplitResponses>();
+  state->callback = original->getCallback();
+  state->id = original->getID();
+  state->responses.resize(count);
+  state->remaining = count;
+
+  std::vector<RequestContainerPtr> containers;
+  containers.reserve(count);
+  for (auto i = 0U; i < count; ++i) {
+    auto sample = std::make_shared<InferenceRequest>();
+    sample->setID(original->getID());
+    sample->setParameters(original->getParameters());
+    for (const auto& output : original->getOutputs()) {
+      sample->addOutputTensor(output);
+    }
+    for (auto j = 0U; j < inputs.size(); ++j) {
+      auto input = inputs[j];
+      auto shape = input.getShape();
+      shape.front() = 1;
+      input.setShape(shape);
+      const auto size = input.getSize() * input.getDatatype().size();
+      const auto* source = static_cast<std::byte*>(inputs[j].getData());
+      std::memcpy(data[i][j], source + i * size, size);
+      input.setData(data[i][j]);
+      sample->addInputTensor(std::move(input));
+    }
+    sample->setCallback([state, i](const InferenceResponse& response) {
+      respond(state, i, response);
+    });
+
+    auto container = std::make_unique<RequestContainer>();
+    container->request = std::move(sample);
+#ifdef AMDINFER_ENABLE_TRACING
+    container->trace =
+      startTrace("splitRequest", request->trace->propagate());
+#endif
+#ifdef AMDINFER_ENABLE_METRICS
+    container->start_time = request->start_time;
+#endif
+    containers.push_back(std::move(container));
+  }
+
+  for (const auto& input : inputs) {
+    pool->put(MemoryAllocators::Cpu, input.getData());
+  }
+  return containers;
+}
+
+}  // namespace amdinfer
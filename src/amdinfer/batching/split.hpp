@@ -0,0 +1,57 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Defines how requests with many samples are split across batches
+ */
+
+#ifndef GUARD_AMDINFER_BATCHING_SPLIT
+#define GUARD_AMDINFER_BATCHING_SPLIT
+
+#include <vector>  // for vector
+
+#include "amdinfer/declarations.hpp"  // for RequestContainerPtr
+
+namespace amdinfer {
+
+class MemoryPool;
+
+/**
+ * @brief Split a request with many samples into one request per sample so the
+ * samples can be batched and run across workers in parallel. The samples are
+ * the slices along the leading dimension of the inputs, which must be the same
+ * for all of them. Each sample keeps the rank of the original with a leading
+ * dimension of one.
+ *
+ * Once every sample has a response, their outputs are concatenated in order
+ * along the leading dimension into one response for the original request. If
+ * any sample fails, the request fails with the error of the first failed
+ * sample and the other samples' outputs are discarded.
+ *
+ * @param request the request to split. Its input data is returned to the pool
+ * if it's split
+ * @param pool the memory pool to allocate the samples' input data from
+ * @return std::vector<RequestContainerPtr> a request for each sample or empty
+ * if the request can't be split because it has one sample, no inputs or inputs
+ * with different leading dimensions
+ * @throws runtime_error if memory for the samples can't be allocated
+ */
+std::vector<RequestContainerPtr> splitRequest(RequestContainer* request,
+                                              const MemoryPool* pool);
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_BATCHING_SPLIT
@@ -43,6 +43,9 @@ void wrapClient(py::module_& m) {
          DOCS(Client, modelLoad))
     .def("modelUnload", &Client::modelUnload, py::arg("model"),
          py::arg("version") = "", DOCS(Client, modelUnload))
+    .def("modelConfigure", &Client::modelConfigure, py::arg("model"),
+         py::arg("parameters"), py::arg("version") = "",
+         DOCS(Client, modelConfigure))
     .def("modelInfer", &Client::modelInfer, py::arg("model"),
          py::arg("request"), py::arg("version") = "", DOCS(Client, modelInfer));
   // cannot wrap future directly in Python
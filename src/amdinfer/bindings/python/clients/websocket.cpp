@@ -57,6 +57,11 @@ void wrapWebSocketClient(py::module_ &m) {
          py::arg("request"), DOCS(WebSocketClient, modelInferWs))
     .def("modelRecv", &WebSocketClient::modelRecv,
          DOCS(WebSocketClient, modelRecv))
+    .def("modelInferWsBinary", &WebSocketClient::modelInferWsBinary,
+         py::arg("model"), py::arg("request"),
+         DOCS(WebSocketClient, modelInferWsBinary))
+    .def("modelRecvBinary", &WebSocketClient::modelRecvBinary,
+         DOCS(WebSocketClient, modelRecvBinary))
     .def("modelList", &WebSocketClient::modelList,
          DOCS(WebSocketClient, modelList))
     .def("hasHardware", &WebSocketClient::hasHardware, py::arg("name"),
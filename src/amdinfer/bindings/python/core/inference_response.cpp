@@ -55,7 +55,10 @@ void wrapInferenceResponse(py::module_ &m) {
            self.setContext(std::move(context));
          })
 #endif
-    .def("getParameters", &InferenceResponse::getParameters,
+    .def("getParameters",
+         static_cast<ParameterMap *(InferenceResponse::*)()>(
+           &InferenceResponse::getParameters),
+         py::return_value_policy::reference_internal,
          DOCS(InferenceResponse, getParameters))
     .def("getOutputs", &InferenceResponse::getOutputs,
          py::return_value_policy::reference_internal,
@@ -50,6 +50,12 @@ void Client::modelUnload(const std::string& model,
   modelUnloadImpl(model, version);
 }
 
+void Client::modelConfigure(const std::string& model,
+                            const ParameterMap& parameters,
+                            const std::string& version) const {
+  modelConfigureImpl(model, parameters, version);
+}
+
 InferenceResponse Client::modelInfer(const std::string& model,
                                      const InferenceRequest& request,
                                      const std::string& version) const {
@@ -241,6 +241,27 @@ void GrpcClient::modelUnloadImpl(const std::string& model,
   }
 }
 
+void GrpcClient::modelConfigureImpl(const std::string& model,
+                                    const ParameterMap& parameters,
+                                    const std::string& version) const {
+  inference::ModelConfigureRequest request;
+  inference::ModelConfigureResponse reply;
+
+  ClientContext context;
+
+  request.set_name(model);
+  auto* params = request.mutable_parameters();
+  mapParametersToProto(parameters.data(), params);
+  request.set_version(version);
+
+  auto* stub = this->impl_->getStub();
+  Status status = stub->ModelConfigure(&context, request, &reply);
+
+  if (!status.ok()) {
+    throw bad_status(status.error_message());
+  }
+}
+
 std::string GrpcClient::workerLoad(const std::string& worker,
                                    const ParameterMap& parameters) const {
   inference::WorkerLoadRequest request;
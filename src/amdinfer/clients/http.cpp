@@ -274,6 +274,29 @@ void HttpClient::modelUnloadImpl(const std::string& model,
   }
 }
 
+void HttpClient::modelConfigureImpl(const std::string& model,
+                                    const ParameterMap& parameters,
+                                    const std::string& version) const {
+  auto* client = this->impl_->getClient();
+
+  Json::Value json = mapParametersToJson(parameters);
+  drogon::HttpRequestPtr req;
+  if (version.empty()) {
+    req = createPostRequest(json, "/v2/models/" + model + "/configure",
+                            impl_->getHeaders());
+  } else {
+    req = createPostRequest(
+      json, "/v2/models/" + model + "/versions/" + version + "/configure",
+      impl_->getHeaders());
+  }
+
+  auto [result, response] = client->sendRequest(req);
+  checkError(result);
+  if (response->statusCode() != drogon::k200OK) {
+    throw bad_status(std::string(response->body()));
+  }
+}
+
 std::string HttpClient::workerLoad(const std::string& worker,
                                    const ParameterMap& parameters) const {
   auto* client = this->impl_->getClient();
@@ -72,6 +72,13 @@ void NativeClient::modelLoadImpl(const std::string& model,
   impl_->state->modelLoad(model_lower, version, parameters);
 }
 
+void NativeClient::modelSwap(const std::string& model,
+                             const ParameterMap& parameters,
+                             const std::string& version) const {
+  auto model_lower = util::toLower(model);
+  impl_->state->modelSwap(model_lower, version, parameters);
+}
+
 std::string NativeClient::workerLoad(const std::string& worker,
                                      const ParameterMap& parameters) const {
   auto worker_lower = util::toLower(worker);
@@ -130,6 +137,41 @@ InferenceResponseFuture NativeClient::modelInferAsyncImpl(
   return future;
 }
 
+EndpointHandle NativeClient::modelHandle(const std::string& model,
+                                         const std::string& version) const {
+  return impl_->state->modelHandle(model, version);
+}
+
+InferenceResponseFuture NativeClient::modelInferAsync(
+  EndpointHandle* handle, const InferenceRequest& request) const {
+#ifdef AMDINFER_ENABLE_METRICS
+  Metrics::getInstance().incrementCounter(MetricCounterIDs::CppNative);
+#endif
+
+#ifdef AMDINFER_ENABLE_TRACING
+  auto trace = startTrace(&(__func__[0]));
+  trace->startSpan("C++ enqueue");
+#endif
+  auto new_request = getRequest(request, impl_->state->getPool());
+  auto future = setCallback(new_request.get());
+  auto request_container = std::make_unique<RequestContainer>();
+  request_container->request = std::move(new_request);
+
+#ifdef AMDINFER_ENABLE_TRACING
+  trace->endSpan();
+  request_container->trace = std::move(trace);
+#endif
+  impl_->state->modelInfer(handle, std::move(request_container));
+
+  return future;
+}
+
+InferenceResponse NativeClient::modelInfer(
+  EndpointHandle* handle, const InferenceRequest& request) const {
+  auto future = modelInferAsync(handle, request);
+  return future.get();
+}
+
 InferenceResponse NativeClient::modelInferImpl(
   const std::string& model, const InferenceRequest& request,
   const std::string& version) const {
@@ -143,6 +185,13 @@ void NativeClient::modelUnloadImpl(const std::string& model,
   impl_->state->modelUnload(model_lower, version);
 }
 
+void NativeClient::modelConfigureImpl(const std::string& model,
+                                      const ParameterMap& parameters,
+                                      const std::string& version) const {
+  auto model_lower = util::toLower(model);
+  impl_->state->modelConfigure(model_lower, version, parameters);
+}
+
 void NativeClient::workerUnload(const std::string& worker) const {
   auto worker_lower = util::toLower(worker);
   impl_->state->workerUnload(worker_lower);
@@ -35,10 +35,11 @@
 #include <chrono>   // for milliseconds
 #include <thread>   // for sleep_for
 
-#include "amdinfer/clients/http.hpp"             // for HttpClient
-#include "amdinfer/clients/http_internal.hpp"    // for mapRequestToJson
-#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
-#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/clients/http.hpp"                // for HttpClient
+#include "amdinfer/clients/http_internal.hpp"       // for mapRequestToJson
+#include "amdinfer/clients/websocket_internal.hpp"  // for encodeWsRequest
+#include "amdinfer/core/inference_request.hpp"      // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"     // for InferenceResponse
 
 namespace amdinfer {
 
@@ -79,6 +80,10 @@ class WebSocketClient::WebSocketClientImpl {
             queue_.enqueue(message);
             break;
           }
+          case WebSocketMessageType::Binary: {
+            queue_.enqueue(message);
+            break;
+          }
           case WebSocketMessageType::Close: {
             ws_client_->stop();
             break;
@@ -130,6 +135,16 @@ class WebSocketClient::WebSocketClientImpl {
     }
   }
 
+  void send(const std::string& message, drogon::WebSocketMessageType type) {
+    auto connection = ws_client_->getConnection();
+    if (connection == nullptr || connection->disconnected()) {
+      connect();
+      connection = ws_client_->getConnection();
+      assert(connection != nullptr);
+    }
+    connection->send(message, type);
+  }
+
   std::string recv() {
     std::string response;
     queue_.wait_dequeue(response);
@@ -202,6 +217,13 @@ void WebSocketClient::modelUnloadImpl(const std::string& model,
   client->modelUnload(model, version);
 }
 
+void WebSocketClient::modelConfigureImpl(const std::string& model,
+                                         const ParameterMap& parameters,
+                                         const std::string& version) const {
+  const auto* client = this->impl_->getHttpClient();
+  client->modelConfigure(model, parameters, version);
+}
+
 std::string WebSocketClient::workerLoad(const std::string& worker,
                                         const ParameterMap& parameters) const {
   const auto* client = this->impl_->getHttpClient();
@@ -239,23 +261,25 @@ bool WebSocketClient::hasHardware(const std::string& name, int num) const {
 
 void WebSocketClient::modelInferWs(const std::string& model,
                                    const InferenceRequest& request) const {
-  auto* client = this->impl_->getWsClient();
-
   auto json = mapRequestToJson(request);
   json["model"] = model;
   Json::StreamWriterBuilder builder;
   builder["indentation"] = "";  // remove whitespace
   const std::string message = Json::writeString(builder, json);
 
-  auto connection = client->getConnection();
-  if (connection == nullptr || connection->disconnected()) {
-    impl_->connect();
-    connection = client->getConnection();
-    assert(connection != nullptr);
-  }
-  connection->send(message);
+  impl_->send(message, drogon::WebSocketMessageType::Text);
 }
 
 std::string WebSocketClient::modelRecv() const { return impl_->recv(); }
 
+void WebSocketClient::modelInferWsBinary(
+  const std::string& model, const InferenceRequest& request) const {
+  impl_->send(encodeWsRequest(model, request),
+              drogon::WebSocketMessageType::Binary);
+}
+
+InferenceResponse WebSocketClient::modelRecvBinary() const {
+  return decodeWsResponse(impl_->recv());
+}
+
 }  // namespace amdinfer
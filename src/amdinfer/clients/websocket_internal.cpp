@@ -0,0 +1,408 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements the binary framing used for websocket inference
+ */
+
+#include "amdinfer/clients/websocket_internal.hpp"
+
+#include <cstddef>      // for size_t, byte
+#include <cstdint>      // for uint8_t, uint32_t, uint64_t, int64_t
+#include <cstring>      // for memcpy
+#include <memory>       // for make_shared
+#include <type_traits>  // for is_same_v, decay_t
+#include <utility>      // for move
+#include <variant>      // for visit
+#include <vector>       // for vector
+
+#include "amdinfer/buffers/buffer.hpp"           // for Buffer
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/exceptions.hpp"          // for invalid_argument
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"    // for MemoryPool
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+
+namespace amdinfer {
+
+namespace {
+
+constexpr std::string_view kMagic = "AW";
+constexpr uint8_t kVersion = 1;
+
+enum class FrameKind : uint8_t { Request, Response, Error };
+
+/// Appends little-endian fields to a frame
+class FrameWriter {
+ public:
+  void u8(uint8_t value) { buffer_.push_back(static_cast<char>(value)); }
+
+  void u32(uint32_t value) { this->integer(value); }
+
+  void u64(uint64_t value) { this->integer(value); }
+
+  void string(std::string_view str) {
+    this->u32(static_cast<uint32_t>(str.size()));
+    buffer_.append(str);
+  }
+
+  void bytes(const void* data, size_t size) {
+    buffer_.append(static_cast<const char*>(data), size);
+  }
+
+  void reserve(size_t size) { buffer_.reserve(size); }
+
+  std::string release() { return std::move(buffer_); }
+
+ private:
+  template <typename T>
+  void integer(T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      buffer_.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+  }
+
+  std::string buffer_;
+};
+
+/// Reads little-endian fields from a frame, checking that each one fits
+class FrameReader {
+ public:
+  explicit FrameReader(std::string_view frame) : frame_(frame) {}
+
+  uint8_t u8() { return static_cast<uint8_t>(*this->take(1)); }
+
+  uint32_t u32() { return this->integer<uint32_t>(); }
+
+  uint64_t u64() { return this->integer<uint64_t>(); }
+
+  std::string_view string() {
+    const auto size = this->u32();
+    return {this->take(size), size};
+  }
+
+  const char* bytes(size_t size) { return this->take(size); }
+
+  [[nodiscard]] size_t remaining() const { return frame_.size() - offset_; }
+
+ private:
+  const char* take(size_t size) {
+    if (size > this->remaining()) {
+      throw invalid_argument("Websocket frame is truncated");
+    }
+    const auto* data = frame_.data() + offset_;
+    offset_ += size;
+    return data;
+  }
+
+  template <typename T>
+  T integer() {
+    const auto* data = this->take(sizeof(T));
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      value |= static_cast<T>(static_cast<uint8_t>(data[i])) << (i * 8);
+    }
+    return value;
+  }
+
+  std::string_view frame_;
+  size_t offset_ = 0;
+};
+
+void writeParameters(FrameWriter* writer, const ParameterMap& parameters) {
+  writer->u32(static_cast<uint32_t>(parameters.size()));
+  for (const auto& [key, value] : parameters) {
+    writer->string(key);
+    writer->u8(static_cast<uint8_t>(value.index()));
+    std::visit(
+      [writer](const auto& param) {
+        using T = std::decay_t<decltype(param)>;
+        if constexpr (std::is_same_v<T, bool>) {
+          writer->u8(param ? 1 : 0);
+        } else if constexpr (std::is_same_v<T, int32_t>) {
+          writer->u32(static_cast<uint32_t>(param));
+        } else if constexpr (std::is_same_v<T, double>) {
+          uint64_t bits = 0;
+          std::memcpy(&bits, &param, sizeof(bits));
+          writer->u64(bits);
+        } else {
+          writer->string(param);
+        }
+      },
+      value);
+  }
+}
+
+ParameterMap readParameters(FrameReader* reader) {
+  ParameterMap parameters;
+  const auto count = reader->u32();
+  for (auto i = 0U; i < count; ++i) {
+    const std::string key{reader->string()};
+    switch (reader->u8()) {
+      case 0:
+        parameters.put(key, reader->u8() != 0);
+        break;
+      case 1:
+        parameters.put(key, static_cast<int32_t>(reader->u32()));
+        break;
+      case 2: {
+        const auto bits = reader->u64();
+        double value = 0;
+        std::memcpy(&value, &bits, sizeof(value));
+        parameters.put(key, value);
+        break;
+      }
+      case 3:
+        parameters.put(key, std::string{reader->string()});
+        break;
+      default:
+        throw invalid_argument("Unknown parameter type in websocket frame");
+    }
+  }
+  return parameters;
+}
+
+void writeTensor(FrameWriter* writer, const InferenceTensor& tensor) {
+  writer->string(tensor.getName());
+  writer->u8(static_cast<uint8_t>(tensor.getDatatype()));
+  const auto& shape = tensor.getShape();
+  writer->u32(static_cast<uint32_t>(shape.size()));
+  for (const auto& dim : shape) {
+    writer->u64(static_cast<uint64_t>(dim));
+  }
+  writeParameters(writer, tensor.getParameters());
+  writer->u64(tensor.getSize() * tensor.getDatatype().size());
+}
+
+/**
+ * @brief Read the metadata of a tensor and check that it agrees with the size
+ * of the data that follows the header
+ *
+ * @param reader the frame reader
+ * @param tensor[out] the tensor to populate
+ * @return size_t the size of the tensor's data in bytes
+ */
+size_t readTensor(FrameReader* reader, InferenceTensor* tensor) {
+  tensor->setName(std::string{reader->string()});
+  const auto datatype = reader->u8();
+  if (datatype >= DataType::Unknown) {
+    throw invalid_argument("Unknown datatype in websocket frame");
+  }
+  tensor->setDatatype(static_cast<DataType::Value>(datatype));
+
+  const auto ndims = reader->u32();
+  // each dimension takes 8 bytes so this bounds the allocation below
+  if (ndims > reader->remaining() / sizeof(uint64_t)) {
+    throw invalid_argument("Websocket frame is truncated");
+  }
+  std::vector<int64_t> shape;
+  shape.reserve(ndims);
+  for (auto i = 0U; i < ndims; ++i) {
+    shape.push_back(static_cast<int64_t>(reader->u64()));
+  }
+  tensor->setShape(std::move(shape));
+  tensor->setParameters(readParameters(reader));
+
+  const auto size = reader->u64();
+  // the data follows the header so it must fit in what's left of the frame
+  if (size > reader->remaining()) {
+    throw invalid_argument("Websocket frame is truncated");
+  }
+  if (size != tensor->getSize() * tensor->getDatatype().size()) {
+    throw invalid_argument("Tensor " + tensor->getName() +
+                           " has data that doesn't match its shape");
+  }
+  return size;
+}
+
+FrameKind readHeader(FrameReader* reader) {
+  const auto* magic = reader->bytes(kMagic.size());
+  if (std::string_view{magic, kMagic.size()} != kMagic) {
+    throw invalid_argument("Not a binary websocket frame");
+  }
+  if (reader->u8() != kVersion) {
+    throw invalid_argument("Unsupported websocket frame version");
+  }
+  const auto kind = reader->u8();
+  if (kind > static_cast<uint8_t>(FrameKind::Error)) {
+    throw invalid_argument("Unknown websocket frame type");
+  }
+  return static_cast<FrameKind>(kind);
+}
+
+void writeHeader(FrameWriter* writer, FrameKind kind) {
+  writer->bytes(kMagic.data(), kMagic.size());
+  writer->u8(kVersion);
+  writer->u8(static_cast<uint8_t>(kind));
+}
+
+}  // namespace
+
+std::string encodeWsRequest(const std::string& model,
+                            const InferenceRequest& request) {
+  const auto& inputs = request.getInputs();
+  const auto& outputs = request.getOutputs();
+
+  FrameWriter writer;
+  size_t data_size = 0;
+  for (const auto& input : inputs) {
+    data_size += input.getSize() * input.getDatatype().size();
+  }
+  // the header is small relative to the data in the common case
+  constexpr auto kHeaderEstimate = 256;
+  writer.reserve(kHeaderEstimate + data_size);
+
+  writeHeader(&writer, FrameKind::Request);
+  writer.string(request.getID());
+  writer.string(model);
+  writeParameters(&writer, request.getParameters());
+
+  writer.u32(static_cast<uint32_t>(inputs.size()));
+  for (const auto& input : inputs) {
+    writeTensor(&writer, input);
+  }
+  writer.u32(static_cast<uint32_t>(outputs.size()));
+  for (const auto& output : outputs) {
+    writer.string(output.getName());
+    writeParameters(&writer, output.getParameters());
+  }
+  for (const auto& input : inputs) {
+    writer.bytes(input.getData(),
+                 input.getSize() * input.getDatatype().size());
+  }
+  return writer.release();
+}
+
+InferenceRequestPtr decodeWsRequest(std::string_view frame,
+                                    const MemoryPool* pool,
+                                    std::string* model) {
+  FrameReader reader{frame};
+  if (readHeader(&reader) != FrameKind::Request) {
+    throw invalid_argument("Websocket frame is not a request");
+  }
+
+  auto request = std::make_shared<InferenceRequest>();
+  request->setCallback(nullptr);
+  request->setID(reader.string());
+  *model = reader.string();
+  request->setParameters(readParameters(&reader));
+
+  std::vector<InferenceRequestInput> inputs;
+  std::vector<size_t> sizes;
+  const auto input_count = reader.u32();
+  for (auto i = 0U; i < input_count; ++i) {
+    InferenceRequestInput input;
+    input.setData(nullptr);
+    sizes.push_back(readTensor(&reader, &input));
+    inputs.push_back(std::move(input));
+  }
+  const auto output_count = reader.u32();
+  for (auto i = 0U; i < output_count; ++i) {
+    InferenceRequestOutput output;
+    output.setData(nullptr);
+    output.setName(std::string{reader.string()});
+    output.setParameters(readParameters(&reader));
+    request->addOutputTensor(output);
+  }
+
+  // validate the whole frame before taking any buffers from the pool
+  size_t data_size = 0;
+  for (const auto& size : sizes) {
+    data_size += size;
+  }
+  if (data_size != reader.remaining()) {
+    throw invalid_argument("Websocket frame has the wrong amount of data");
+  }
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    auto& input = inputs[i];
+    auto buffer = pool->get({MemoryAllocators::Cpu}, input, 1);
+    auto* data = buffer->data(0);
+    std::memcpy(data, reader.bytes(sizes[i]), sizes[i]);
+    input.setData(data);
+    request->addInputTensor(std::move(input));
+  }
+
+  return request;
+}
+
+std::string encodeWsResponse(const InferenceResponse& response) {
+  FrameWriter writer;
+  if (response.isError()) {
+    writeHeader(&writer, FrameKind::Error);
+    writer.string(response.getError());
+    return writer.release();
+  }
+
+  const auto& outputs = response.getOutputs();
+  size_t data_size = 0;
+  for (const auto& output : outputs) {
+    data_size += output.getSize() * output.getDatatype().size();
+  }
+  constexpr auto kHeaderEstimate = 256;
+  writer.reserve(kHeaderEstimate + data_size);
+
+  writeHeader(&writer, FrameKind::Response);
+  writer.string(response.getID());
+  writer.string(response.getModel());
+  const auto* parameters = response.getParameters();
+  writeParameters(&writer,
+                  parameters != nullptr ? *parameters : ParameterMap{});
+
+  writer.u32(static_cast<uint32_t>(outputs.size()));
+  for (const auto& output : outputs) {
+    writeTensor(&writer, output);
+  }
+  for (const auto& output : outputs) {
+    writer.bytes(output.getData(),
+                 output.getSize() * output.getDatatype().size());
+  }
+  return writer.release();
+}
+
+InferenceResponse decodeWsResponse(std::string_view frame) {
+  FrameReader reader{frame};
+  const auto kind = readHeader(&reader);
+  if (kind == FrameKind::Error) {
+    return InferenceResponse{std::string{reader.string()}};
+  }
+  if (kind != FrameKind::Response) {
+    throw invalid_argument("Websocket frame is not a response");
+  }
+
+  InferenceResponse response;
+  response.setID(std::string{reader.string()});
+  response.setModel(std::string{reader.string()});
+  response.setParameters(readParameters(&reader));
+
+  std::vector<InferenceResponseOutput> outputs;
+  std::vector<size_t> sizes;
+  const auto output_count = reader.u32();
+  for (auto i = 0U; i < output_count; ++i) {
+    InferenceResponseOutput output;
+    sizes.push_back(readTensor(&reader, &output));
+    outputs.push_back(std::move(output));
+  }
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    const auto* data =
+      reinterpret_cast<const std::byte*>(reader.bytes(sizes[i]));
+    outputs[i].setData({data, data + sizes[i]});
+    response.addOutput(outputs[i]);
+  }
+  return response;
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,90 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines the binary framing used for websocket inference
+ *
+ * @details A binary frame is a header followed by the raw bytes of each tensor,
+ * concatenated in the order the tensors appear in the header. All integers are
+ * little-endian and strings are a uint32 length followed by the characters.
+ *
+ *   magic "AW" | uint8 version | uint8 kind (0: request, 1: response, 2: error)
+ *   string id | string model | parameters
+ *   error:    string message
+ *   request:  uint32 input count | tensors | uint32 output count |
+ *             (string name | parameters) for each requested output
+ *   response: uint32 output count | tensors
+ *   tensors:  (string name | uint8 datatype | uint32 ndims | int64 shape[ndims]
+ *             | parameters | uint64 data size in bytes) for each tensor
+ *   parameters: uint32 count | (string key | uint8 type | value) for each
+ *             where type is 0: bool (uint8), 1: int32, 2: double, 3: string
+ */
+
+#ifndef GUARD_AMDINFER_CLIENTS_WEBSOCKET_INTERNAL
+#define GUARD_AMDINFER_CLIENTS_WEBSOCKET_INTERNAL
+
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+#include "amdinfer/declarations.hpp"  // for InferenceRequestPtr
+
+namespace amdinfer {
+
+class MemoryPool;
+
+/**
+ * @brief Encode an inference request as a binary websocket frame
+ *
+ * @param model the model the request is for
+ * @param request the request to encode
+ * @return std::string
+ */
+std::string encodeWsRequest(const std::string& model,
+                            const InferenceRequest& request);
+
+/**
+ * @brief Decode a binary websocket frame into an inference request. The input
+ * data is copied into buffers from the pool.
+ *
+ * @param frame the binary frame
+ * @param pool the memory pool to allocate input buffers from
+ * @param model[out] the model the request is for
+ * @return InferenceRequestPtr
+ * @throws invalid_argument if the frame is not a valid request
+ */
+InferenceRequestPtr decodeWsRequest(std::string_view frame,
+                                    const MemoryPool* pool, std::string* model);
+
+/**
+ * @brief Encode an inference response, including error responses, as a binary
+ * websocket frame
+ *
+ * @param response the response to encode
+ * @return std::string
+ */
+std::string encodeWsResponse(const InferenceResponse& response);
+
+/**
+ * @brief Decode a binary websocket frame into an inference response
+ *
+ * @param frame the binary frame
+ * @return InferenceResponse
+ * @throws invalid_argument if the frame is not a valid response
+ */
+InferenceResponse decodeWsResponse(std::string_view frame);
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_CLIENTS_WEBSOCKET_INTERNAL
@@ -0,0 +1,250 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Implements the cache of compiled model artifacts shared by workers
+ */
+
+#include "amdinfer/core/artifact_cache.hpp"
+
+#include <unistd.h>  // for getpid
+
+#include <algorithm>      // for sort
+#include <array>          // for array
+#include <atomic>         // for atomic
+#include <cstdint>        // for uint64_t
+#include <exception>      // for exception
+#include <fstream>        // for ifstream
+#include <iomanip>        // for setfill, setw
+#include <memory>         // for shared_ptr, make_shared
+#include <mutex>          // for mutex, lock_guard
+#include <sstream>        // for stringstream
+#include <string>         // for string, getline
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for move, pair
+#include <vector>         // for vector
+
+#include "amdinfer/build_options.hpp"    // for kDefaultArtifactCacheSize
+#include "amdinfer/core/exceptions.hpp"  // for file_not_found_error, inval...
+#include "amdinfer/core/parameters.hpp"  // for ParameterMap
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+namespace {
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+constexpr uint64_t kBytesPerMiB = 1024ULL * 1024ULL;
+
+/// 64-bit FNV-1a hash. It's not cryptographic but artifacts are only shared by
+/// workers on the same host so it only needs to tell models apart
+void hash(uint64_t* state, const char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    *state ^= static_cast<unsigned char>(data[i]);
+    *state *= kFnvPrime;
+  }
+}
+
+void hash(uint64_t* state, const std::string& data) {
+  // hash the size too so adjacent strings can't run together
+  const auto size = std::to_string(data.size()) + ":";
+  hash(state, size.data(), size.size());
+  hash(state, data.data(), data.size());
+}
+
+std::string toHex(uint64_t value) {
+  std::stringstream stream;
+  const int width = 16;
+  stream << std::hex << std::setfill('0') << std::setw(width) << value;
+  return stream.str();
+}
+
+/**
+ * @brief Describe the host so artifacts compiled for one CPU aren't used on
+ * another that shares the cache. Accelerator-specific details, such as the
+ * GPU target, should be added to the configuration by the worker.
+ *
+ * @return const std::string&
+ */
+const std::string& getHostFingerprint() {
+  static const std::string fingerprint = []() {
+    std::string description = std::string{__VERSION__} + "\n";
+    std::ifstream cpuinfo{"/proc/cpuinfo"};
+    std::string line;
+    // the first processor is enough to describe the host
+    while (std::getline(cpuinfo, line) && !line.empty()) {
+      if (line.rfind("vendor_id", 0) == 0 || line.rfind("model name", 0) == 0 ||
+          line.rfind("flags", 0) == 0) {
+        description += line + "\n";
+      }
+    }
+    return description;
+  }();
+  return fingerprint;
+}
+
+/// Get the lock for an artifact so only one worker in the process compiles it
+std::shared_ptr<std::mutex> getLock(const fs::path& path) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<std::mutex>> locks;
+
+  const std::lock_guard lock{mutex};
+  auto& artifact_lock = locks[path.string()];
+  if (artifact_lock == nullptr) {
+    artifact_lock = std::make_shared<std::mutex>();
+  }
+  return artifact_lock;
+}
+
+bool isTemporary(const fs::path& path) {
+  return path.filename().string().find(".tmp.") != std::string::npos;
+}
+
+}  // namespace
+
+ArtifactCache::ArtifactCache(fs::path directory, uint64_t max_bytes)
+  : directory_(std::move(directory)), max_bytes_(max_bytes) {
+  fs::create_directories(directory_);
+}
+
+ArtifactCache ArtifactCache::fromParameters(const ParameterMap& parameters) {
+  if (!enabled(parameters)) {
+    throw invalid_argument("No directory set for the artifact cache");
+  }
+  auto size = static_cast<uint64_t>(kDefaultArtifactCacheSize);
+  if (parameters.has("artifact_cache_size")) {
+    const auto mib = parameters.get<int32_t>("artifact_cache_size");
+    if (mib < 0) {
+      throw invalid_argument("artifact_cache_size must not be negative");
+    }
+    size = static_cast<uint64_t>(mib);
+  }
+  return {parameters.get<std::string>("artifact_cache"), size * kBytesPerMiB};
+}
+
+bool ArtifactCache::enabled(const ParameterMap& parameters) {
+  return parameters.has("artifact_cache") &&
+         !parameters.get<std::string>("artifact_cache").empty();
+}
+
+std::string ArtifactCache::makeKey(
+  const fs::path& model, const std::string& worker,
+  const std::map<std::string, std::string>& config) {
+  uint64_t content = kFnvOffset;
+  if (!model.empty()) {
+    std::ifstream file{model, std::ios::binary};
+    if (!file) {
+      throw file_not_found_error("Model file " + model.string() +
+                                 " could not be read");
+    }
+    const size_t chunk_size = 1 << 16;
+    std::vector<char> chunk(chunk_size);
+    while (file) {
+      file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+      hash(&content, chunk.data(), static_cast<size_t>(file.gcount()));
+    }
+  }
+
+  uint64_t context = kFnvOffset;
+  hash(&context, worker);
+  // std::map keeps the configuration sorted so the order it's given in doesn't
+  // matter
+  for (const auto& [key, value] : config) {
+    hash(&context, key);
+    hash(&context, value);
+  }
+  hash(&context, getHostFingerprint());
+
+  return toHex(content) + "-" + toHex(context);
+}
+
+fs::path ArtifactCache::get(const std::string& key, const Compiler& compile) {
+  const auto path = directory_ / key;
+  const auto lock = getLock(path);
+  const std::lock_guard guard{*lock};
+
+  std::error_code error;
+  if (fs::exists(path, error)) {
+    // the modification time is the last use for eviction
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+    return path;
+  }
+
+  // compile to a unique temporary file and rename it so other workers and
+  // processes never see a partially written artifact
+  static std::atomic<uint64_t> counter = 0;
+  const auto temp_name = key + ".tmp." + std::to_string(getpid()) + "." +
+                         std::to_string(counter++);
+  const auto temp_path = directory_ / temp_name;
+  try {
+    compile(temp_path);
+  } catch (const std::exception&) {
+    fs::remove(temp_path, error);
+    throw;
+  }
+  if (!fs::exists(temp_path)) {
+    throw runtime_error("Compiling the artifact " + key + " did not write it");
+  }
+  fs::rename(temp_path, path);
+
+  this->evict(path);
+  return path;
+}
+
+bool ArtifactCache::contains(const std::string& key) const {
+  std::error_code error;
+  return fs::exists(directory_ / key, error);
+}
+
+void ArtifactCache::evict(const fs::path& keep) const {
+  if (max_bytes_ == 0) {
+    return;
+  }
+
+  // other processes may be adding and removing artifacts at the same time so
+  // errors from files disappearing are ignored
+  std::error_code error;
+  std::vector<std::pair<fs::file_time_type, fs::path>> artifacts;
+  uint64_t total = 0;
+  for (const auto& entry : fs::directory_iterator(directory_, error)) {
+    if (!entry.is_regular_file(error) || isTemporary(entry.path())) {
+      continue;
+    }
+    const auto size = entry.file_size(error);
+    if (error) {
+      continue;
+    }
+    total += size;
+    if (entry.path() != keep) {
+      artifacts.emplace_back(entry.last_write_time(error), entry.path());
+    }
+  }
+
+  std::sort(artifacts.begin(), artifacts.end());
+  for (const auto& [time, path] : artifacts) {
+    if (total <= max_bytes_) {
+      break;
+    }
+    const auto size = fs::file_size(path, error);
+    if (!error && fs::remove(path, error)) {
+      total -= size;
+    }
+  }
+}
+
+}  // namespace amdinfer
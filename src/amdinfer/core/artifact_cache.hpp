@@ -0,0 +1,110 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Defines the cache of compiled model artifacts shared by workers
+ */
+
+#ifndef GUARD_AMDINFER_CORE_ARTIFACT_CACHE
+#define GUARD_AMDINFER_CORE_ARTIFACT_CACHE
+
+#include <cstdint>     // for uint64_t
+#include <filesystem>  // for path
+#include <functional>  // for function
+#include <map>         // for map
+#include <string>      // for string
+
+namespace amdinfer {
+
+class ParameterMap;
+
+/**
+ * @brief Stores the artifacts workers compile from model files, such as
+ * compiled programs, in a directory so later loads can skip compiling. An
+ * artifact is found by a key made of the hash of the model file's contents,
+ * the worker, the configuration that affects compilation and the host it was
+ * compiled on so changing any of these never reuses a stale artifact.
+ * Artifacts are written atomically and the least recently used ones are
+ * removed once the directory exceeds its size limit.
+ */
+class ArtifactCache {
+ public:
+  /// Writes the compiled artifact to the given path
+  using Compiler = std::function<void(const std::filesystem::path& path)>;
+
+  /**
+   * @brief Construct a new ArtifactCache object
+   *
+   * @param directory directory to store artifacts in. It's created if needed
+   * @param max_bytes remove the least recently used artifacts once their total
+   * size exceeds this many bytes. Zero means no limit
+   */
+  ArtifactCache(std::filesystem::path directory, uint64_t max_bytes);
+
+  /**
+   * @brief Get the cache to use for a worker from its load parameters:
+   * "artifact_cache" is the directory and "artifact_cache_size" is the limit
+   * in MiB, defaulting to kDefaultArtifactCacheSize
+   *
+   * @param parameters the worker's load parameters
+   * @return ArtifactCache
+   * @throws invalid_argument if no directory is set
+   */
+  static ArtifactCache fromParameters(const ParameterMap& parameters);
+
+  /// Check if the load parameters enable the cache
+  static bool enabled(const ParameterMap& parameters);
+
+  /**
+   * @brief Make the key of an artifact
+   *
+   * @param model path to the model file the artifact is compiled from. If
+   * it's empty, the key is made from the rest of the arguments
+   * @param worker name of the worker compiling the model
+   * @param config configuration values that change the compiled artifact
+   * @return std::string
+   * @throws file_not_found_error if the model file can't be read
+   */
+  [[nodiscard]] static std::string makeKey(
+    const std::filesystem::path& model, const std::string& worker,
+    const std::map<std::string, std::string>& config);
+
+  /**
+   * @brief Get the path to the artifact with the key, compiling it first if
+   * it's not cached. The returned artifact remains until it's evicted so it
+   * should be read before other artifacts are added.
+   *
+   * @param key key of the artifact from makeKey()
+   * @param compile called to write the artifact if it's not cached
+   * @return std::filesystem::path
+   */
+  std::filesystem::path get(const std::string& key, const Compiler& compile);
+
+  /// Check if an artifact is cached without compiling or using it
+  [[nodiscard]] bool contains(const std::string& key) const;
+
+ private:
+  /// Remove the least recently used artifacts, other than keep, until the rest
+  /// fit in max_bytes_
+  void evict(const std::filesystem::path& keep) const;
+
+  std::filesystem::path directory_;
+  uint64_t max_bytes_;
+};
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_CORE_ARTIFACT_CACHE
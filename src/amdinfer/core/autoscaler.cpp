@@ -0,0 +1,116 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Implements how the number of workers in an endpoint follows its load
+ */
+
+#include "amdinfer/core/autoscaler.hpp"
+
+#include <algorithm>  // for clamp, max
+#include <cstdint>    // for int32_t
+
+#include "amdinfer/core/exceptions.hpp"  // for invalid_argument
+#include "amdinfer/core/parameters.hpp"  // for ParameterMap
+
+namespace amdinfer {
+
+namespace {
+
+size_t getCount(const ParameterMap& parameters, const std::string& key,
+                size_t default_value, int32_t minimum) {
+  if (!parameters.has(key)) {
+    return default_value;
+  }
+  const auto value = parameters.get<int32_t>(key);
+  if (value < minimum) {
+    throw invalid_argument("The " + key + " parameter must be at least " +
+                           std::to_string(minimum));
+  }
+  return static_cast<size_t>(value);
+}
+
+}  // namespace
+
+std::optional<AutoscalePolicy> getAutoscalePolicy(
+  const ParameterMap& parameters) {
+  if (!parameters.has("autoscale_max_workers")) {
+    return std::nullopt;
+  }
+  AutoscalePolicy policy;
+  policy.max_workers = getCount(parameters, "autoscale_max_workers", 1, 1);
+  policy.min_workers = getCount(parameters, "autoscale_min_workers", 1, 1);
+  policy.spare_workers = getCount(parameters, "autoscale_spare_workers", 0, 0);
+  policy.queue_depth = getCount(parameters, "autoscale_queue_depth", 1, 1);
+  policy.cooldown = std::chrono::milliseconds(getCount(
+    parameters, "autoscale_cooldown", policy.cooldown.count(), 0));
+  if (policy.min_workers > policy.max_workers) {
+    throw invalid_argument(
+      "The autoscale_min_workers parameter cannot exceed "
+      "autoscale_max_workers");
+  }
+  return policy;
+}
+
+void Autoscaler::add(const std::string& endpoint,
+                     const AutoscalePolicy& policy) {
+  states_.insert_or_assign(endpoint, State{policy, std::nullopt});
+}
+
+void Autoscaler::remove(const std::string& endpoint) {
+  states_.erase(endpoint);
+}
+
+std::vector<std::string> Autoscaler::endpoints() const {
+  std::vector<std::string> endpoints;
+  endpoints.reserve(states_.size());
+  for (const auto& [endpoint, _] : states_) {
+    endpoints.push_back(endpoint);
+  }
+  return endpoints;
+}
+
+int Autoscaler::sample(const std::string& endpoint, size_t workers,
+                       size_t queue_depth, Clock::time_point now) {
+  auto& state = states_.at(endpoint);
+  const auto& policy = state.policy;
+
+  // the queue only holds waiting requests so at least one worker is busy
+  const auto busy = std::max(
+    (queue_depth + policy.queue_depth - 1) / policy.queue_depth, size_t{1});
+  const auto wanted = std::clamp(busy + policy.spare_workers,
+                                 policy.min_workers, policy.max_workers);
+
+  if (workers < wanted) {
+    state.surplus_since.reset();
+    return 1;
+  }
+  if (workers == wanted) {
+    state.surplus_since.reset();
+    return 0;
+  }
+  if (!state.surplus_since.has_value()) {
+    state.surplus_since = now;
+  }
+  if (now - state.surplus_since.value() < policy.cooldown) {
+    return 0;
+  }
+  // the next worker is only retired after another cooldown
+  state.surplus_since = now;
+  return -1;
+}
+
+}  // namespace amdinfer
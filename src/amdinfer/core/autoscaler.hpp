@@ -0,0 +1,102 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Defines how the number of workers in an endpoint follows its load
+ */
+
+#ifndef GUARD_AMDINFER_CORE_AUTOSCALER
+#define GUARD_AMDINFER_CORE_AUTOSCALER
+
+#include <chrono>         // for milliseconds, steady_clock
+#include <cstddef>        // for size_t
+#include <optional>       // for optional
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+namespace amdinfer {
+
+class ParameterMap;
+
+/// The limits within which an endpoint's worker group grows and shrinks
+struct AutoscalePolicy {
+  size_t min_workers = 1;
+  size_t max_workers = 1;
+  /// Idle workers to keep beyond those the queue needs, ready for a burst
+  size_t spare_workers = 0;
+  /// Queued requests per worker above which another worker is needed
+  size_t queue_depth = 1;
+  /// How long the group must have more workers than it needs before one of
+  /// them is retired. Workers are added without waiting
+  std::chrono::milliseconds cooldown{1000};
+};
+
+/**
+ * @brief Get the autoscaling policy from an endpoint's load-time parameters.
+ * Autoscaling is enabled by setting "autoscale_max_workers". The others are
+ * "autoscale_min_workers", "autoscale_spare_workers", "autoscale_queue_depth"
+ * and "autoscale_cooldown" in milliseconds.
+ *
+ * @param parameters the endpoint's load-time parameters
+ * @return std::optional<AutoscalePolicy> empty if autoscaling isn't enabled
+ * @throws invalid_argument if the values are inconsistent
+ */
+std::optional<AutoscalePolicy> getAutoscalePolicy(
+  const ParameterMap& parameters);
+
+/**
+ * @brief Decides when to add and retire workers in autoscaled endpoints from
+ * periodic samples of their queue depth. It doesn't change the endpoints
+ * itself and it's not thread-safe. Endpoints uses it from its update thread.
+ */
+class Autoscaler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Start autoscaling an endpoint
+  void add(const std::string& endpoint, const AutoscalePolicy& policy);
+  /// Stop autoscaling an endpoint, if it's autoscaled
+  void remove(const std::string& endpoint);
+  /// Get the autoscaled endpoints
+  [[nodiscard]] std::vector<std::string> endpoints() const;
+
+  /**
+   * @brief Record a sample of an endpoint and decide how its worker group
+   * should change. Workers are added one per sample so a burst doesn't add
+   * more than it needs before the new workers have started to help.
+   *
+   * @param endpoint the autoscaled endpoint
+   * @param workers the number of workers it has
+   * @param queue_depth the number of requests waiting for a worker
+   * @param now the time of the sample
+   * @return int 1 to add a worker, -1 to retire one and 0 otherwise
+   */
+  int sample(const std::string& endpoint, size_t workers, size_t queue_depth,
+             Clock::time_point now);
+
+ private:
+  struct State {
+    AutoscalePolicy policy;
+    /// When the group started to have more workers than it needs, if it does
+    std::optional<Clock::time_point> surplus_since;
+  };
+  std::unordered_map<std::string, State> states_;
+};
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_CORE_AUTOSCALER
@@ -0,0 +1,261 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Implements how a worker's batch size and timeout are chosen as it
+ * loads
+ */
+
+#include "amdinfer/core/autotune.hpp"
+
+#include <algorithm>      // for max, sort
+#include <cstdint>        // for int32_t
+#include <filesystem>     // for path, is_regular_file
+#include <fstream>        // for ifstream, ofstream
+#include <map>            // for map
+#include <sstream>        // for ostringstream
+#include <string>         // for string, stoi, getline
+#include <system_error>   // for error_code
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "amdinfer/core/artifact_cache.hpp"  // for ArtifactCache
+#include "amdinfer/core/exceptions.hpp"      // for invalid_argument
+#include "amdinfer/core/parameters.hpp"      // for ParameterMap
+#include "amdinfer/core/warmup.hpp"          // for sendSyntheticRequests
+#include "amdinfer/core/worker_info.hpp"     // for WorkerInfo
+#include "amdinfer/observation/logging.hpp"  // for Logger
+#include "amdinfer/util/string.hpp"          // for parseBatchSizes
+#include "amdinfer/util/timer.hpp"           // for Timer
+#include "amdinfer/version.hpp"              // for kAmdinferVersion
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+namespace {
+
+const auto* const kDefaultBatchSizes = "1,2,4,8,16,32";
+const auto kDefaultRounds = 5;
+const auto kMicrosecondsPerMillisecond = 1000.0;
+
+/// How a worker performed at one batch size
+struct Profile {
+  int32_t batch_size;
+  /// 99th percentile latency in milliseconds
+  double latency;
+  /// Requests per second
+  double throughput;
+};
+
+std::string trim(const std::string& str) {
+  const auto* const whitespace = " \t\r";
+  const auto begin = str.find_first_not_of(whitespace);
+  if (begin == std::string::npos) {
+    return "";
+  }
+  return str.substr(begin, str.find_last_not_of(whitespace) - begin + 1);
+}
+
+/**
+ * @brief Read the key = value lines of a cache file. The file is valid TOML
+ * but only this subset is needed to read it back.
+ */
+std::unordered_map<std::string, std::string> readCache(const fs::path& path) {
+  std::unordered_map<std::string, std::string> values;
+  std::ifstream file{path};
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto equals = line.find('=');
+    if (line.empty() || line[0] == '#' || equals == std::string::npos) {
+      continue;
+    }
+    values.insert_or_assign(trim(line.substr(0, equals)),
+                            trim(line.substr(equals + 1)));
+  }
+  return values;
+}
+
+/**
+ * @brief Make the key of a saved choice. It changes if the profiling settings,
+ * the model, the worker or the server version change.
+ */
+std::string makeCacheKey(const std::string& worker_name,
+                         const ParameterMap& parameters,
+                         std::map<std::string, std::string> config) {
+  config.emplace("version", kAmdinferVersion);
+  fs::path model;
+  if (parameters.has("model")) {
+    model = parameters.get<std::string>("model");
+    // only files can be hashed so anything else is identified by its name and
+    // modification time, if it exists
+    if (!fs::is_regular_file(model)) {
+      std::error_code error;
+      const auto modified = fs::last_write_time(model, error);
+      config.emplace("model", model.string());
+      if (!error) {
+        config.emplace("model_time",
+                       std::to_string(modified.time_since_epoch().count()));
+      }
+      model.clear();
+    }
+  }
+  return ArtifactCache::makeKey(model, worker_name, config);
+}
+
+Profile profile(const std::string& endpoint, const std::string& worker_name,
+                const ParameterMap& parameters, int32_t batch_size,
+                int32_t rounds, MemoryPool* pool, BatchPtrQueue* next,
+                const std::vector<MemoryAllocators>& next_allocators) {
+  auto candidate = parameters;
+  candidate.put("batch_size", batch_size);
+  WorkerInfo worker{worker_name, &candidate, pool, next, next_allocators};
+
+  std::vector<double> latencies;
+  util::Timer timer;
+  try {
+    const auto data = parameters.has("warmup_data")
+                        ? parameters.get<std::string>("warmup_data")
+                        : "zeros";
+    const auto inputs = makeSyntheticInputs(worker, data);
+    // the first burst warms the worker up and isn't measured
+    sendSyntheticRequests(endpoint, &worker, inputs, batch_size, pool);
+    timer.start();
+    for (auto i = 0; i < rounds; ++i) {
+      auto round =
+        sendSyntheticRequests(endpoint, &worker, inputs, batch_size, pool);
+      latencies.insert(latencies.end(), round.begin(), round.end());
+    }
+    timer.stop();
+  } catch (...) {
+    worker.shutdown();
+    throw;
+  }
+  worker.shutdown();
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto index =
+    static_cast<size_t>(0.99 * static_cast<double>(latencies.size() - 1));
+  const auto seconds = timer.count<std::ratio<1>>();
+  return {batch_size, latencies.at(index) / kMicrosecondsPerMillisecond,
+          static_cast<double>(latencies.size()) / seconds};
+}
+
+}  // namespace
+
+void autotune(const std::string& endpoint, const std::string& worker_name,
+              ParameterMap* parameters, MemoryPool* pool, BatchPtrQueue* next,
+              const std::vector<MemoryAllocators>& next_allocators) {
+  if (!parameters->has("autotune_latency")) {
+    return;
+  }
+  AMDINFER_IF_LOGGING(Logger logger{Loggers::Server};)
+  const auto target = parameters->get<double>("autotune_latency");
+  if (target <= 0) {
+    throw invalid_argument("The autotune latency must be positive");
+  }
+  const auto batch_sizes = parameters->has("autotune_batch_sizes")
+                             ? parameters->get<std::string>(
+                                 "autotune_batch_sizes")
+                             : kDefaultBatchSizes;
+  const auto rounds = parameters->has("autotune_rounds")
+                        ? parameters->get<int32_t>("autotune_rounds")
+                        : kDefaultRounds;
+  if (rounds <= 0) {
+    throw invalid_argument("The autotune rounds must be positive");
+  }
+  const auto sizes =
+    util::parseBatchSizes(batch_sizes, "autotune_batch_sizes");
+
+  std::ostringstream latency;
+  latency << target;
+  fs::path cache;
+  std::string key;
+  if (parameters->has("autotune_cache")) {
+    cache = parameters->get<std::string>("autotune_cache");
+    key = makeCacheKey(worker_name, *parameters,
+                       {{"latency", latency.str()},
+                        {"batch_sizes", batch_sizes},
+                        {"rounds", std::to_string(rounds)}});
+    auto values = readCache(cache);
+    if (values["key"] == "\"" + key + "\"" && values.count("batch_size") > 0 &&
+        values.count("timeout") > 0) {
+      parameters->put("batch_size", std::stoi(values["batch_size"]));
+      parameters->put("timeout", std::stoi(values["timeout"]));
+      AMDINFER_LOG_INFO(logger, "Using the saved batch size " +
+                                  values["batch_size"] + " and timeout " +
+                                  values["timeout"] + " ms for " + endpoint);
+      return;
+    }
+  }
+
+  std::vector<Profile> profiles;
+  for (const auto size : sizes) {
+    profiles.push_back(profile(endpoint, worker_name, *parameters,
+                               static_cast<int32_t>(size), rounds, pool, next,
+                               next_allocators));
+    AMDINFER_LOG_DEBUG(logger, "Profiled " + endpoint + " at batch size " +
+                                 std::to_string(size) + ": " +
+                                 std::to_string(profiles.back().latency) +
+                                 " ms, " +
+                                 std::to_string(profiles.back().throughput) +
+                                 " requests/s");
+  }
+
+  // the fastest batch size that meets the target or, if none do, the one that
+  // comes closest
+  const Profile* best = nullptr;
+  for (const auto& candidate : profiles) {
+    if (candidate.latency <= target &&
+        (best == nullptr || candidate.throughput > best->throughput)) {
+      best = &candidate;
+    }
+  }
+  if (best == nullptr) {
+    best = &*std::min_element(
+      profiles.begin(), profiles.end(),
+      [](const auto& a, const auto& b) { return a.latency < b.latency; });
+    AMDINFER_LOG_WARN(logger, "No batch size of " + endpoint +
+                                " meets the latency target of " +
+                                latency.str() + " ms");
+  }
+  // a partial batch may wait for the rest of the target before it's sent
+  const auto timeout =
+    static_cast<int32_t>(std::max(target - best->latency, 0.0));
+  parameters->put("batch_size", best->batch_size);
+  parameters->put("timeout", timeout);
+  AMDINFER_LOG_INFO(logger, "Chose batch size " +
+                              std::to_string(best->batch_size) +
+                              " and timeout " + std::to_string(timeout) +
+                              " ms for " + endpoint);
+
+  if (!cache.empty()) {
+    std::ofstream file{cache};
+    file << "# Chosen by profiling the model as it loaded. Delete this file to "
+            "profile it again\n"
+         << "key = \"" << key << "\"\n"
+         << "latency = " << latency.str() << "\n"
+         << "batch_sizes = \"" << batch_sizes << "\"\n"
+         << "batch_size = " << best->batch_size << "\n"
+         << "timeout = " << timeout << "\n";
+    if (!file) {
+      AMDINFER_LOG_WARN(logger, "Cannot save the autotune results to " +
+                                  cache.string());
+    }
+  }
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,62 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Defines how a worker's batch size and timeout are chosen as it loads
+ */
+
+#ifndef GUARD_AMDINFER_CORE_AUTOTUNE
+#define GUARD_AMDINFER_CORE_AUTOTUNE
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include "amdinfer/batching/batcher.hpp"                  // for BatchPtrQueue
+#include "amdinfer/core/memory_pool/memory_allocator.hpp"  // for MemoryAll...
+
+namespace amdinfer {
+
+class MemoryPool;
+class ParameterMap;
+
+/**
+ * @brief Choose the batch size and batcher timeout for a worker that's about
+ * to be loaded, if its load parameters ask for it, and add them to the
+ * parameters. The autotune_latency parameter is the latency target for a
+ * request in milliseconds. A temporary worker group is created for each of the
+ * batch sizes in autotune_batch_sizes, a comma-separated string, and sent
+ * autotune_rounds bursts of that many requests. The batch size with the most
+ * throughput whose 99th percentile latency meets the target is chosen and the
+ * timeout is the rest of the target. If autotune_cache names a file, the choice
+ * is saved there and reused by later loads with the same autotune settings,
+ * model file, worker and server version.
+ *
+ * @param endpoint name of the endpoint being loaded
+ * @param worker_name name of the worker library
+ * @param parameters the worker's load parameters
+ * @param pool the memory pool to use
+ * @param next the queue the worker sends its output to
+ * @param next_allocators the allocators of the next worker
+ * @throws invalid_argument if the autotune parameters are invalid
+ * @throws runtime_error if a profiling request fails
+ */
+void autotune(const std::string& endpoint, const std::string& worker_name,
+              ParameterMap* parameters, MemoryPool* pool, BatchPtrQueue* next,
+              const std::vector<MemoryAllocators>& next_allocators);
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_CORE_AUTOTUNE
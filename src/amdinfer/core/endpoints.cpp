@@ -19,24 +19,100 @@
 
 #include "amdinfer/core/endpoints.hpp"
 
-#include <cassert>  // for assert
+#include <algorithm>    // for find
+#include <array>        // for array
+#include <chrono>       // for seconds
+#include <cstdlib>      // for abs
+#include <exception>    // for exception_ptr, current_exception
+#include <future>       // for future_status
+#include <memory>       // for atomic_load, atomic_store, make_unique
+#include <mutex>        // for lock_guard, unique_lock
 #include <regex>
+#include <thread>       // for thread
 #include <type_traits>  // for __decay_and_strip<>::__type
+#include <utility>      // for move, pair
 
 #include "amdinfer/batching/batcher.hpp"         // for Batcher
 #include "amdinfer/build_options.hpp"            // for kMaxModelNameSize
-#include "amdinfer/core/exceptions.hpp"          // for invalid_argument
+#include "amdinfer/core/autoscaler.hpp"          // for getAutoscalePolicy
+#include "amdinfer/core/autotune.hpp"            // for autotune
+#include "amdinfer/core/exceptions.hpp"          // for invalid_argument, ru...
 #include "amdinfer/core/parameters.hpp"          // for ParameterMap
 #include "amdinfer/core/request_container.hpp"   // for RequestContainer
 #include "amdinfer/core/versioned_endpoint.hpp"  // for getVersionedEndpoint
+#include "amdinfer/core/warmup.hpp"              // for warmup
 #include "amdinfer/core/worker_info.hpp"         // for WorkerInfo
+#include "amdinfer/observation/metrics.hpp"      // for Metrics, MetricCou...
 #include "amdinfer/util/string.hpp"              // for startsWith
 #include "amdinfer/util/thread.hpp"              // for setThreadName
 
 namespace amdinfer {
 
+namespace {
+
+/// The outcome of a load run in the load pool, sent back with LoadDone
+struct LoadResult {
+  /// The Load command to fulfil
+  std::shared_ptr<UpdateCommand> request;
+  /// The new worker group, if the load created one
+  std::shared_ptr<WorkerInfo> worker;
+  std::exception_ptr error;
+};
+
+/// A swap in progress, shared between the update thread and the load pool
+struct SwapState {
+  /// The Swap command to fulfil
+  std::shared_ptr<UpdateCommand> request;
+  /// The endpoints to swap, in chain order, and the parameters that identify
+  /// their new workers
+  std::vector<std::pair<std::string, ParameterMap>> stages;
+  /// The parameters used to create the new workers, which may modify them
+  std::vector<ParameterMap> parameters;
+  /// The new worker groups, once they're created and warmed up
+  std::vector<std::shared_ptr<WorkerInfo>> workers;
+  std::exception_ptr error;
+};
+
+std::string getMessage(const std::exception_ptr& error) {
+  try {
+    std::rethrow_exception(error);
+  } catch (const std::exception& e) {
+    return e.what();
+  } catch (...) {
+    return "Unknown error";
+  }
+}
+
+}  // namespace
+
+uint64_t SnapshotTracker::add() {
+  const std::lock_guard lock{mutex_};
+  const auto sequence = ++latest_;
+  live_.insert(sequence);
+  return sequence;
+}
+
+void SnapshotTracker::release(uint64_t sequence) {
+  {
+    const std::lock_guard lock{mutex_};
+    live_.erase(sequence);
+  }
+  cv_.notify_all();
+}
+
+bool SnapshotTracker::waitForOlder(uint64_t sequence,
+                                   std::chrono::milliseconds timeout) {
+  std::unique_lock lock{mutex_};
+  return cv_.wait_for(lock, timeout, [&]() {
+    return live_.empty() || *live_.begin() >= sequence;
+  });
+}
+
 Endpoints::Endpoints() {
+  this->unsafePublish();
   update_thread_ = std::thread(&Endpoints::updateManager, this, &update_queue_);
+  autoscale_thread_ = std::thread(&Endpoints::autoscaleTimer, this);
+  drain_thread_ = std::thread(&Endpoints::drainManager, this);
 }
 
 Endpoints::~Endpoints() { this->shutdown(); }
@@ -44,124 +120,219 @@ Endpoints::~Endpoints() { this->shutdown(); }
 std::string Endpoints::load(const std::string& worker,
                             const std::string& version,
                             ParameterMap parameters) {
-  std::shared_ptr<amdinfer::UpdateCommand> request;
-  std::string retval;
-  retval.reserve(kMaxModelNameSize);
-  retval = "";
   const auto& versioned_endpoint = getVersionedEndpoint(worker, version);
-  request = std::make_shared<UpdateCommand>(
-    UpdateCommandType::Load, versioned_endpoint, &parameters, &retval);
-  update_queue_.enqueue(request);
-
-  while (static_cast<std::string*>(request->retval)->empty() &&
-         request->eptr == nullptr) {
-    std::this_thread::yield();
-  }
-  if (request->eptr != nullptr) {
-    std::rethrow_exception(request->eptr);
-  }
-  auto endpoint = *(static_cast<std::string*>(request->retval));
-  return endpoint;
+  auto retval = std::make_shared<std::string>();
+  auto request = std::make_shared<UpdateCommand>(
+    UpdateCommandType::Load, versioned_endpoint,
+    std::make_shared<ParameterMap>(std::move(parameters)), retval);
+  this->submit(request, std::chrono::seconds(kEndpointLoadTimeout));
+  return *retval;
 }
 
 void Endpoints::unload(const std::string& endpoint,
                        const std::string& version) {
   const auto& versioned_endpoint = getVersionedEndpoint(endpoint, version);
-  if (this->exists(versioned_endpoint)) {
-    auto request = std::make_shared<UpdateCommand>(UpdateCommandType::Unload,
-                                                   versioned_endpoint);
-    update_queue_.enqueue(request);
+  // the endpoint may still be loading, or have failed to load, so it's not
+  // enough to check if it exists. Unloading an unknown endpoint does nothing
+  auto request = std::make_shared<UpdateCommand>(UpdateCommandType::Unload,
+                                                 versioned_endpoint);
+  update_queue_.enqueue(request);
+}
+
+void Endpoints::unloadAndWait(const std::string& endpoint,
+                              const std::string& version) {
+  const auto& versioned_endpoint = getVersionedEndpoint(endpoint, version);
+  auto request = std::make_shared<UpdateCommand>(UpdateCommandType::Unload,
+                                                 versioned_endpoint);
+  this->submit(request, std::chrono::seconds(kEndpointLoadTimeout));
+}
+
+void Endpoints::swap(
+  std::vector<std::pair<std::string, ParameterMap>> stages) {
+  if (stages.empty()) {
+    return;
   }
+  auto swap = std::make_shared<SwapState>();
+  swap->stages = std::move(stages);
+  auto request = std::make_shared<UpdateCommand>(
+    UpdateCommandType::Swap, swap->stages.front().first, swap);
+  this->submit(request, std::chrono::seconds(kEndpointLoadTimeout));
+}
+
+void Endpoints::configure(const std::string& endpoint,
+                          const std::string& version,
+                          ParameterMap parameters) {
+  const auto& versioned_endpoint = getVersionedEndpoint(endpoint, version);
+  auto request = std::make_shared<UpdateCommand>(
+    UpdateCommandType::Configure, versioned_endpoint,
+    std::make_shared<ParameterMap>(std::move(parameters)));
+  this->submit(request, std::chrono::seconds(kEndpointLoadTimeout));
 }
 
-// TODO(varunsh): race condition if workers are shutting down
 void Endpoints::infer(const std::string& endpoint,
                       std::unique_ptr<RequestContainer> request,
                       const std::string& version) const {
-  auto versioned_endpoint = getVersionedEndpoint(endpoint, version);
-  WorkerInfo* worker = this->unsafeGet(versioned_endpoint);
+  // each thread remembers the endpoints it used most recently so repeated
+  // requests to them skip the lookup by name
+  constexpr auto kCacheSize = 8;
+  thread_local std::array<EndpointHandle, kCacheSize> cache;
+  thread_local size_t next = 0;
+
+  for (auto& handle : cache) {
+    if (handle.generation != 0 && handle.model == endpoint &&
+        handle.version == version) {
+      this->infer(&handle, std::move(request));
+      return;
+    }
+  }
+
+  auto& handle = cache[next];
+  next = (next + 1) % kCacheSize;
+  handle = this->resolve(endpoint, version);
+  this->infer(&handle, std::move(request));
+}
+
+void Endpoints::infer(EndpointHandle* handle,
+                      std::unique_ptr<RequestContainer> request) const {
+  const auto snapshot = std::atomic_load(&snapshot_);
+  // a stale handle is resolved in the snapshot it indexes since a newer one
+  // may have reused its slot for another endpoint
+  if (handle->index >= snapshot->slots.size() ||
+      snapshot->slots[handle->index].generation != handle->generation) {
+    *handle = resolve(*snapshot, handle->model, handle->version);
+  }
+  // holding the reference keeps the worker alive until the request is queued.
+  // If the worker is unloaded in the meantime, it responds with an error
+  const std::shared_ptr<WorkerInfo> worker =
+    snapshot->slots[handle->index].worker;
   if (worker == nullptr) {
-    throw invalid_argument("Worker " + versioned_endpoint + " not found");
+    // the endpoint was unloaded between resolving and getting the snapshot
+    throw invalid_argument("Worker " + handle->model + " not found");
+  }
+  // cached responses skip the batcher and the workers entirely
+  if (const auto group = worker->getResponseCacheId();
+      group != 0 &&
+      response_cache_->respond(group, request.get(), &pool_)) {
+    return;
   }
   const auto* batcher = worker->getBatcher();
   batcher->enqueue(std::move(request));
 }
 
-bool Endpoints::exists(const std::string& endpoint) {
-  int retval = -1;
-  auto request = std::make_shared<UpdateCommand>(UpdateCommandType::Exists,
-                                                 endpoint, nullptr, &retval);
-  update_queue_.enqueue(request);
-
-  while (retval == -1 && request->eptr == nullptr) {
-    std::this_thread::yield();
-  }
-  if (request->eptr != nullptr) {
-    std::rethrow_exception(request->eptr);
+bool Endpoints::admit(const std::string& endpoint, const std::string& version,
+                      const std::string& client) const {
+  const auto versioned_endpoint = getVersionedEndpoint(endpoint, version);
+  const auto snapshot = std::atomic_load(&snapshot_);
+  auto iterator = snapshot->indices.find(versioned_endpoint);
+  if (iterator == snapshot->indices.end()) {
+    return true;
   }
-  return retval != 0;
+  const auto& worker = snapshot->slots[iterator->second].worker;
+  return worker == nullptr || worker->admit(client);
 }
 
-bool Endpoints::ready(const std::string& endpoint, const std::string& version) {
-  std::shared_ptr<amdinfer::UpdateCommand> request;
-  int ready = -1;
+EndpointHandle Endpoints::resolve(const std::string& endpoint,
+                                  const std::string& version) const {
+  const auto snapshot = std::atomic_load(&snapshot_);
+  return resolve(*snapshot, endpoint, version);
+}
+
+EndpointHandle Endpoints::resolve(const EndpointTable& table,
+                                  const std::string& endpoint,
+                                  const std::string& version) {
   auto versioned_endpoint = getVersionedEndpoint(endpoint, version);
-  request = std::make_shared<UpdateCommand>(
-    UpdateCommandType::Ready, versioned_endpoint, nullptr, &ready);
-  update_queue_.enqueue(request);
-  while (ready == -1 && request->eptr == nullptr) {
-    std::this_thread::yield();
+  auto iterator = table.indices.find(versioned_endpoint);
+  if (iterator == table.indices.end()) {
+    throw invalid_argument("Worker " + versioned_endpoint + " not found");
   }
-  if (request->eptr != nullptr) {
-    std::rethrow_exception(request->eptr);
+  const auto index = iterator->second;
+  return {endpoint, version, index, table.slots[index].generation};
+}
+
+bool Endpoints::exists(const std::string& endpoint) const {
+  const auto snapshot = std::atomic_load(&snapshot_);
+  return snapshot->indices.find(endpoint) != snapshot->indices.end();
+}
+
+bool Endpoints::ready(const std::string& endpoint,
+                      const std::string& version) const {
+  return this->state(endpoint, version).state == EndpointState::Ready;
+}
+
+EndpointStatus Endpoints::state(const std::string& endpoint,
+                                const std::string& version) const {
+  auto versioned_endpoint = getVersionedEndpoint(endpoint, version);
+  const auto snapshot = std::atomic_load(&snapshot_);
+  auto iterator = snapshot->states.find(versioned_endpoint);
+  if (iterator == snapshot->states.end()) {
+    throw invalid_argument("Worker " + versioned_endpoint + " not found");
   }
-  return ready != 0;
+  return iterator->second;
 }
 
-std::vector<std::string> Endpoints::list() {
-  std::shared_ptr<amdinfer::UpdateCommand> request;
+std::vector<std::string> Endpoints::list() const {
+  const auto snapshot = std::atomic_load(&snapshot_);
   std::vector<std::string> endpoints;
-  bool retval = false;
-  request = std::make_shared<UpdateCommand>(UpdateCommandType::List, "",
-                                            &endpoints, &retval);
-  update_queue_.enqueue(request);
-  while (!retval && request->eptr == nullptr) {
-    std::this_thread::yield();
-  }
-  if (request->eptr != nullptr) {
-    std::rethrow_exception(request->eptr);
+  endpoints.reserve(snapshot->indices.size());
+  for (const auto& [endpoint, _] : snapshot->indices) {
+    if (!util::startsWith(endpoint, "responder")) {
+      endpoints.push_back(endpoint);
+    }
   }
   return endpoints;
 }
 
 ModelMetadata Endpoints::metadata(const std::string& endpoint,
                                   const std::string& version) {
-  std::shared_ptr<amdinfer::UpdateCommand> request;
-  ModelMetadata metadata{"", ""};
-  bool retval = false;
+  auto metadata = std::make_shared<ModelMetadata>("", "");
   auto versioned_endpoint = getVersionedEndpoint(endpoint, version);
-  request = std::make_shared<UpdateCommand>(
-    UpdateCommandType::Metadata, versioned_endpoint, &metadata, &retval);
+  auto request = std::make_shared<UpdateCommand>(
+    UpdateCommandType::Metadata, versioned_endpoint, nullptr, metadata);
+  this->submit(request, std::chrono::seconds(kEndpointQueryTimeout));
+  return *metadata;
+}
+
+void Endpoints::submit(const std::shared_ptr<UpdateCommand>& request,
+                       std::chrono::seconds timeout) {
+  // get the future before the update thread can see the command
+  auto future = request->done.get_future();
   update_queue_.enqueue(request);
-  while (!retval && request->eptr == nullptr) {
-    std::this_thread::yield();
-  }
-  if (request->eptr != nullptr) {
-    std::rethrow_exception(request->eptr);
+  if (future.wait_for(timeout) == std::future_status::timeout) {
+    // the command stays queued and may still complete later. Its objects are
+    // shared with it so they remain valid after we return
+    throw runtime_error("Timed out waiting for " + request->key);
   }
-  return metadata;
+  // rethrows the exception if the command failed
+  future.get();
 }
 
 const MemoryPool* Endpoints::getPool() const { return &pool_; }
 
+void Endpoints::setResponseCacheSize(size_t max_bytes) {
+  response_cache_->setMaxBytes(max_bytes);
+}
+
 // TODO(varunsh): if multiple commands sent post-shutdown, they will linger
 // in the queue and may cause problems
 void Endpoints::shutdown() {
+  if (this->autoscale_thread_.joinable()) {
+    {
+      const std::lock_guard lock{autoscale_mutex_};
+      autoscale_stop_ = true;
+    }
+    autoscale_cv_.notify_all();
+    this->autoscale_thread_.join();
+  }
   if (this->update_thread_.joinable()) {
     auto request = std::make_shared<UpdateCommand>(UpdateCommandType::Shutdown);
     update_queue_.enqueue(request);
     this->update_thread_.join();
   }
+  // after the update thread so no more swaps can send workers to drain
+  if (this->drain_thread_.joinable()) {
+    drain_queue_.enqueue({nullptr, 0});
+    this->drain_thread_.join();
+  }
 }
 
 void Endpoints::updateManager(UpdateCommandQueue* input_queue) {
@@ -174,53 +345,52 @@ void Endpoints::updateManager(UpdateCommandQueue* input_queue) {
     AMDINFER_LOG_DEBUG(logger_,
                        "Got request in Manager update thread with ID " +
                          std::to_string(static_cast<int>(request->cmd)));
+    run = this->unsafeProcess(request);
+  }
+  AMDINFER_LOG_DEBUG(logger_, "Ending update_thread");
+}
+
+bool Endpoints::unsafeProcess(const std::shared_ptr<UpdateCommand>& request) {
+  bool run = true;
+  try {
+    bool done = true;
     switch (request->cmd) {
       case UpdateCommandType::Load:
-        try {
-          auto* parameters = static_cast<ParameterMap*>(request->object);
-          auto endpoint = this->unsafeLoad(request->key, parameters);
-          static_cast<std::string*>(request->retval)
-            ->assign(std::string{endpoint});
-        } catch (...) {
-          request->eptr = std::current_exception();
-        }
+        done = this->unsafeLoad(request);
         break;
-      case UpdateCommandType::Unload:
-        this->unsafeUnload(request->key);
+      case UpdateCommandType::LoadDone:
+        // nothing waits on this command. It fulfils the original Load instead
+        this->unsafeFinishLoad(*request);
         break;
-      case UpdateCommandType::Exists:
-        try {
-          *static_cast<int*>(request->retval) =
-            static_cast<int>(this->unsafeExists(request->key));
-        } catch (...) {
-          request->eptr = std::current_exception();
+      case UpdateCommandType::Unload:
+        done = !this->unsafeDefer(request->key, request);
+        if (done) {
+          this->unsafeUnload(request->key);
         }
         break;
-      case UpdateCommandType::Ready:
-        try {
-          auto metadata = this->unsafeMetadata(request->key);
-          *static_cast<int*>(request->retval) =
-            static_cast<int>(metadata.isReady());
-        } catch (...) {
-          request->eptr = std::current_exception();
-        }
+      case UpdateCommandType::Swap:
+        this->unsafeSwap(request);
+        done = false;
         break;
-      case UpdateCommandType::List:
-        try {
-          auto* list = static_cast<std::vector<std::string>*>(request->object);
-          this->unsafeList(list);
-          *static_cast<bool*>(request->retval) = true;
-        } catch (...) {
-          request->eptr = std::current_exception();
-        }
+      case UpdateCommandType::SwapDone:
+        // like LoadDone, this fulfils the original Swap command
+        this->unsafeFinishSwap(*request);
+        break;
+      case UpdateCommandType::Configure:
+        done = !this->unsafeDefer(request->key, request) &&
+               this->unsafeConfigure(request);
+        break;
+      case UpdateCommandType::Autoscale:
+        this->unsafeAutoscale();
         break;
       case UpdateCommandType::Metadata:
-        try {
-          auto* metadata = static_cast<ModelMetadata*>(request->object);
-          *metadata = this->unsafeMetadata(request->key);
-          *static_cast<bool*>(request->retval) = true;
-        } catch (...) {
-          request->eptr = std::current_exception();
+        // only wait for loads that add a worker to an existing endpoint. If
+        // the endpoint is new, it doesn't exist yet
+        done = this->unsafeGet(request->key) == nullptr ||
+               !this->unsafeDefer(request->key, request);
+        if (done) {
+          *static_cast<ModelMetadata*>(request->retval.get()) =
+            this->unsafeMetadata(request->key);
         }
         break;
       case UpdateCommandType::Shutdown:
@@ -228,13 +398,29 @@ void Endpoints::updateManager(UpdateCommandQueue* input_queue) {
         run = false;
         break;
     }
+    if (done) {
+      request->done.set_value();
+    }
+  } catch (...) {
+    request->done.set_exception(std::current_exception());
   }
-  AMDINFER_LOG_DEBUG(logger_, "Ending update_thread");
+  return run;
+}
+
+bool Endpoints::unsafeDefer(const std::string& endpoint,
+                            const std::shared_ptr<UpdateCommand>& request) {
+  if (busy_.find(endpoint) == busy_.end()) {
+    return false;
+  }
+  deferred_[endpoint].push_back(request);
+  return true;
 }
 
 // TODO(varunsh): clarify nomenclature here with worker/model/versioned_model
-std::string Endpoints::unsafeLoad(const std::string& worker,
-                                  ParameterMap* parameters) {
+bool Endpoints::unsafeLoad(const std::shared_ptr<UpdateCommand>& request) {
+  const auto& worker = request->key;
+  auto* parameters = static_cast<ParameterMap*>(request->object.get());
+
   bool share = true;
   if (parameters->has("share")) {
     share = parameters->get<bool>("share");
@@ -242,6 +428,14 @@ std::string Endpoints::unsafeLoad(const std::string& worker,
   }
 
   auto endpoint = this->insertWorker(worker, *parameters);
+  if (this->unsafeDefer(endpoint, request)) {
+    // restore the parameters so the load is the same when it's replayed
+    if (!share) {
+      parameters->put("share", false);
+    }
+    return false;
+  }
+  *static_cast<std::string*>(request->retval.get()) = endpoint;
   auto* worker_info = this->unsafeGet(endpoint);
 
   std::string worker_name = endpoint;
@@ -251,11 +445,20 @@ std::string Endpoints::unsafeLoad(const std::string& worker,
     parameters->put("worker", worker_name);
   }
 
+  // the command is finished by a LoadDone command once the load pool is done
+  auto finish = [this, request, endpoint](std::shared_ptr<WorkerInfo> worker,
+                                          std::exception_ptr error) {
+    auto result = std::make_shared<LoadResult>(
+      LoadResult{request, std::move(worker), std::move(error)});
+    update_queue_.enqueue(std::make_shared<UpdateCommand>(
+      UpdateCommandType::LoadDone, endpoint, std::move(result)));
+  };
+
   // if the worker doesn't exist yet, we need to create it
-  try {
-    if (worker_info == nullptr) {
-      BatchPtrQueue* next = nullptr;
-      std::vector<MemoryAllocators> next_allocators;
+  if (worker_info == nullptr) {
+    BatchPtrQueue* next = nullptr;
+    std::vector<MemoryAllocators> next_allocators;
+    try {
       if (parameters->has("next")) {
         auto next_endpoint = parameters->get<std::string>("next");
         const auto* next_info = this->unsafeGet(next_endpoint);
@@ -271,21 +474,218 @@ std::string Endpoints::unsafeLoad(const std::string& worker,
       } else {
         // worker being loaded is the responder so we don't do anything
       }
+      // once it's loaded, the autoscaler starts sampling it
+      if (auto policy = getAutoscalePolicy(*parameters); policy.has_value()) {
+        autoscaler_.add(endpoint, policy.value());
+      }
+    } catch (...) {
+      // undo the load if the worker can't be created
+      this->unsafeUnload(endpoint);
+      throw;
+    }
 
-      auto new_worker = std::make_unique<WorkerInfo>(
-        worker_name, parameters, &pool_, next, next_allocators);
-      this->workers_.try_emplace(endpoint, std::move(new_worker));
-      // if the worker exists but the share parameter is false, we need to add
-      // one
-    } else if (!share) {
-      worker_info->addAndStartWorker(worker_name, parameters, &pool_);
+    busy_.insert(endpoint);
+    this->unsafeSetState(endpoint, {EndpointState::Loading, ""});
+    load_pool_.push([this, finish, endpoint, worker_name, parameters, next,
+                     next_allocators](int) {
+      std::shared_ptr<WorkerInfo> worker_info;
+      try {
+        // profiling picks the batch size and timeout the worker is made with
+        autotune(endpoint, worker_name, parameters, &pool_, next,
+                 next_allocators);
+        worker_info = std::make_shared<WorkerInfo>(
+          worker_name, parameters, &pool_, next, next_allocators);
+        // the endpoint only becomes ready after it's warmed up
+        warmup(endpoint, worker_info.get(), *parameters, &pool_);
+        finish(std::move(worker_info), nullptr);
+      } catch (...) {
+        if (worker_info != nullptr) {
+          worker_info->shutdown();
+        }
+        finish(nullptr, std::current_exception());
+      }
+    });
+    return false;
+  }
+
+  // if the worker exists but the share parameter is false, we need to add one
+  if (!share) {
+    // the endpoint can't be unloaded while it's busy so worker_info is valid
+    busy_.insert(endpoint);
+    load_pool_.push([this, finish, worker_info, worker_name, parameters](int) {
+      try {
+        worker_info->addAndStartWorker(worker_name, parameters, &pool_);
+        finish(nullptr, nullptr);
+      } catch (...) {
+        finish(nullptr, std::current_exception());
+      }
+    });
+    return false;
+  }
+  return true;
+}
+
+void Endpoints::unsafeFinishLoad(const UpdateCommand& command) {
+  const auto& endpoint = command.key;
+  auto* result = static_cast<LoadResult*>(command.object.get());
+  busy_.erase(endpoint);
+
+  if (result->error != nullptr) {
+    // undo the load if a new endpoint failed. If a worker was being added to
+    // an existing endpoint, the endpoint is left as it was
+    if (this->unsafeGet(endpoint) == nullptr) {
+      this->unsafeUnload(endpoint);
+      this->unsafeSetState(endpoint, {EndpointState::Failed,
+                                      getMessage(result->error)});
+    }
+    result->request->done.set_exception(result->error);
+  } else {
+    if (result->worker != nullptr) {
+      this->unsafeInsert(endpoint, std::move(result->worker));
+    }
+    result->request->done.set_value();
+  }
+
+  this->unsafeReplay(endpoint);
+}
+
+void Endpoints::unsafeSwap(const std::shared_ptr<UpdateCommand>& request) {
+  auto swap = std::static_pointer_cast<SwapState>(request->object);
+  for (const auto& [endpoint, _] : swap->stages) {
+    if (this->unsafeDefer(endpoint, request)) {
+      return;
+    }
+  }
+
+  for (auto& [endpoint, parameters] : swap->stages) {
+    if (endpoint == "responder") {
+      throw invalid_argument("The responder cannot be swapped");
+    }
+    if (this->unsafeGet(endpoint) == nullptr) {
+      throw invalid_argument("Worker " + endpoint + " not found");
+    }
+    // a new worker group always starts with one worker
+    parameters.erase("share");
+  }
+
+  // the new workers are linked to each other and the last one is linked to
+  // whatever follows the chain
+  const auto& last = swap->stages.back().second;
+  const WorkerInfo* next_info = nullptr;
+  if (last.has("next")) {
+    auto next_endpoint = last.get<std::string>("next");
+    next_info = this->unsafeGet(next_endpoint);
+    if (next_info == nullptr) {
+      throw invalid_argument("No next endpoint found at: " + next_endpoint);
+    }
+  } else {
+    next_info = this->unsafeGet("responder");
+  }
+  auto* next = next_info->getInputQueue();
+  auto next_allocators = next_info->getAllocators();
+
+  swap->request = request;
+  swap->parameters.clear();
+  for (const auto& [endpoint, parameters] : swap->stages) {
+    swap->parameters.push_back(parameters);
+    if (!parameters.has("worker")) {
+      swap->parameters.back().put("worker", endpoint);
+    }
+    busy_.insert(endpoint);
+  }
+
+  load_pool_.push([this, swap, next, next_allocators](int) {
+    auto& workers = swap->workers;
+    workers.resize(swap->stages.size());
+    try {
+      auto* queue = next;
+      auto allocators = next_allocators;
+      for (auto i = workers.size(); i-- > 0;) {
+        auto* parameters = &swap->parameters[i];
+        const auto worker_name = parameters->get<std::string>("worker");
+        autotune(swap->stages[i].first, worker_name, parameters, &pool_, queue,
+                 allocators);
+        workers[i] = std::make_shared<WorkerInfo>(worker_name, parameters,
+                                                  &pool_, queue, allocators);
+        queue = workers[i]->getInputQueue();
+        allocators = workers[i]->getAllocators();
+      }
+      for (auto i = 0U; i < workers.size(); ++i) {
+        warmup(swap->stages[i].first, workers[i].get(), swap->parameters[i],
+               &pool_);
+      }
+    } catch (...) {
+      for (const auto& worker : workers) {
+        if (worker != nullptr) {
+          worker->shutdown();
+        }
+      }
+      workers.clear();
+      swap->error = std::current_exception();
+    }
+    update_queue_.enqueue(std::make_shared<UpdateCommand>(
+      UpdateCommandType::SwapDone, swap->request->key, swap));
+  });
+}
+
+void Endpoints::unsafeFinishSwap(const UpdateCommand& command) {
+  auto swap = std::static_pointer_cast<SwapState>(command.object);
+  for (const auto& [endpoint, _] : swap->stages) {
+    busy_.erase(endpoint);
+  }
+
+  if (swap->error != nullptr) {
+    swap->request->done.set_exception(swap->error);
+  } else {
+    // the endpoints were busy so they can't have been unloaded in the meantime
+    std::vector<std::shared_ptr<WorkerInfo>> old_workers;
+    for (auto i = 0U; i < swap->stages.size(); ++i) {
+      const auto& [endpoint, parameters] = swap->stages[i];
+      auto& slot = workers_.slots[workers_.indices.at(endpoint)];
+      // the generation is unchanged so existing handles stay valid
+      old_workers.push_back(std::move(slot.worker));
+      slot.worker = std::move(swap->workers[i]);
+
+      // future loads with the new parameters should find this endpoint
+      auto hyphen_pos = endpoint.find('-');
+      auto worker = endpoint.substr(0, hyphen_pos);
+      auto& map = worker_endpoints_[worker];
+      map.erase(worker_parameters_[endpoint]);
+      map.insert(std::make_pair(parameters, endpoint));
+      worker_parameters_.insert_or_assign(endpoint, parameters);
+      // the new parameters may change how the endpoint is autoscaled
+      if (auto policy = getAutoscalePolicy(parameters); policy.has_value()) {
+        autoscaler_.add(endpoint, policy.value());
+      } else {
+        autoscaler_.remove(endpoint);
+      }
+    }
+    const auto published = this->unsafePublish();
+    for (const auto& worker : old_workers) {
+      response_cache_->invalidate(worker->getResponseCacheId());
+    }
+
+    // drain in chain order so each old worker has run all its requests before
+    // the one after it is stopped
+    for (auto& worker : old_workers) {
+      drain_queue_.enqueue({std::move(worker), published});
+    }
+    swap->request->done.set_value();
+  }
+
+  for (const auto& [endpoint, _] : swap->stages) {
+    this->unsafeReplay(endpoint);
+  }
+}
+
+void Endpoints::unsafeReplay(const std::string& endpoint) {
+  if (auto iterator = deferred_.find(endpoint); iterator != deferred_.end()) {
+    auto commands = std::move(iterator->second);
+    deferred_.erase(iterator);
+    for (const auto& deferred : commands) {
+      this->unsafeProcess(deferred);
     }
-  } catch (...) {
-    // undo the load if the worker creation fails
-    this->unsafeUnload(endpoint);
-    throw;
   }
-  return endpoint;
 }
 
 void Endpoints::unsafeUnload(const std::string& endpoint) {
@@ -301,7 +701,7 @@ void Endpoints::unsafeUnload(const std::string& endpoint) {
   // if it's a brand-new worker that failed or the last worker being unloaded,
   // clean up our parameters and endpoint metadata
   if (worker_info == nullptr || worker_info->getGroupSize() == 0) {
-    this->workers_.erase(endpoint);
+    this->unsafeErase(endpoint);
 
     if (worker_endpoints_.find(worker) != worker_endpoints_.end()) {
       auto& map = worker_endpoints_.at(worker);
@@ -318,26 +718,208 @@ void Endpoints::unsafeUnload(const std::string& endpoint) {
   }
 }
 
-bool Endpoints::unsafeExists(const std::string& endpoint) const {
-  return workers_.find(endpoint) != workers_.end();
+bool Endpoints::unsafeConfigure(
+  const std::shared_ptr<UpdateCommand>& request) {
+  const auto& endpoint = request->key;
+  const auto& parameters = *static_cast<ParameterMap*>(request->object.get());
+  auto* worker = this->unsafeGet(endpoint);
+  if (worker == nullptr) {
+    throw invalid_argument("Worker " + endpoint + " not found");
+  }
+
+  ParameterMap batching;
+  auto change = 0;
+  for (const auto& [key, value] : parameters) {
+    if (key == "batch_size" || key == "timeout") {
+      batching.put(key, value);
+    } else if (key == "workers") {
+      const auto workers = parameters.get<int32_t>("workers");
+      if (workers <= 0) {
+        throw invalid_argument("The number of workers must be positive");
+      }
+      const auto autoscaled = autoscaler_.endpoints();
+      if (std::find(autoscaled.begin(), autoscaled.end(), endpoint) !=
+          autoscaled.end()) {
+        throw invalid_argument("The number of workers in " + endpoint +
+                               " is set by the autoscaler");
+      }
+      change = workers - static_cast<int>(worker->getGroupSize());
+    } else {
+      throw invalid_argument("The parameter " + key +
+                             " cannot be changed without reloading");
+    }
+  }
+  worker->configure(batching);
+  AMDINFER_LOG_INFO(logger_, "Configured " + endpoint);
+
+  if (change == 0) {
+    return true;
+  }
+  this->unsafeScale(request, worker, change);
+  return false;
+}
+
+void Endpoints::autoscaleTimer() {
+  util::setThreadName("autoscale");
+  const std::chrono::milliseconds interval{kAutoscaleInterval};
+  std::unique_lock lock{autoscale_mutex_};
+  while (!autoscale_cv_.wait_for(lock, interval,
+                                 [this]() { return autoscale_stop_; })) {
+    update_queue_.enqueue(
+      std::make_shared<UpdateCommand>(UpdateCommandType::Autoscale));
+  }
+}
+
+void Endpoints::drainManager() {
+  util::setThreadName("drain");
+  std::pair<std::shared_ptr<WorkerInfo>, uint64_t> request;
+  while (true) {
+    drain_queue_.wait_dequeue(request);
+    auto& [worker, published] = request;
+    if (worker == nullptr) {
+      break;
+    }
+    // the data path reaches worker groups only through snapshots and the ones
+    // published since this group was replaced don't have it. Once the older
+    // ones are released, no more requests can arrive
+    const std::chrono::seconds timeout{kEndpointDrainTimeout};
+    if (!snapshots_->waitForOlder(published, timeout)) {
+      AMDINFER_LOG_WARN(logger_,
+                        "Timed out waiting for requests to a replaced worker "
+                        "group to be queued. Draining it anyway");
+    }
+    worker->drain();
+    // release it now rather than when the next worker arrives
+    worker.reset();
+  }
+}
+
+void Endpoints::unsafeAutoscale() {
+  const auto now = Autoscaler::Clock::now();
+  for (const auto& endpoint : autoscaler_.endpoints()) {
+    auto* worker = this->unsafeGet(endpoint);
+    // skip endpoints that are still loading or are already changing
+    if (worker == nullptr || busy_.find(endpoint) != busy_.end()) {
+      continue;
+    }
+    const auto change = autoscaler_.sample(endpoint, worker->getGroupSize(),
+                                           worker->getQueueDepth(), now);
+    if (change != 0) {
+#ifdef AMDINFER_ENABLE_METRICS
+      Metrics::getInstance().incrementCounter(
+        change > 0 ? MetricCounterIDs::AutoscaleUp
+                   : MetricCounterIDs::AutoscaleDown);
+#endif
+      // nothing waits for the change so the command is only used to finish it
+      this->unsafeScale(
+        std::make_shared<UpdateCommand>(UpdateCommandType::Load, endpoint),
+        worker, change);
+    }
+  }
+}
+
+void Endpoints::unsafeScale(const std::shared_ptr<UpdateCommand>& request,
+                            WorkerInfo* worker, int change) {
+  const auto& endpoint = request->key;
+  auto parameters =
+    std::make_shared<ParameterMap>(worker_parameters_.at(endpoint));
+  if (!parameters->has("worker")) {
+    parameters->put("worker", endpoint);
+  }
+  AMDINFER_LOG_INFO(logger_, std::string{change > 0 ? "Adding " : "Retiring "} +
+                               std::to_string(std::abs(change)) +
+                               " worker(s) in " + endpoint);
+
+  // this is handled like loading an unshared worker. The endpoint can't be
+  // unloaded while it's busy so the worker stays valid
+  busy_.insert(endpoint);
+  load_pool_.push([this, request, endpoint, worker, parameters, change](int) {
+    std::exception_ptr error;
+    try {
+      for (auto i = 0; i < std::abs(change); ++i) {
+        if (change > 0) {
+          worker->addAndStartWorker(parameters->get<std::string>("worker"),
+                                    parameters.get(), &pool_);
+        } else {
+          worker->unload();
+        }
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+    auto result =
+      std::make_shared<LoadResult>(LoadResult{request, nullptr, error});
+    update_queue_.enqueue(std::make_shared<UpdateCommand>(
+      UpdateCommandType::LoadDone, endpoint, std::move(result)));
+  });
 }
 
 WorkerInfo* Endpoints::unsafeGet(const std::string& endpoint) const {
-  if (auto iterator = workers_.find(endpoint); iterator != workers_.end()) {
-    return iterator->second.get();
+  if (auto iterator = workers_.indices.find(endpoint);
+      iterator != workers_.indices.end()) {
+    return workers_.slots[iterator->second].worker.get();
   }
   return nullptr;
 }
 
-void Endpoints::unsafeList(std::vector<std::string>* list) const {
-  assert(list != nullptr);
-  assert(list->empty());
-  list->reserve(workers_.size());
-  for (const auto& [worker, _] : workers_) {
-    if (!util::startsWith(worker, "responder")) {
-      list->push_back(worker);
+void Endpoints::unsafeInsert(const std::string& endpoint,
+                             std::shared_ptr<WorkerInfo> worker) {
+  auto& slots = this->workers_.slots;
+  // reuse an empty slot if there is one so the table doesn't keep growing
+  auto index = slots.size();
+  for (size_t i = 0; i < slots.size(); ++i) {
+    if (slots[i].worker == nullptr) {
+      index = i;
+      break;
+    }
+  }
+  if (index == slots.size()) {
+    slots.emplace_back();
+  }
+  slots[index] = {std::move(worker), ++generation_};
+  this->workers_.indices.insert_or_assign(endpoint, index);
+  this->workers_.states.insert_or_assign(
+    endpoint, EndpointStatus{EndpointState::Ready, ""});
+  this->unsafePublish();
+}
+
+void Endpoints::unsafeErase(const std::string& endpoint) {
+  autoscaler_.remove(endpoint);
+  const auto erased_state = this->workers_.states.erase(endpoint) > 0;
+  auto iterator = this->workers_.indices.find(endpoint);
+  if (iterator == this->workers_.indices.end()) {
+    if (erased_state) {
+      this->unsafePublish();
     }
+    return;
   }
+  auto& slot = this->workers_.slots[iterator->second];
+  if (slot.worker != nullptr) {
+    response_cache_->invalidate(slot.worker->getResponseCacheId());
+  }
+  slot = {};
+  this->workers_.indices.erase(iterator);
+  this->unsafePublish();
+}
+
+void Endpoints::unsafeSetState(const std::string& endpoint,
+                               EndpointStatus status) {
+  this->workers_.states.insert_or_assign(endpoint, std::move(status));
+  this->unsafePublish();
+}
+
+uint64_t Endpoints::unsafePublish() {
+  auto table = std::make_unique<const EndpointTable>(this->workers_);
+  const auto sequence = snapshots_->add();
+  // the deleter runs on whichever thread lets go of the snapshot last
+  std::shared_ptr<const EndpointTable> snapshot{
+    table.release(),
+    [snapshots = snapshots_, sequence](const EndpointTable* expired) {
+      delete expired;  // NOLINT(cppcoreguidelines-owning-memory)
+      snapshots->release(sequence);
+    }};
+  std::atomic_store(&snapshot_, std::move(snapshot));
+  return sequence;
 }
 
 // FIXME(varunsh): potential race condition if the worker is being deleted
@@ -350,10 +932,48 @@ ModelMetadata Endpoints::unsafeMetadata(const std::string& endpoint) const {
 }
 
 void Endpoints::unsafeShutdown() {
-  for (auto const& worker_info : this->workers_) {
-    worker_info.second->shutdown();
+  // let the loads in progress finish and then add their workers so they're
+  // shut down with the rest. Anything else still queued is failed
+  load_pool_.stop(true);
+  std::shared_ptr<UpdateCommand> request;
+  while (update_queue_.try_dequeue(request)) {
+    if (request->cmd == UpdateCommandType::LoadDone) {
+      auto* result = static_cast<LoadResult*>(request->object.get());
+      if (result->worker != nullptr) {
+        this->unsafeInsert(request->key, result->worker);
+      }
+      result->request->done.set_exception(std::make_exception_ptr(
+        runtime_error("The server shut down during the load")));
+    } else if (request->cmd == UpdateCommandType::SwapDone) {
+      // the old workers are still in place so only the new ones are unloaded
+      auto swap = std::static_pointer_cast<SwapState>(request->object);
+      for (const auto& worker : swap->workers) {
+        worker->shutdown();
+      }
+      swap->request->done.set_exception(std::make_exception_ptr(
+        runtime_error("The server shut down during the swap")));
+    } else {
+      request->done.set_exception(
+        std::make_exception_ptr(runtime_error("The server is shutting down")));
+    }
+  }
+  for (auto& [_, commands] : deferred_) {
+    for (const auto& deferred : commands) {
+      deferred->done.set_exception(
+        std::make_exception_ptr(runtime_error("The server is shutting down")));
+    }
+  }
+  deferred_.clear();
+  busy_.clear();
+  autoscaler_ = {};
+
+  for (auto const& slot : this->workers_.slots) {
+    if (slot.worker != nullptr) {
+      slot.worker->shutdown();
+    }
   }
-  this->workers_.clear();
+  this->workers_ = {};
+  this->unsafePublish();
   this->worker_endpoints_.clear();
   this->worker_indices_.clear();
   this->worker_parameters_.clear();
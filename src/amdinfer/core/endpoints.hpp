@@ -20,20 +20,32 @@
 #ifndef GUARD_AMDINFER_CORE_ENDPOINTS
 #define GUARD_AMDINFER_CORE_ENDPOINTS
 
-#include <exception>      // for exception_ptr
-#include <map>            // for map
-#include <memory>         // for allocator, uniq...
-#include <string>         // for string
-#include <thread>         // for thread
-#include <unordered_map>  // for unordered_map
-#include <utility>        // for move
-#include <vector>         // for vector
+#include <atomic>              // for atomic
+#include <chrono>              // for milliseconds, seconds
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint64_t
+#include <future>              // for promise
+#include <map>                 // for map
+#include <memory>              // for allocator, uniq...
+#include <mutex>               // for mutex
+#include <set>                 // for set
+#include <string>              // for string
+#include <thread>              // for thread
+#include <unordered_map>       // for unordered_map
+#include <unordered_set>       // for unordered_set
+#include <utility>             // for move, pair
+#include <vector>              // for vector
 
 #include "amdinfer/build_options.hpp"          // for AMDINFER_ENABLE...
+#include "amdinfer/core/autoscaler.hpp"        // for Autoscaler
+#include "amdinfer/core/endpoint_handle.hpp"   // for EndpointHandle
 #include "amdinfer/core/memory_pool/pool.hpp"  // for MemoryPool
 #include "amdinfer/core/model_metadata.hpp"    // for ModelMetadata
 #include "amdinfer/core/parameters.hpp"        // for ParameterMap
+#include "amdinfer/core/response_cache.hpp"    // for ResponseCache
 #include "amdinfer/observation/logging.hpp"    // for Logger, Loggers
+#include "amdinfer/util/ctpl.hpp"              // for ThreadPool
 #include "amdinfer/util/queue.hpp"             // for BlockingQueue
 
 namespace amdinfer {
@@ -47,40 +59,110 @@ class WorkerInfo;
  */
 enum class UpdateCommandType {
   Load,
+  LoadDone,
   Unload,
-  Exists,
-  Ready,
-  List,
+  Swap,
+  SwapDone,
+  Configure,
+  Autoscale,
   Metadata,
   Shutdown,
 };
 
 /**
  * @brief Commands sent to update the Manager consist of an ID, a key
- * value (string), an integer, and a pointer to an exception so if the update
- * fails for some reason, this information is communicated back to the requester
+ * value (string), optional input and output objects and a promise that is
+ * fulfilled when the command completes. If the update fails for some reason,
+ * the promise holds the exception so it's communicated back to the requester.
  */
 struct UpdateCommand {
   UpdateCommand(UpdateCommandType cmd, std::string key = "",
-                void* object = nullptr, void* retval = nullptr)
-    : cmd(cmd), key(std::move(key)), object(object), retval(retval) {}
+                std::shared_ptr<void> object = nullptr,
+                std::shared_ptr<void> retval = nullptr)
+    : cmd(cmd),
+      key(std::move(key)),
+      object(std::move(object)),
+      retval(std::move(retval)) {}
   /// The command ID
   UpdateCommandType cmd;
   /// A string key that a command can make use of. Usually identifies the worker
   std::string key;
-  /// Pointer to an arbitrary object
-  void* object;
-  /// Pointer to a caller-allocated variable to hold the return value
-  void* retval = nullptr;
   /**
-   * @brief The caller making a request through the update mechanism should
-   * catch this exception which is thrown if the requested update fails so the
-   * caller is not waiting endlessly.
+   * @brief An arbitrary object. It's shared with the command, rather than
+   * owned by the caller, so it stays valid even if the caller stops waiting
    */
-  std::exception_ptr eptr = nullptr;
+  std::shared_ptr<void> object;
+  /// A variable to hold the return value, shared for the same reason
+  std::shared_ptr<void> retval;
+  /// Fulfilled by the update thread when the command is done or has failed
+  std::promise<void> done;
 };
 using UpdateCommandQueue = BlockingQueue<std::shared_ptr<UpdateCommand>>;
 
+/// The lifecycle of an endpoint as seen by the data path
+enum class EndpointState {
+  Loading,
+  Ready,
+  Failed,
+};
+
+struct EndpointStatus {
+  EndpointState state = EndpointState::Loading;
+  /// Why the endpoint failed to load, if it did
+  std::string error;
+};
+
+/// A position in the EndpointTable that holds one endpoint's worker group
+struct EndpointSlot {
+  std::shared_ptr<WorkerInfo> worker;
+  /// Changes each time an endpoint is added to this slot. Zero if it's empty
+  uint64_t generation = 0;
+};
+
+/**
+ * @brief The loaded endpoints. The slots are stable so an endpoint can be found
+ * by its index, and the generation of the slot, instead of its name.
+ */
+struct EndpointTable {
+  /// endpoint -> index into slots
+  std::unordered_map<std::string, size_t> indices;
+  std::vector<EndpointSlot> slots;
+  /**
+   * @brief endpoint -> status. An endpoint is here while it's loading, once
+   * it's ready and, after a failed load, until it's unloaded or loaded again
+   */
+  std::unordered_map<std::string, EndpointStatus> states;
+};
+
+/**
+ * @brief Tracks which of the published snapshots of the EndpointTable the data
+ * path still holds so the update thread's changes can wait for them without
+ * polling
+ */
+class SnapshotTracker {
+ public:
+  /// Record a new snapshot and get its sequence number
+  uint64_t add();
+  /// Record that nothing refers to the snapshot anymore
+  void release(uint64_t sequence);
+  /**
+   * @brief Wait until all the snapshots published before the given one have
+   * been released
+   *
+   * @param sequence sequence number of the snapshot
+   * @param timeout how long to wait
+   * @return bool false if some older snapshots are still held after the timeout
+   */
+  bool waitForOlder(uint64_t sequence, std::chrono::milliseconds timeout);
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  uint64_t latest_ = 0;
+  /// Sequence numbers of the snapshots that haven't been released
+  std::set<uint64_t> live_;
+};
+
 class Endpoints {
  public:
   Endpoints();
@@ -89,21 +171,111 @@ class Endpoints {
   std::string load(const std::string& worker, const std::string& version,
                    ParameterMap parameters);
   void unload(const std::string& endpoint, const std::string& version);
+  /**
+   * @brief Unload an endpoint and wait until it's removed so no new requests
+   * can reach it
+   *
+   * @param endpoint name of the endpoint
+   * @param version version of the endpoint. Empty for the default
+   * @throws runtime_error if the unload times out
+   */
+  void unloadAndWait(const std::string& endpoint, const std::string& version);
+  /**
+   * @brief Replace the worker groups of loaded endpoints without dropping
+   * requests. The new workers are created and warmed up alongside the old ones
+   * and then all the endpoints are redirected to them at once. The old workers
+   * run the requests they already have and are then unloaded in the
+   * background. Each new worker group starts with one worker.
+   *
+   * @param stages the endpoints to replace, paired with the parameters for
+   * their new workers. If there's more than one, they must be a chain in order
+   * where each one's "next" parameter names the following one
+   * @throws invalid_argument if an endpoint isn't loaded
+   * @throws any exception raised while creating or warming up the new workers,
+   * in which case the endpoints are left as they were
+   */
+  void swap(std::vector<std::pair<std::string, ParameterMap>> stages);
+  /**
+   * @brief Change how a loaded endpoint batches requests and how many workers
+   * it has without reloading it. Batching changes take effect from the next
+   * batch. Workers are added or retired like the autoscaler does and this
+   * returns once they have been.
+   *
+   * @param endpoint name of the endpoint
+   * @param version version of the endpoint. Empty for the default
+   * @param parameters any of "batch_size", which can't exceed the batch size
+   * the endpoint was loaded with, "timeout" in milliseconds and "workers"
+   * @throws invalid_argument if the endpoint isn't loaded, a parameter is
+   * unknown or out of range or the worker count of an autoscaled endpoint is
+   * set. Nothing is changed in that case
+   */
+  void configure(const std::string& endpoint, const std::string& version,
+                 ParameterMap parameters);
 
   void infer(const std::string& endpoint,
              std::unique_ptr<RequestContainer> request,
              const std::string& version) const;
+  /**
+   * @brief Send a request to the endpoint identified by the handle. If the
+   * handle is stale, it's first resolved again by name.
+   *
+   * @param handle the handle to use and to update if it's stale
+   * @param request the request to send
+   * @throws invalid_argument if the endpoint no longer exists
+   */
+  void infer(EndpointHandle* handle,
+             std::unique_ptr<RequestContainer> request) const;
+  /**
+   * @brief Check if a request from a client is within an endpoint's rate
+   * limits. This is cheap so servers can reject requests before decoding them.
+   *
+   * @param endpoint name of the endpoint
+   * @param version version of the endpoint. Empty for the default
+   * @param client the identity of the client. May be empty
+   * @return bool true if the request is admitted or the endpoint isn't loaded,
+   * in which case sending the request reports the error as usual
+   */
+  bool admit(const std::string& endpoint, const std::string& version,
+             const std::string& client) const;
+  /**
+   * @brief Resolve a model and version to a handle to its endpoint
+   *
+   * @param endpoint name of the endpoint
+   * @param version version of the endpoint. Empty for the default
+   * @return EndpointHandle
+   * @throws invalid_argument if the endpoint doesn't exist
+   */
+  [[nodiscard]] EndpointHandle resolve(const std::string& endpoint,
+                                       const std::string& version) const;
 
-  bool exists(const std::string& endpoint);
-  // WorkerInfo* get(const std::string& endpoint);
-  bool ready(const std::string& endpoint, const std::string& version);
+  bool exists(const std::string& endpoint) const;
+  bool ready(const std::string& endpoint, const std::string& version) const;
+  /**
+   * @brief Get the status of an endpoint without waiting for any loads that
+   * are in progress
+   *
+   * @param endpoint name of the endpoint
+   * @param version version of the endpoint. Empty for the default
+   * @return EndpointStatus
+   * @throws invalid_argument if the endpoint is unknown
+   */
+  [[nodiscard]] EndpointStatus state(const std::string& endpoint,
+                                     const std::string& version) const;
 
-  std::vector<std::string> list();
+  std::vector<std::string> list() const;
   ModelMetadata metadata(const std::string& endpoint,
                          const std::string& version);
 
   const MemoryPool* getPool() const;
 
+  /**
+   * @brief Set the byte budget shared by the cached responses of all the
+   * endpoints loaded with the "response_cache" parameter set
+   *
+   * @param max_bytes the byte budget. Zero disables response caching
+   */
+  void setResponseCacheSize(size_t max_bytes);
+
   void shutdown();
 
  private:
@@ -114,12 +286,54 @@ class Endpoints {
   std::unordered_map<std::string, int> worker_indices_;
   // endpoint -> parameters
   std::unordered_map<std::string, ParameterMap> worker_parameters_;
-  // endpoint -> Worker_Info*
-  std::unordered_map<std::string, std::unique_ptr<WorkerInfo>> workers_;
+  /// The endpoints as seen by the update thread, which is the only writer
+  EndpointTable workers_;
+  /// Source of generations, shared by all instances so handles are unique
+  inline static std::atomic<uint64_t> generation_ = 0;
+  /**
+   * @brief An immutable copy of workers_ for the data path. The update thread
+   * publishes a new copy whenever an endpoint is added or removed so lookups
+   * don't wait on the update thread. Accessed with the atomic shared_ptr
+   * functions. Requests hold a reference to the WorkerInfo they're sent to so
+   * it isn't destroyed while they're being enqueued.
+   */
+  std::shared_ptr<const EndpointTable> snapshot_;
+  /// The snapshots the data path holds. Each one releases itself when freed
+  std::shared_ptr<SnapshotTracker> snapshots_ =
+    std::make_shared<SnapshotTracker>();
+  /// Endpoints with a load in progress in load_pool_
+  std::unordered_set<std::string> busy_;
+  /// endpoint -> commands waiting for its load to finish, in arrival order
+  std::unordered_map<std::string, std::vector<std::shared_ptr<UpdateCommand>>>
+    deferred_;
   /// A queue used to sequentially order changes to the Manager state
   UpdateCommandQueue update_queue_;
   std::thread update_thread_;
   MemoryPool pool_;
+  /**
+   * @brief Runs the slow part of loads so the update thread can keep
+   * serving commands for other endpoints. Finished loads come back to the
+   * update thread as LoadDone commands.
+   */
+  util::ThreadPool load_pool_{kLoadThreads};
+  /// Decides when autoscaled endpoints gain and lose workers
+  Autoscaler autoscaler_;
+  /// Responses of the endpoints that cache them, invalidated as they unload
+  std::shared_ptr<ResponseCache> response_cache_ =
+    std::make_shared<ResponseCache>(kDefaultResponseCacheSize);
+  /// Periodically asks the update thread to sample the autoscaled endpoints
+  std::thread autoscale_thread_;
+  std::mutex autoscale_mutex_;
+  std::condition_variable autoscale_cv_;
+  bool autoscale_stop_ = false;
+  /**
+   * @brief Worker groups replaced by swaps, in the order to drain them, with
+   * the sequence number of the snapshot that replaced them. The drain thread
+   * waits for the data path to let go of the older snapshots on its own so
+   * slow drains don't hold up loads. A nullptr stops the thread.
+   */
+  BlockingQueue<std::pair<std::shared_ptr<WorkerInfo>, uint64_t>> drain_queue_;
+  std::thread drain_thread_;
 #ifdef AMDINFER_ENABLE_LOGGING
   Logger logger_{Loggers::Server};
 #endif
@@ -133,17 +347,87 @@ class Endpoints {
    * @param input_queue queue where update requests will arrive
    */
   void updateManager(UpdateCommandQueue* input_queue);
+  /**
+   * @brief Resolve a model and version to a handle to its endpoint in a
+   * snapshot so the handle can index the same snapshot
+   *
+   * @param table the snapshot to look in
+   * @param endpoint name of the endpoint
+   * @param version version of the endpoint. Empty for the default
+   * @return EndpointHandle
+   * @throws invalid_argument if the endpoint doesn't exist
+   */
+  static EndpointHandle resolve(const EndpointTable& table,
+                                const std::string& endpoint,
+                                const std::string& version);
+  /**
+   * @brief Run one command on the update thread. Commands that finish here
+   * have their promise fulfilled. Loads that are handed to the load pool, and
+   * commands deferred behind them, are fulfilled later.
+   *
+   * @param request the command to run
+   * @return bool false if the update thread should stop
+   */
+  bool unsafeProcess(const std::shared_ptr<UpdateCommand>& request);
+  /// Defer a command if its endpoint is loading. Returns true if deferred
+  bool unsafeDefer(const std::string& endpoint,
+                   const std::shared_ptr<UpdateCommand>& request);
+  /**
+   * @brief Send a command to the update thread and block until it completes.
+   *
+   * @param request the command to send
+   * @param timeout how long to wait for the command to complete
+   * @throws runtime_error if the command does not complete in time
+   * @throws any exception raised by the command
+   */
+  void submit(const std::shared_ptr<UpdateCommand>& request,
+              std::chrono::seconds timeout);
   std::string insertWorker(const std::string& worker,
                            const ParameterMap& parameters);
 
-  std::string unsafeLoad(const std::string& worker, ParameterMap* parameters);
+  /// Start a load. Returns true if it finished without using the load pool
+  bool unsafeLoad(const std::shared_ptr<UpdateCommand>& request);
+  /// Finish a load from the load pool and run the commands deferred behind it
+  void unsafeFinishLoad(const UpdateCommand& command);
+  /// Start a swap. The new workers are always created in the load pool
+  void unsafeSwap(const std::shared_ptr<UpdateCommand>& request);
+  /// Redirect the endpoints to the new workers and drain the old ones
+  void unsafeFinishSwap(const UpdateCommand& command);
+  /// Run the commands that were waiting for the endpoint to stop being busy
+  void unsafeReplay(const std::string& endpoint);
+  /// Start a configuration change. Returns true if it finished already
+  bool unsafeConfigure(const std::shared_ptr<UpdateCommand>& request);
+  /// Send Autoscale commands to the update thread until shutdown
+  void autoscaleTimer();
+  /// Drain the worker groups sent to drain_queue_ until shutdown
+  void drainManager();
+  /// Sample the autoscaled endpoints and start the changes they need
+  void unsafeAutoscale();
+  /**
+   * @brief Add or retire workers in the load pool. It finishes with a LoadDone
+   * that fulfils the request.
+   *
+   * @param request the command to fulfil once the workers have changed
+   * @param worker the endpoint's worker group
+   * @param change the number of workers to add or, if negative, to retire
+   */
+  void unsafeScale(const std::shared_ptr<UpdateCommand>& request,
+                   WorkerInfo* worker, int change);
   void unsafeUnload(const std::string& endpoint);
 
-  bool unsafeExists(const std::string& endpoint) const;
   WorkerInfo* unsafeGet(const std::string& endpoint) const;
-  // bool unsafeReady(const std::string& endpoint) const;
-
-  void unsafeList(std::vector<std::string>* list) const;
+  /// Add a new endpoint to workers_ and publish it
+  void unsafeInsert(const std::string& endpoint,
+                    std::shared_ptr<WorkerInfo> worker);
+  /// Remove an endpoint, if it exists, from workers_ and publish the change
+  void unsafeErase(const std::string& endpoint);
+  void unsafeSetState(const std::string& endpoint, EndpointStatus status);
+  /**
+   * @brief Publish the current workers_ for the data path to read
+   *
+   * @return uint64_t the sequence number of the new snapshot
+   */
+  uint64_t unsafePublish();
   ModelMetadata unsafeMetadata(const std::string& endpoint) const;
 
   void unsafeShutdown();
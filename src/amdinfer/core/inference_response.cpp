@@ -33,11 +33,15 @@ InferenceResponse::InferenceResponse(const std::string &error_msg) {
 
 void InferenceResponse::setID(const std::string &id) { this->id_ = id; }
 
+void InferenceResponse::setParameters(ParameterMap parameters) {
+  this->parameters_ = std::make_shared<ParameterMap>(std::move(parameters));
+}
+
 void InferenceResponse::setModel(const std::string &model) {
   this->model_ = model;
 }
 
-std::string InferenceResponse::getModel() { return this->model_; }
+std::string InferenceResponse::getModel() const { return this->model_; }
 
 bool InferenceResponse::isError() const { return !this->error_msg_.empty(); }
 
@@ -47,7 +51,8 @@ void InferenceResponse::addOutput(const InferenceResponseOutput &output) {
   this->outputs_.push_back(output);
 }
 
-std::vector<InferenceResponseOutput> InferenceResponse::getOutputs() const {
+const std::vector<InferenceResponseOutput> &InferenceResponse::getOutputs()
+  const {
   return this->outputs_;
 }
 
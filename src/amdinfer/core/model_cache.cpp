@@ -0,0 +1,317 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements the cache that loads models from the repository on demand
+ */
+
+#include "amdinfer/core/model_cache.hpp"
+
+#include <exception>  // for exception
+#include <memory>     // for atomic_load, atomic_store, make_shared
+#include <utility>    // for move
+
+#include "amdinfer/build_options.hpp"           // for kLoadThreads
+#include "amdinfer/core/endpoint_handle.hpp"    // for EndpointHandle
+#include "amdinfer/core/endpoints.hpp"          // for Endpoints
+#include "amdinfer/core/exceptions.hpp"         // for invalid_argument
+#include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
+#include "amdinfer/core/request_container.hpp"  // for RequestContainer
+#include "amdinfer/core/versioned_endpoint.hpp"  // for getVersionedEndpoint
+#include "amdinfer/observation/logging.hpp"      // for Logger
+#include "amdinfer/observation/metrics.hpp"      // for Metrics
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+namespace {
+
+/// Size of all the files in a directory. Used to estimate a model's footprint
+size_t directorySize(const fs::path& path) {
+  size_t bytes = 0;
+  std::error_code error;
+  for (const auto& entry : fs::recursive_directory_iterator(path, error)) {
+    if (entry.is_regular_file(error)) {
+      bytes += entry.file_size(error);
+    }
+  }
+  return bytes;
+}
+
+}  // namespace
+
+ModelCache::ModelCache(Endpoints* endpoints, Loader loader)
+  : endpoints_(endpoints), loader_(std::move(loader)), pool_(kLoadThreads) {}
+
+void ModelCache::enable(const fs::path& repository, size_t max_models,
+                        size_t max_bytes) {
+  const std::lock_guard lock{mutex_};
+  repository_ = repository;
+  max_models_ = max_models;
+  max_bytes_ = max_bytes;
+  enabled_ = true;
+}
+
+bool ModelCache::enabled() const { return enabled_; }
+
+void ModelCache::infer(const std::string& model,
+                       std::unique_ptr<RequestContainer> request,
+                       const std::string& version) {
+  const auto endpoint = getVersionedEndpoint(model, version);
+  // endpoints the cache doesn't manage go straight to their workers
+  const auto managed = std::atomic_load(&managed_);
+  if (managed->find(endpoint) == managed->end() &&
+      endpoints_->exists(endpoint)) {
+    endpoints_->infer(model, std::move(request), version);
+    return;
+  }
+
+  std::unique_lock lock{mutex_};
+
+  auto iterator = entries_.find(endpoint);
+  if (iterator == entries_.end() || iterator->second.state == State::Ready) {
+    EndpointHandle handle;
+    bool loaded = true;
+    try {
+      handle = endpoints_->resolve(model, version);
+    } catch (const invalid_argument&) {
+      loaded = false;
+    }
+
+    if (loaded) {
+      if (iterator != entries_.end()) {
+        iterator->second.last_used = ++clock_;
+        track(&iterator->second, request.get());
+#ifdef AMDINFER_ENABLE_METRICS
+        Metrics::getInstance().incrementCounter(
+          MetricCounterIDs::ModelCacheHits);
+#endif
+      }
+      lock.unlock();
+      endpoints_->infer(&handle, std::move(request));
+      return;
+    }
+
+    if (iterator != entries_.end()) {
+      // the model was unloaded outside the cache so forget about it
+      bytes_ -= iterator->second.bytes;
+      ready_--;
+      entries_.erase(iterator);
+      this->publish();
+    }
+    if (!fs::is_directory(repository_ / model)) {
+      throw invalid_argument("Worker " + endpoint + " not found");
+    }
+    iterator = entries_.try_emplace(endpoint).first;
+    iterator->second.model = model;
+    iterator->second.version = version;
+    this->publish();
+    pool_.push([this, model, version, endpoint](int) {
+      this->load(model, version, endpoint);
+    });
+#ifdef AMDINFER_ENABLE_METRICS
+    Metrics::getInstance().incrementCounter(MetricCounterIDs::ModelCacheMisses);
+#endif
+  }
+
+  iterator->second.pending.push_back(std::move(request));
+}
+
+void ModelCache::load(const std::string& model, const std::string& version,
+                      const std::string& endpoint) {
+  AMDINFER_IF_LOGGING(Logger logger{Loggers::Server};)
+  AMDINFER_LOG_INFO(logger, "Loading " + endpoint + " on demand");
+
+  std::vector<std::string> endpoints;
+  std::string error;
+  try {
+    endpoints = loader_(model, version);
+  } catch (const std::exception& e) {
+    error = e.what();
+  }
+  const auto bytes = directorySize(repository_ / model);
+
+  std::vector<std::unique_ptr<RequestContainer>> pending;
+  std::vector<std::string> evicted;
+  {
+    const std::lock_guard lock{mutex_};
+    auto& entry = entries_.at(endpoint);
+    pending = std::move(entry.pending);
+    if (!error.empty()) {
+      // the next request for the model tries to load it again
+      entries_.erase(endpoint);
+      this->publish();
+    } else {
+      entry.state = State::Ready;
+      entry.endpoints = std::move(endpoints);
+      entry.bytes = bytes;
+      entry.last_used = ++clock_;
+      for (const auto& request : pending) {
+        track(&entry, request.get());
+      }
+      bytes_ += bytes;
+      ready_++;
+      evicted = this->evict(endpoint);
+    }
+    this->updateMetrics();
+  }
+
+  if (!error.empty()) {
+    AMDINFER_LOG_INFO(logger, "Failed to load " + endpoint + ": " + error);
+    for (const auto& request : pending) {
+      request->request->runCallbackError("Failed to load " + endpoint + ": " +
+                                         error);
+    }
+  } else {
+    for (auto& request : pending) {
+      auto inference_request = request->request;
+      try {
+        endpoints_->infer(model, std::move(request), version);
+      } catch (const invalid_argument& e) {
+        // the model was unloaded as soon as it was loaded
+        inference_request->runCallbackError(e.what());
+      }
+    }
+  }
+
+  for (const auto& evicted_endpoint : evicted) {
+    this->unload(evicted_endpoint);
+  }
+}
+
+void ModelCache::unload(const std::string& endpoint) {
+  AMDINFER_IF_LOGGING(Logger logger{Loggers::Server};)
+  std::vector<std::string> endpoints;
+  {
+    const std::lock_guard lock{mutex_};
+    endpoints = entries_.at(endpoint).endpoints;
+  }
+  for (const auto& evicted : endpoints) {
+    AMDINFER_LOG_INFO(logger, "Evicting " + evicted);
+    try {
+      endpoints_->unloadAndWait(evicted, "");
+    } catch (const std::exception& e) {
+      AMDINFER_LOG_INFO(logger,
+                        "Failed to unload " + evicted + ": " + e.what());
+    }
+  }
+
+  const std::lock_guard lock{mutex_};
+  auto iterator = entries_.find(endpoint);
+  auto& entry = iterator->second;
+  if (entry.pending.empty()) {
+    entries_.erase(iterator);
+    this->publish();
+    return;
+  }
+  // requests arrived while the model was being unloaded so load it again
+  entry.state = State::Loading;
+  pool_.push([this, model = entry.model, version = entry.version,
+              endpoint](int) { this->load(model, version, endpoint); });
+}
+
+void ModelCache::track(Entry* entry, RequestContainer* request) {
+  // released once, when the response is sent or if the request is destroyed
+  // without one
+  class InFlight {
+   public:
+    explicit InFlight(std::shared_ptr<std::atomic<int>> count)
+      : count_(std::move(count)) {
+      ++(*count_);
+    }
+    InFlight(const InFlight&) = delete;
+    InFlight& operator=(const InFlight&) = delete;
+    InFlight(InFlight&&) = delete;
+    InFlight& operator=(InFlight&&) = delete;
+    ~InFlight() { this->release(); }
+    void release() {
+      if (!released_.exchange(true)) {
+        --(*count_);
+      }
+    }
+
+   private:
+    std::shared_ptr<std::atomic<int>> count_;
+    std::atomic_bool released_ = false;
+  };
+
+  auto token = std::make_shared<InFlight>(entry->in_flight);
+  auto callback = request->request->getCallback();
+  request->request->setCallback(
+    [token, callback = std::move(callback)](const InferenceResponse& response) {
+      // the model is idle once the response is on its way
+      token->release();
+      callback(response);
+    });
+}
+
+std::vector<std::string> ModelCache::evict(const std::string& keep) {
+  std::vector<std::string> evicted;
+  auto over_budget = [this]() {
+    return (max_models_ > 0 && ready_ > max_models_) ||
+           (max_bytes_ > 0 && bytes_ > max_bytes_);
+  };
+  while (over_budget()) {
+    auto victim = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      const auto& entry = it->second;
+      if (it->first == keep || entry.state != State::Ready ||
+          *entry.in_flight > 0) {
+        continue;
+      }
+      if (victim == entries_.end() ||
+          entry.last_used < victim->second.last_used) {
+        victim = it;
+      }
+    }
+    if (victim == entries_.end()) {
+      // everything else is busy. Try again after the next load
+      break;
+    }
+    // requests that arrive before it's unloaded wait for it to load again
+    victim->second.state = State::Evicting;
+    evicted.push_back(victim->first);
+    bytes_ -= victim->second.bytes;
+    ready_--;
+#ifdef AMDINFER_ENABLE_METRICS
+    Metrics::getInstance().incrementCounter(
+      MetricCounterIDs::ModelCacheEvictions);
+#endif
+  }
+  return evicted;
+}
+
+void ModelCache::publish() {
+  std::unordered_set<std::string> managed;
+  for (const auto& [endpoint, _] : entries_) {
+    managed.insert(endpoint);
+  }
+  std::atomic_store(&managed_,
+                    std::make_shared<const std::unordered_set<std::string>>(
+                      std::move(managed)));
+}
+
+void ModelCache::updateMetrics() const {
+#ifdef AMDINFER_ENABLE_METRICS
+  auto& metrics = Metrics::getInstance();
+  metrics.setGauge(MetricGaugeIDs::ModelCacheModels,
+                   static_cast<double>(ready_));
+  metrics.setGauge(MetricGaugeIDs::ModelCacheBytes,
+                   static_cast<double>(bytes_));
+#endif
+}
+
+}  // namespace amdinfer
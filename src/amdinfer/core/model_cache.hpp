@@ -0,0 +1,160 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines the cache that loads models from the repository on demand
+ */
+
+#ifndef GUARD_AMDINFER_CORE_MODEL_CACHE
+#define GUARD_AMDINFER_CORE_MODEL_CACHE
+
+#include <atomic>         // for atomic
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
+#include <filesystem>     // for path
+#include <functional>     // for function
+#include <memory>         // for unique_ptr, shared_ptr
+#include <mutex>          // for mutex
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <unordered_set>  // for unordered_set
+#include <vector>         // for vector
+
+#include "amdinfer/util/ctpl.hpp"  // for ThreadPool
+
+namespace amdinfer {
+
+class Endpoints;
+class RequestContainer;
+
+/**
+ * @brief Loads models from the model repository on the first request that
+ * targets them and unloads the least recently used idle ones when the loaded
+ * models exceed a budget. Requests that arrive while a model is loading are
+ * queued and sent once it's ready. Only models loaded by the cache are
+ * evicted, and never while they have requests in flight. Requests that arrive
+ * while a model is being evicted wait for it to be loaded again.
+ */
+class ModelCache {
+ public:
+  /// Loads a model and returns the endpoints it created
+  using Loader = std::function<std::vector<std::string>(
+    const std::string& model, const std::string& version)>;
+
+  ModelCache(Endpoints* endpoints, Loader loader);
+
+  /**
+   * @brief Start loading models on demand from the repository
+   *
+   * @param repository path to the model repository
+   * @param max_models evict idle models once more than this many are loaded
+   * by the cache. Zero means no limit
+   * @param max_bytes evict idle models once the size of the loaded models'
+   * files exceeds this many bytes. Zero means no limit
+   */
+  void enable(const std::filesystem::path& repository, size_t max_models,
+              size_t max_bytes);
+  [[nodiscard]] bool enabled() const;
+
+  /**
+   * @brief Send a request to a model, loading it first if needed
+   *
+   * @param model name of the model
+   * @param request the request to send
+   * @param version version of the model. Empty for the default
+   * @throws invalid_argument if the model isn't loaded or in the repository
+   */
+  void infer(const std::string& model,
+             std::unique_ptr<RequestContainer> request,
+             const std::string& version);
+
+ private:
+  enum class State {
+    Loading,
+    Ready,
+    /// Chosen for eviction but its endpoints may not be unloaded yet
+    Evicting,
+  };
+
+  struct Entry {
+    State state = State::Loading;
+    std::string model;
+    std::string version;
+    /// Endpoints created by loading the model, to unload on eviction
+    std::vector<std::string> endpoints;
+    /// Size of the model's files in the repository
+    size_t bytes = 0;
+    /// Value of clock_ when the model was last used
+    uint64_t last_used = 0;
+    /// Requests sent to the model that haven't been destroyed yet
+    std::shared_ptr<std::atomic<int>> in_flight =
+      std::make_shared<std::atomic<int>>(0);
+    /// Requests waiting for the model to load
+    std::vector<std::unique_ptr<RequestContainer>> pending;
+  };
+
+  /// Load a model in the pool and then send its pending requests
+  void load(const std::string& model, const std::string& version,
+            const std::string& endpoint);
+  /**
+   * @brief Unload the endpoints of an evicted entry and then forget it or, if
+   * requests arrived in the meantime, load it again for them
+   *
+   * @param endpoint the evicted entry
+   */
+  void unload(const std::string& endpoint);
+  /// Count the request as in flight to the entry until it's destroyed
+  static void track(Entry* entry, RequestContainer* request);
+  /**
+   * @brief Mark least recently used idle entries as evicting until the cache
+   * is within its budget. Must be called with mutex_ held.
+   *
+   * @param keep an endpoint that must not be evicted
+   * @return std::vector<std::string> the entries to unload
+   */
+  std::vector<std::string> evict(const std::string& keep);
+  /// Publish the endpoints the cache manages. Must be called with mutex_ held
+  void publish();
+  void updateMetrics() const;
+
+  Endpoints* endpoints_;
+  Loader loader_;
+  std::filesystem::path repository_;
+  size_t max_models_ = 0;
+  size_t max_bytes_ = 0;
+  std::atomic_bool enabled_ = false;
+
+  std::mutex mutex_;
+  /// versioned endpoint -> entry
+  std::unordered_map<std::string, Entry> entries_;
+  /**
+   * @brief An immutable copy of the keys of entries_ so requests to endpoints
+   * the cache doesn't manage skip mutex_. Accessed with the atomic shared_ptr
+   * functions.
+   */
+  std::shared_ptr<const std::unordered_set<std::string>> managed_ =
+    std::make_shared<const std::unordered_set<std::string>>();
+  /// Total size of the ready entries
+  size_t bytes_ = 0;
+  /// Number of the ready entries
+  size_t ready_ = 0;
+  uint64_t clock_ = 0;
+
+  util::ThreadPool pool_;
+};
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_CORE_MODEL_CACHE
@@ -49,6 +49,8 @@ std::string extractString(const toml::table& table, const std::string& key,
 
 ModelConfigTensor extractModelConfigTensor(const toml::table& table);
 ModelConfigData extractConfig(const toml::table& table, bool is_ensemble);
+ModelConfigWarmup extractWarmup(const toml::table& table);
+ModelConfigAutotune extractAutotune(const toml::table& table);
 
 // if we're not explicitly handling the types, use this to catch the failure at
 // compile time
@@ -121,7 +123,64 @@ ModelConfigData extractConfig(const toml::table& table, bool is_ensemble) {
   auto inputs = extractArray<ModelConfigTensor>(table, "inputs");
   auto outputs = extractArray<ModelConfigTensor>(table, "outputs");
 
-  return {name, platform, id, inputs, outputs};
+  ModelConfigWarmup warmup;
+  if (table.contains("warmup")) {
+    const auto* warmup_table = table.at("warmup").as_table();
+    if (warmup_table == nullptr) {
+      throw invalid_argument("warmup must be a table");
+    }
+    warmup = extractWarmup(*warmup_table);
+  }
+
+  ModelConfigAutotune autotune;
+  if (table.contains("autotune")) {
+    const auto* autotune_table = table.at("autotune").as_table();
+    if (autotune_table == nullptr) {
+      throw invalid_argument("autotune must be a table");
+    }
+    autotune = extractAutotune(*autotune_table);
+  }
+
+  return {name, platform, id, inputs, outputs, warmup, autotune};
+}
+
+ModelConfigWarmup extractWarmup(const toml::table& table) {
+  ModelConfigWarmup warmup;
+  warmup.batch_sizes = extractArray<int64_t>(table, "batch_sizes");
+  if (table.contains("count")) {
+    const auto count = table.at("count").value<int64_t>();
+    if (!count) {
+      throw invalid_argument("count must be an integer");
+    }
+    warmup.count = count.value();
+  }
+  if (table.contains("data")) {
+    warmup.data = extractString(table, "data", true);
+  }
+  return warmup;
+}
+
+ModelConfigAutotune extractAutotune(const toml::table& table) {
+  ModelConfigAutotune autotune;
+  if (!table.contains("latency")) {
+    throw invalid_argument("The configuration must have a latency");
+  }
+  const auto latency = table.at("latency").value<double>();
+  if (!latency) {
+    throw invalid_argument("latency must be a number");
+  }
+  autotune.latency = latency.value();
+  if (table.contains("batch_sizes")) {
+    autotune.batch_sizes = extractArray<int64_t>(table, "batch_sizes");
+  }
+  if (table.contains("rounds")) {
+    const auto rounds = table.at("rounds").value<int64_t>();
+    if (!rounds) {
+      throw invalid_argument("rounds must be an integer");
+    }
+    autotune.rounds = rounds.value();
+  }
+  return autotune;
 }
 
 ModelConfigTensor::ModelConfigTensor(std::string name,
@@ -176,6 +235,42 @@ void ModelConfig::createModels() {
     } else {
       throw invalid_argument("Unknown platform: " + config.platform);
     }
+
+    const auto& warmup = config.warmup;
+    if (!warmup.batch_sizes.empty()) {
+      std::string batch_sizes;
+      for (const auto& batch_size : warmup.batch_sizes) {
+        if (batch_size <= 0) {
+          throw invalid_argument("Warmup batch sizes must be positive");
+        }
+        batch_sizes += (batch_sizes.empty() ? "" : ",") +
+                       std::to_string(batch_size);
+      }
+      parameters.put("warmup_batch_sizes", batch_sizes);
+      parameters.put("warmup_count", static_cast<int>(warmup.count));
+      parameters.put("warmup_data", warmup.data);
+    }
+
+    const auto& autotune = config.autotune;
+    if (autotune.latency > 0) {
+      std::string batch_sizes;
+      for (const auto& batch_size : autotune.batch_sizes) {
+        if (batch_size <= 0) {
+          throw invalid_argument("Autotune batch sizes must be positive");
+        }
+        batch_sizes += (batch_sizes.empty() ? "" : ",") +
+                       std::to_string(batch_size);
+      }
+      if (batch_sizes.empty() || autotune.rounds <= 0) {
+        throw invalid_argument(
+          "Autotune needs at least one batch size and round");
+      }
+      parameters.put("autotune_latency", autotune.latency);
+      parameters.put("autotune_batch_sizes", batch_sizes);
+      parameters.put("autotune_rounds", static_cast<int>(autotune.rounds));
+    } else if (autotune.latency < 0) {
+      throw invalid_argument("The autotune latency must be positive");
+    }
   }
 
   // assuming a static chain for now so define it in reverse order
@@ -240,8 +335,34 @@ ModelConfig::ModelConfig(const inference::Config& config,
     outputs.emplace_back(name, shape, datatype, id);
   }
 
+  ModelConfigWarmup warmup;
+  if (config.has_warmup()) {
+    const auto& proto_warmup = config.warmup();
+    warmup.batch_sizes = {proto_warmup.batch_sizes().begin(),
+                          proto_warmup.batch_sizes().end()};
+    if (proto_warmup.count() > 0) {
+      warmup.count = proto_warmup.count();
+    }
+    if (!proto_warmup.data().empty()) {
+      warmup.data = proto_warmup.data();
+    }
+  }
+
+  ModelConfigAutotune autotune;
+  if (config.has_autotune()) {
+    const auto& proto_autotune = config.autotune();
+    autotune.latency = proto_autotune.latency();
+    if (!proto_autotune.batch_sizes().empty()) {
+      autotune.batch_sizes = {proto_autotune.batch_sizes().begin(),
+                              proto_autotune.batch_sizes().end()};
+    }
+    if (proto_autotune.rounds() > 0) {
+      autotune.rounds = proto_autotune.rounds();
+    }
+  }
+
   configs_.emplace_back(getVersionedEndpoint(model_name, version), platform, id,
-                        inputs, outputs);
+                        inputs, outputs, warmup, autotune);
 
   this->createModels();
 }
@@ -256,6 +377,19 @@ void ModelConfig::setModelFiles(const std::filesystem::path& base_path) {
     } else {
       parameters.put("model", (base_path / config.id).string());
     }
+    // warmup data in files is relative to the model files
+    if (parameters.has("warmup_data")) {
+      const auto data = parameters.get<std::string>("warmup_data");
+      if (data != "zeros" && data != "random") {
+        parameters.put("warmup_data", (base_path / data).string());
+      }
+    }
+    // the profiling results are saved next to the configuration file
+    if (parameters.has("autotune_latency")) {
+      const auto cache = base_path.parent_path() /
+                         ("autotune_" + config.name + ".toml");
+      parameters.put("autotune_cache", cache.string());
+    }
     i++;
   }
 }
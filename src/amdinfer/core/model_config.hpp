@@ -52,21 +52,44 @@ class ModelConfigTensor : public Tensor {
   std::string id_;
 };
 
+/// Requests sent to a model as it loads. There are none if batch_sizes is empty
+struct ModelConfigWarmup {
+  std::vector<int64_t> batch_sizes;
+  int64_t count = 1;
+  /// "zeros", "random" or a directory of raw <input name>.bin files
+  std::string data = "zeros";
+};
+
+/// Profiling that picks the batch size and timeout. It's off if latency is 0
+struct ModelConfigAutotune {
+  /// the target 99th percentile latency in milliseconds
+  double latency = 0;
+  std::vector<int64_t> batch_sizes{1, 2, 4, 8, 16, 32};
+  /// the number of batches to time for each batch size
+  int64_t rounds = 5;
+};
+
 struct ModelConfigData {
   ModelConfigData(std::string name, std::string platform, std::string id,
                   std::vector<ModelConfigTensor> inputs,
-                  std::vector<ModelConfigTensor> outputs)
+                  std::vector<ModelConfigTensor> outputs,
+                  ModelConfigWarmup warmup = {},
+                  ModelConfigAutotune autotune = {})
     : name(std::move(name)),
       platform(std::move(platform)),
       id(std::move(id)),
       inputs(std::move(inputs)),
-      outputs(std::move(outputs)) {}
+      outputs(std::move(outputs)),
+      warmup(std::move(warmup)),
+      autotune(std::move(autotune)) {}
 
   std::string name;
   std::string platform;
   std::string id;
   std::vector<ModelConfigTensor> inputs;
   std::vector<ModelConfigTensor> outputs;
+  ModelConfigWarmup warmup;
+  ModelConfigAutotune autotune;
 };
 
 class ModelConfig {
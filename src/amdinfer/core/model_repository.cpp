@@ -23,13 +23,18 @@
 
 #include <chrono>      // for milliseconds
 #include <filesystem>  // for path, operator/
+#include <future>      // for future
 #include <thread>      // for sleep_for
+#include <utility>     // for move, pair
+#include <vector>      // for vector
 
+#include "amdinfer/build_options.hpp"        // for kLoadThreads
 #include "amdinfer/core/endpoints.hpp"       // for Endpoints
 #include "amdinfer/core/exceptions.hpp"      // for runtime_error
 #include "amdinfer/core/model_config.hpp"    // for ModelConfig
 #include "amdinfer/core/parameters.hpp"      // for ParameterMap
 #include "amdinfer/observation/logging.hpp"  // for AMDINFER_LOG_D...
+#include "amdinfer/util/ctpl.hpp"            // for ThreadPool
 #include "amdinfer/util/filesystem.hpp"      // for findFile
 #include "amdinfer/util/string.hpp"          // for endsWith
 #include "model_config.hpp"                  // for ModelConfig
@@ -148,20 +153,38 @@ void loadModel(const fs::path& repository, const fs::path& model_name,
   }
 }
 
+void swapModel(const fs::path& repository, const fs::path& model_name,
+               Endpoints* endpoints) {
+  auto config = parseModel(repository, model_name, "");
+  std::vector<std::pair<std::string, ParameterMap>> stages{config.begin(),
+                                                           config.end()};
+  endpoints->swap(std::move(stages));
+}
+
 void ModelRepository::setRepository(const fs::path& repository_path,
                                     bool load_existing) {
   repository_ = repository_path;
   if (fs::exists(repository_path) && load_existing) {
     AMDINFER_IF_LOGGING(Logger logger{Loggers::Server};)
+    // the models are independent so load them in parallel. Startup then takes
+    // about as long as the slowest model instead of the sum of all of them
+    util::ThreadPool pool{kLoadThreads};
+    std::vector<std::pair<fs::path, std::future<void>>> loads;
     for (const auto& path : fs::directory_iterator(repository_)) {
       if (path.is_directory()) {
         auto model_name = path.path().filename();
-        try {
+        auto future = pool.push([this, model_name](int) {
           loadModel(repository_, model_name, endpoints_);
-        } catch (const amdinfer::runtime_error& e) {
-          AMDINFER_LOG_INFO(
-            logger, "Error loading " + model_name.string() + ": " + e.what());
-        }
+        });
+        loads.emplace_back(model_name, std::move(future));
+      }
+    }
+    for (auto& [model_name, future] : loads) {
+      try {
+        future.get();
+      } catch (const amdinfer::runtime_error& e) {
+        AMDINFER_LOG_INFO(
+          logger, "Error loading " + model_name.string() + ": " + e.what());
       }
     }
   }
@@ -196,6 +219,17 @@ void UpdateListener::handleFileAction(
       } catch (const runtime_error&) {
         AMDINFER_LOG_INFO(logger, "Error loading " + model_name.string());
       }
+    } else if (action == efsw::Actions::Modified) {
+      std::this_thread::sleep_for(delay);
+      auto model_name = fs::path(dir).parent_path().filename();
+      // a changed config replaces the loaded model without dropping requests
+      if (endpoints_->exists(model_name.string())) {
+        try {
+          swapModel(repository_, model_name, endpoints_);
+        } catch (const runtime_error&) {
+          AMDINFER_LOG_INFO(logger, "Error swapping " + model_name.string());
+        }
+      }
     } else if (action == efsw::Actions::Delete) {
       // arbitrary delay to make sure filesystem has settled
       std::this_thread::sleep_for(delay);
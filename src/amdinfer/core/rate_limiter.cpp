@@ -0,0 +1,137 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements the token-bucket rate limits of a model
+ */
+
+#include "amdinfer/core/rate_limiter.hpp"
+
+#include <algorithm>  // for min, max
+#include <cstdint>    // for int32_t
+#include <iterator>   // for next
+#include <string>     // for string, operator+
+#include <variant>    // for bad_variant_access
+
+#include "amdinfer/core/exceptions.hpp"  // for invalid_argument
+#include "amdinfer/core/parameters.hpp"  // for ParameterMap
+
+namespace amdinfer {
+
+namespace {
+
+/// Forget idle clients only once there are at least this many
+constexpr size_t kMinSweep = 1024;
+
+/// Get a rate, which may be given as an integer or a floating-point number
+double getRate(const ParameterMap& parameters, const std::string& key,
+               double fallback) {
+  if (!parameters.has(key)) {
+    return fallback;
+  }
+  double rate = 0;
+  try {
+    rate = parameters.get<double>(key);
+  } catch (const std::bad_variant_access&) {
+    try {
+      rate = parameters.get<int32_t>(key);
+    } catch (const std::bad_variant_access&) {
+      throw invalid_argument("The " + key + " parameter must be a number");
+    }
+  }
+  if (rate < 0) {
+    throw invalid_argument("The " + key + " parameter can't be negative");
+  }
+  return rate;
+}
+
+}  // namespace
+
+TokenBucket::TokenBucket(double rate, double burst, Clock::time_point now)
+  : rate_(rate), burst_(burst), tokens_(burst), last_(now) {}
+
+void TokenBucket::refill(Clock::time_point now) {
+  const std::chrono::duration<double> elapsed = now - last_;
+  tokens_ = std::min(burst_, tokens_ + elapsed.count() * rate_);
+  last_ = now;
+}
+
+bool TokenBucket::ready() const { return tokens_ >= 1; }
+
+bool TokenBucket::full() const { return tokens_ >= burst_; }
+
+void TokenBucket::take() { tokens_ -= 1; }
+
+RateLimiter::RateLimiter(double rate, double burst, double client_rate,
+                         double client_burst)
+  : client_rate_(client_rate),
+    client_burst_(client_burst),
+    next_sweep_(kMinSweep) {
+  if (rate > 0) {
+    bucket_.emplace(rate, burst, TokenBucket::Clock::now());
+  }
+}
+
+std::unique_ptr<RateLimiter> RateLimiter::make(const ParameterMap& parameters) {
+  const auto rate = getRate(parameters, "rate_limit", 0);
+  const auto client_rate = getRate(parameters, "client_rate_limit", 0);
+  if (rate == 0 && client_rate == 0) {
+    return nullptr;
+  }
+  // a bucket must hold at least one token to ever admit a request
+  const auto burst = std::max(getRate(parameters, "rate_burst", rate), 1.0);
+  const auto client_burst =
+    std::max(getRate(parameters, "client_rate_burst", client_rate), 1.0);
+  return std::make_unique<RateLimiter>(rate, burst, client_rate,
+                                       client_burst);
+}
+
+bool RateLimiter::admit(const std::string& client) {
+  const auto now = TokenBucket::Clock::now();
+  const std::lock_guard lock{mutex_};
+
+  if (bucket_.has_value()) {
+    bucket_->refill(now);
+    if (!bucket_->ready()) {
+      return false;
+    }
+  }
+
+  if (client_rate_ > 0 && !client.empty()) {
+    if (clients_.size() >= next_sweep_) {
+      for (auto iterator = clients_.begin(); iterator != clients_.end();) {
+        iterator->second.refill(now);
+        iterator = iterator->second.full() ? clients_.erase(iterator)
+                                           : std::next(iterator);
+      }
+      next_sweep_ = std::max(kMinSweep, clients_.size() * 2);
+    }
+    auto& client_bucket =
+      clients_.try_emplace(client, client_rate_, client_burst_, now)
+        .first->second;
+    client_bucket.refill(now);
+    if (!client_bucket.ready()) {
+      return false;
+    }
+    client_bucket.take();
+  }
+
+  if (bucket_.has_value()) {
+    bucket_->take();
+  }
+  return true;
+}
+
+}  // namespace amdinfer
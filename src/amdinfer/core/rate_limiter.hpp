@@ -0,0 +1,120 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines the token-bucket rate limits of a model
+ */
+
+#ifndef GUARD_AMDINFER_CORE_RATE_LIMITER
+#define GUARD_AMDINFER_CORE_RATE_LIMITER
+
+#include <chrono>         // for steady_clock
+#include <cstddef>        // for size_t
+#include <memory>         // for unique_ptr
+#include <mutex>          // for mutex
+#include <optional>       // for optional
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+
+namespace amdinfer {
+
+class ParameterMap;
+
+/// Holds up to a burst of tokens and refills them at a fixed rate
+class TokenBucket {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Construct a new full TokenBucket object
+   *
+   * @param rate tokens added per second
+   * @param burst the most tokens the bucket holds
+   * @param now the current time
+   */
+  TokenBucket(double rate, double burst, Clock::time_point now);
+
+  /// Add the tokens accumulated since the last refill
+  void refill(Clock::time_point now);
+  /// Check if the bucket has a token to take
+  [[nodiscard]] bool ready() const;
+  /// Check if the bucket is full so forgetting it changes nothing
+  [[nodiscard]] bool full() const;
+  /// Take a token. The bucket must be ready
+  void take();
+
+ private:
+  double rate_;
+  double burst_;
+  double tokens_;
+  Clock::time_point last_;
+};
+
+/**
+ * @brief Limits the rate of requests a model admits with a token bucket for
+ * the model and, optionally, one for each client. A request is admitted only if
+ * the model's bucket and its client's bucket both have a token.
+ */
+class RateLimiter {
+ public:
+  /**
+   * @brief Construct a new RateLimiter object
+   *
+   * @param rate requests per second the model admits. Zero for no limit
+   * @param burst requests the model admits at once after being idle
+   * @param client_rate requests per second the model admits from each client.
+   * Zero for no limit
+   * @param client_burst requests the model admits at once from a client after
+   * it's been idle
+   */
+  RateLimiter(double rate, double burst, double client_rate,
+              double client_burst);
+
+  /**
+   * @brief Make the rate limiter for a model from its load-time parameters:
+   * "rate_limit" and "rate_burst" for the model and "client_rate_limit" and
+   * "client_rate_burst" for each client. The bursts default to a second's
+   * worth of requests.
+   *
+   * @param parameters the model's load-time parameters
+   * @return std::unique_ptr<RateLimiter> the limiter or nullptr if the model
+   * has no limits
+   * @throws invalid_argument if a limit is negative or not a number
+   */
+  static std::unique_ptr<RateLimiter> make(const ParameterMap& parameters);
+
+  /**
+   * @brief Take a token for a request from the model's bucket and the client's
+   * bucket, if they both have one
+   *
+   * @param client the identity of the client. Requests without one only count
+   * against the model's limit
+   * @return bool true if the request is admitted
+   */
+  bool admit(const std::string& client);
+
+ private:
+  std::mutex mutex_;
+  std::optional<TokenBucket> bucket_;
+  double client_rate_;
+  double client_burst_;
+  std::unordered_map<std::string, TokenBucket> clients_;
+  /// Forget the clients with full buckets when there are this many
+  size_t next_sweep_;
+};
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_CORE_RATE_LIMITER
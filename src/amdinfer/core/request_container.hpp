@@ -22,6 +22,8 @@
 #ifndef GUARD_AMDINFER_CORE_REQUEST_CONTAINER_INTERNAL
 #define GUARD_AMDINFER_CORE_REQUEST_CONTAINER_INTERNAL
 
+#include <string>
+
 #include "amdinfer/build_options.hpp"
 #include "amdinfer/declarations.hpp"
 
@@ -29,6 +31,8 @@ namespace amdinfer {
 
 struct RequestContainer {
   InferenceRequestPtr request;
+  /// Identifies the client for fair queuing. May be empty
+  std::string client;
 #ifdef AMDINFER_ENABLE_TRACING
   TracePtr trace;
 #endif
@@ -0,0 +1,186 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements the cache of responses to repeated requests
+ */
+
+#include "amdinfer/core/response_cache.hpp"
+
+#include <functional>   // for hash
+#include <iterator>     // for next, prev
+#include <optional>     // for optional
+#include <string_view>  // for string_view
+#include <utility>      // for move
+
+#include "amdinfer/batching/coalesce.hpp"       // for makeRequestKey
+#include "amdinfer/build_options.hpp"           // for AMDINFER_ENABLE_METRICS
+#include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
+#include "amdinfer/core/memory_pool/pool.hpp"   // for MemoryPool
+#include "amdinfer/core/request_container.hpp"  // for RequestContainer
+#include "amdinfer/observation/metrics.hpp"     // for Metrics, MetricCount...
+
+namespace amdinfer {
+
+namespace {
+
+/// Count the bytes of a response's output data, which dominates its size
+size_t getSize(const InferenceResponse& response) {
+  size_t size = 0;
+  for (const auto& output : response.getOutputs()) {
+    size += output.getSize() * output.getDatatype().size();
+  }
+  return size;
+}
+
+}  // namespace
+
+ResponseCache::ResponseCache(size_t max_bytes)
+  : shard_bytes_(max_bytes / kShards) {}
+
+void ResponseCache::setMaxBytes(size_t max_bytes) {
+  const auto shard_bytes = max_bytes / kShards;
+  shard_bytes_ = shard_bytes;
+  for (auto& shard : shards_) {
+    const std::lock_guard lock{shard.mutex};
+    evict(&shard, shard_bytes);
+  }
+}
+
+bool ResponseCache::respond(uint64_t group, RequestContainer* request,
+                            const MemoryPool* pool) {
+  // a request can only be cached if it fits in a shard
+  const auto max_bytes = shard_bytes_.load();
+  if (max_bytes == 0) {
+    return false;
+  }
+  const auto& original = request->request;
+  auto key = makeRequestKey(*original, max_bytes);
+  if (!key.has_value()) {
+    return false;
+  }
+  const auto hash = std::hash<std::string_view>{}(key.value()) ^ group;
+
+  auto& shard = shards_[hash % kShards];
+  std::optional<InferenceResponse> response;
+  {
+    const std::lock_guard lock{shard.mutex};
+    const auto [begin, end] = shard.index.equal_range(hash);
+    for (auto found = begin; found != end; ++found) {
+      auto entry = found->second;
+      if (entry->group == group && entry->key == key.value()) {
+        shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+        response = entry->response;
+        break;
+      }
+    }
+  }
+
+  if (response.has_value()) {
+#ifdef AMDINFER_ENABLE_METRICS
+    Metrics::getInstance().incrementCounter(
+      MetricCounterIDs::ResponseCacheHits);
+#endif
+    response->setID(original->getID());
+    original->runCallbackOnce(response.value());
+    // the request never reaches the batcher, which would free its inputs
+    for (const auto& input : original->getInputs()) {
+      pool->put(MemoryAllocators::Cpu, input.getData());
+    }
+    return true;
+  }
+
+#ifdef AMDINFER_ENABLE_METRICS
+  Metrics::getInstance().incrementCounter(
+    MetricCounterIDs::ResponseCacheMisses);
+#endif
+  original->setCallback(
+    [self = shared_from_this(), group, key = std::move(key.value()), hash,
+     callback = original->getCallback()](const InferenceResponse& response) {
+      if (!response.isError()) {
+        self->insert(group, key, hash, response);
+      }
+      callback(response);
+    });
+  return false;
+}
+
+void ResponseCache::insert(uint64_t group, std::string key, size_t hash,
+                           const InferenceResponse& response) {
+  const auto max_bytes = shard_bytes_.load();
+  const auto bytes = key.size() + getSize(response);
+  if (bytes > max_bytes) {
+    return;
+  }
+
+  auto& shard = shards_[hash % kShards];
+  const std::lock_guard lock{shard.mutex};
+  // an identical request may have been answered while this one was in flight
+  const auto [begin, end] = shard.index.equal_range(hash);
+  for (auto found = begin; found != end; ++found) {
+    if (found->second->group == group && found->second->key == key) {
+      return;
+    }
+  }
+
+  shard.entries.push_front(
+    Entry{group, std::move(key), hash, response, bytes});
+  // the ID belongs to the request that was answered, not to later ones
+  shard.entries.front().response.setID("");
+  shard.index.emplace(hash, shard.entries.begin());
+  shard.bytes += bytes;
+  evict(&shard, max_bytes);
+}
+
+void ResponseCache::invalidate(uint64_t group) {
+  // groups that don't cache responses have no ID
+  if (group == 0) {
+    return;
+  }
+  for (auto& shard : shards_) {
+    const std::lock_guard lock{shard.mutex};
+    for (auto entry = shard.entries.begin(); entry != shard.entries.end();) {
+      auto next = std::next(entry);
+      if (entry->group == group) {
+        erase(&shard, entry);
+      }
+      entry = next;
+    }
+  }
+}
+
+void ResponseCache::evict(Shard* shard, size_t max_bytes) {
+  while (shard->bytes > max_bytes) {
+    erase(shard, std::prev(shard->entries.end()));
+#ifdef AMDINFER_ENABLE_METRICS
+    Metrics::getInstance().incrementCounter(
+      MetricCounterIDs::ResponseCacheEvictions);
+#endif
+  }
+}
+
+void ResponseCache::erase(Shard* shard, std::list<Entry>::iterator entry) {
+  const auto [begin, end] = shard->index.equal_range(entry->hash);
+  for (auto found = begin; found != end; ++found) {
+    if (found->second == entry) {
+      shard->index.erase(found);
+      break;
+    }
+  }
+  shard->bytes -= entry->bytes;
+  shard->entries.erase(entry);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,129 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines the cache of responses to repeated requests
+ */
+
+#ifndef GUARD_AMDINFER_CORE_RESPONSE_CACHE
+#define GUARD_AMDINFER_CORE_RESPONSE_CACHE
+
+#include <array>          // for array
+#include <atomic>         // for atomic
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
+#include <list>           // for list
+#include <memory>         // for enable_shared_from_this
+#include <mutex>          // for mutex
+#include <string>         // for string
+#include <unordered_map>  // for unordered_multimap
+
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+
+namespace amdinfer {
+
+class MemoryPool;
+class RequestContainer;
+
+/**
+ * @brief Caches the successful responses of models that always give the same
+ * response to identical requests so repeated requests skip the batcher and the
+ * workers. Responses are keyed by the worker group they came from and a hash
+ * of the request's parameters, inputs and requested outputs. The entries are
+ * spread over shards with their own locks and each shard evicts its least
+ * recently used entries to stay within its share of the byte budget.
+ */
+class ResponseCache : public std::enable_shared_from_this<ResponseCache> {
+ public:
+  /**
+   * @brief Construct a new ResponseCache object
+   *
+   * @param max_bytes the byte budget of all the cached responses and their
+   * keys. Zero disables the cache
+   */
+  explicit ResponseCache(size_t max_bytes);
+
+  /**
+   * @brief Change the byte budget, evicting entries if it has shrunk
+   *
+   * @param max_bytes the byte budget. Zero disables the cache
+   */
+  void setMaxBytes(size_t max_bytes);
+
+  /**
+   * @brief Respond to the request from the cache if an identical request to the
+   * same worker group has been answered. Otherwise, the request's response is
+   * cached once it's successful.
+   *
+   * @param group an ID unique to the worker group the request is sent to so
+   * responses from an earlier load of its endpoint are never used
+   * @param request the request
+   * @param pool the pool to return the request's input buffers to if it's
+   * responded to
+   * @return bool true if the request was responded to
+   */
+  bool respond(uint64_t group, RequestContainer* request,
+               const MemoryPool* pool);
+
+  /**
+   * @brief Remove the cached responses of a worker group
+   *
+   * @param group the ID of the worker group
+   */
+  void invalidate(uint64_t group);
+
+ private:
+  struct Entry {
+    uint64_t group;
+    std::string key;
+    size_t hash;
+    InferenceResponse response;
+    /// The size of the key and the response's data
+    size_t bytes;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    /// Entries from the most to the least recently used
+    std::list<Entry> entries;
+    /// hash -> entries with that hash
+    std::unordered_multimap<size_t, std::list<Entry>::iterator> index;
+    size_t bytes = 0;
+  };
+
+  static constexpr size_t kShards = 16;
+
+  /// Add a response to the cache unless it's already there or too big
+  void insert(uint64_t group, std::string key, size_t hash,
+              const InferenceResponse& response);
+  /**
+   * @brief Evict the shard's least recently used entries until it's within the
+   * budget. Must be called with the shard's mutex held.
+   *
+   * @param shard the shard
+   * @param max_bytes the shard's budget
+   */
+  static void evict(Shard* shard, size_t max_bytes);
+  /// Remove an entry from its shard. Must be called with its mutex held
+  static void erase(Shard* shard, std::list<Entry>::iterator entry);
+
+  /// The byte budget of each shard
+  std::atomic<size_t> shard_bytes_;
+  std::array<Shard, kShards> shards_;
+};
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_CORE_RESPONSE_CACHE
@@ -29,17 +29,19 @@
 #include <unordered_map>  // for operator==, unordered_m...
 #include <unordered_set>  // for unordered_set
 #include <utility>        // for move, pair
-
-#include "amdinfer/build_options.hpp"          // for AMDINFER_ENABLE_VITIS
-#include "amdinfer/core/endpoints.hpp"         // for Endpoints
-#include "amdinfer/core/exceptions.hpp"        // for external_error, invalid...
-#include "amdinfer/core/model_config.hpp"      // for ModelConfig
-#include "amdinfer/core/model_repository.hpp"  // for ModelRepository
-#include "amdinfer/core/parameters.hpp"        // for ParameterMap
-#include "amdinfer/core/request_container.hpp"  // for ServerMetadata, ModelMe...
+#include <vector>         // for vector
+
+#include "amdinfer/build_options.hpp"            // for AMDINFER_ENABLE_VITIS
+#include "amdinfer/core/endpoints.hpp"           // for Endpoints
+#include "amdinfer/core/exceptions.hpp"          // for external_error, inv...
+#include "amdinfer/core/model_config.hpp"        // for ModelConfig
+#include "amdinfer/core/model_repository.hpp"    // for ModelRepository
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/core/request_container.hpp"   // for ServerMetadata, Mod...
+#include "amdinfer/core/versioned_endpoint.hpp"  // for getVersionedEndpoint
 #include "amdinfer/observation/observer.hpp"
-#include "amdinfer/util/string.hpp"  // for isLower
-#include "amdinfer/version.hpp"      // for kAmdinferVersion
+#include "amdinfer/util/string.hpp"              // for isLower, endsWith
+#include "amdinfer/version.hpp"                  // for kAmdinferVersion
 
 #ifdef AMDINFER_ENABLE_VITIS
 #include <sockpp/socket.h>         // for socket, socket_initializer
@@ -79,7 +81,13 @@ void SharedState::modelLoad(const std::string& model,
                             const std::string& version,
                             const ParameterMap& parameters) {
   assert(util::isLower(model));
+  this->loadModel(model, version, parameters);
+}
 
+std::vector<std::string> SharedState::loadModel(
+  const std::string& model, const std::string& version,
+  const ParameterMap& parameters) {
+  std::vector<std::string> endpoints;
   auto model_config = parseModel(repository_.getRepository(), model, version);
   const auto end = model_config.crend();
   for (auto it = model_config.crbegin(); it != end; ++it) {
@@ -90,8 +98,46 @@ void SharedState::modelLoad(const std::string& model,
       updated_parameters.put(key, value);
     }
     // the config will add the versioned model name already
-    endpoints_.load(model_name, "", updated_parameters);
+    endpoints.push_back(endpoints_.load(model_name, "", updated_parameters));
+  }
+  return endpoints;
+}
+
+void SharedState::modelSwap(const std::string& model,
+                            const std::string& version,
+                            const ParameterMap& parameters) {
+  assert(util::isLower(model));
+  // the new version replaces the endpoints of the default version so strip the
+  // version from the endpoint names the config uses
+  const auto suffix = getVersionedEndpoint("", version);
+  auto unversioned = [&](const std::string& endpoint) {
+    if (!version.empty() && util::endsWith(endpoint, suffix)) {
+      return endpoint.substr(0, endpoint.size() - suffix.size());
+    }
+    return endpoint;
+  };
+
+  auto model_config = parseModel(repository_.getRepository(), model, version);
+  std::vector<std::pair<std::string, ParameterMap>> stages;
+  for (const auto& [model_name, model_parameters] : model_config) {
+    ParameterMap updated_parameters = model_parameters;
+    for (const auto& [key, value] : parameters) {
+      updated_parameters.put(key, value);
+    }
+    if (updated_parameters.has("next")) {
+      updated_parameters.put(
+        "next", unversioned(updated_parameters.get<std::string>("next")));
+    }
+    stages.emplace_back(unversioned(model_name), std::move(updated_parameters));
   }
+  endpoints_.swap(std::move(stages));
+}
+
+void SharedState::modelConfigure(const std::string& model,
+                                 const std::string& version,
+                                 const ParameterMap& parameters) {
+  assert(util::isLower(model));
+  endpoints_.configure(model, version, parameters);
 }
 
 void SharedState::modelUnload(const std::string& model,
@@ -113,10 +159,30 @@ void SharedState::workerUnload(const std::string& worker) {
   endpoints_.unload(worker, "");
 }
 
+bool SharedState::modelAdmit(const std::string& model,
+                             const std::string& version,
+                             const std::string& client) {
+  return endpoints_.admit(model, version, client);
+}
+
 void SharedState::modelInfer(const std::string& model,
                              std::unique_ptr<RequestContainer> request,
                              const std::string& version) {
-  endpoints_.infer(model, std::move(request), version);
+  if (cache_.enabled()) {
+    cache_.infer(model, std::move(request), version);
+  } else {
+    endpoints_.infer(model, std::move(request), version);
+  }
+}
+
+void SharedState::modelInfer(EndpointHandle* handle,
+                             std::unique_ptr<RequestContainer> request) {
+  endpoints_.infer(handle, std::move(request));
+}
+
+EndpointHandle SharedState::modelHandle(const std::string& model,
+                                        const std::string& version) {
+  return endpoints_.resolve(model, version);
 }
 
 bool SharedState::modelReady(const std::string& model,
@@ -216,4 +282,12 @@ void SharedState::enableRepositoryMonitoring(bool use_polling) {
   repository_.enableMonitoring(use_polling);
 }
 
+void SharedState::enableModelCache(size_t max_models, size_t max_bytes) {
+  cache_.enable(repository_.getRepository(), max_models, max_bytes);
+}
+
+void SharedState::setResponseCacheSize(size_t max_bytes) {
+  endpoints_.setResponseCacheSize(max_bytes);
+}
+
 }  // namespace amdinfer
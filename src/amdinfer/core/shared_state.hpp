@@ -26,6 +26,7 @@
 #include <vector>      // for vector
 
 #include "amdinfer/core/endpoints.hpp"         // for Endpoints
+#include "amdinfer/core/model_cache.hpp"       // for ModelCache
 #include "amdinfer/core/model_metadata.hpp"    // for ModelMetadata
 #include "amdinfer/core/model_repository.hpp"  // for ModelRepository
 #include "amdinfer/core/server_metadata.hpp"   // for ServerMetadata
@@ -40,6 +41,26 @@ class SharedState {
  public:
   void modelLoad(const std::string& model, const std::string& version,
                  const ParameterMap& parameters);
+  /**
+   * @brief Replace a loaded model with the given version from the repository
+   * without interrupting requests to it
+   *
+   * @param model name of the loaded model
+   * @param version the version to serve in its place. Empty for the default
+   * @param parameters load-time parameters to add to those in the config
+   */
+  void modelSwap(const std::string& model, const std::string& version,
+                 const ParameterMap& parameters);
+  /**
+   * @brief Change the batching parameters and worker count of a loaded model
+   * without reloading it
+   *
+   * @param model name of the loaded model
+   * @param version version of the model. Empty for the default
+   * @param parameters any of "batch_size", "timeout" and "workers"
+   */
+  void modelConfigure(const std::string& model, const std::string& version,
+                      const ParameterMap& parameters);
   void modelUnload(const std::string& model, const std::string& version);
   std::string workerLoad(const std::string& worker,
                          const ParameterMap& parameters);
@@ -51,9 +72,15 @@ class SharedState {
   ModelMetadata modelMetadata(const std::string& model,
                               const std::string& version = "");
 
+  bool modelAdmit(const std::string& model, const std::string& version,
+                  const std::string& client);
   void modelInfer(const std::string& model,
                   std::unique_ptr<RequestContainer> request,
                   const std::string& version = "");
+  void modelInfer(EndpointHandle* handle,
+                  std::unique_ptr<RequestContainer> request);
+  EndpointHandle modelHandle(const std::string& model,
+                             const std::string& version = "");
 
   static Kernels getHardware();
   static bool hasHardware(const std::string& name, int num);
@@ -63,10 +90,22 @@ class SharedState {
   void setRepository(const std::filesystem::path& repository_path,
                      bool load_existing);
   void enableRepositoryMonitoring(bool use_polling);
+  void enableModelCache(size_t max_models, size_t max_bytes);
+  void setResponseCacheSize(size_t max_bytes);
 
  private:
+  /// Load a model from the repository and return the endpoints it created
+  std::vector<std::string> loadModel(const std::string& model,
+                                     const std::string& version,
+                                     const ParameterMap& parameters);
+
   Endpoints endpoints_;
   ModelRepository repository_;
+  ModelCache cache_{&endpoints_,
+                    [this](const std::string& model,
+                           const std::string& version) {
+                      return this->loadModel(model, version, {});
+                    }};
 };
 
 }  // namespace amdinfer
@@ -0,0 +1,204 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements how workers are warmed up as they load
+ */
+
+#include "amdinfer/core/warmup.hpp"
+
+#include <chrono>      // for seconds, steady_clock, duration
+#include <cstddef>     // for byte, size_t
+#include <cstdint>     // for int64_t
+#include <filesystem>  // for path
+#include <fstream>     // for ifstream
+#include <future>      // for promise, future
+#include <memory>      // for make_shared, unique_ptr
+#include <random>      // for mt19937, uniform_int_distribution
+#include <ratio>       // for micro
+#include <string>      // for string, to_string
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "amdinfer/batching/batcher.hpp"         // for Batcher
+#include "amdinfer/buffers/buffer.hpp"           // for Buffer
+#include "amdinfer/build_options.hpp"            // for kEndpointLoadTimeout
+#include "amdinfer/core/exceptions.hpp"          // for invalid_argument
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"    // for MemoryPool
+#include "amdinfer/core/model_metadata.hpp"      // for ModelMetadata
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/core/request_container.hpp"   // for RequestContainer
+#include "amdinfer/core/worker_info.hpp"         // for WorkerInfo
+#include "amdinfer/observation/logging.hpp"      // for Logger
+#include "amdinfer/observation/metrics.hpp"      // for Metrics
+#include "amdinfer/util/string.hpp"              // for parseBatchSizes
+#include "amdinfer/util/timer.hpp"               // for Timer
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+namespace {
+
+std::vector<std::byte> makeData(const Tensor& tensor, size_t size,
+                                const std::string& data) {
+  std::vector<std::byte> buffer(size);
+  if (data == "zeros") {
+    return buffer;
+  }
+  if (data == "random") {
+    std::mt19937 generator{std::random_device{}()};
+    std::uniform_int_distribution<int> distribution{0, UINT8_MAX};
+    for (auto& byte : buffer) {
+      byte = static_cast<std::byte>(distribution(generator));
+    }
+    return buffer;
+  }
+
+  const auto path = fs::path{data} / (tensor.getName() + ".bin");
+  std::ifstream file{path, std::ios::binary | std::ios::ate};
+  if (!file.is_open()) {
+    throw invalid_argument("Cannot open warmup data " + path.string());
+  }
+  if (static_cast<size_t>(file.tellg()) != size) {
+    throw invalid_argument("Warmup data " + path.string() + " must be " +
+                           std::to_string(size) + " bytes");
+  }
+  file.seekg(0);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.read(reinterpret_cast<char*>(buffer.data()),
+            static_cast<std::streamsize>(size));
+  return buffer;
+}
+
+}  // namespace
+
+SyntheticInputs makeSyntheticInputs(const WorkerInfo& worker,
+                                    const std::string& data) {
+  SyntheticInputs inputs;
+  for (const auto& input : worker.getMetadata().getInputs()) {
+    auto shape = input.getShape();
+    for (auto& dimension : shape) {
+      dimension = dimension > 0 ? dimension : 1;
+    }
+    const Tensor tensor{input.getName(), shape, input.getDatatype()};
+    const auto size = tensor.getSize() * tensor.getDatatype().size();
+    inputs.data.push_back(makeData(tensor, size, data));
+    inputs.tensors.push_back(tensor);
+  }
+  return inputs;
+}
+
+std::vector<double> sendSyntheticRequests(const std::string& endpoint,
+                                          WorkerInfo* worker,
+                                          const SyntheticInputs& inputs,
+                                          int count, const MemoryPool* pool) {
+  using Clock = std::chrono::steady_clock;
+  const auto* batcher = worker->getBatcher();
+  const auto& tensors = inputs.tensors;
+
+  std::vector<std::future<Clock::time_point>> futures;
+  futures.reserve(count);
+  std::vector<std::shared_ptr<InferenceResponse>> responses;
+  responses.reserve(count);
+  const auto start = Clock::now();
+  for (auto i = 0; i < count; ++i) {
+    auto request = std::make_shared<InferenceRequest>();
+    for (size_t j = 0; j < tensors.size(); ++j) {
+      const auto& tensor = tensors[j];
+      auto buffer = pool->get({MemoryAllocators::Cpu}, tensor, 1);
+      const auto& data = inputs.data[j];
+      // write only reads from the data despite its signature
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      buffer->write(const_cast<std::byte*>(data.data()), 0, data.size());
+      request->addInputTensor(buffer->data(0), tensor.getShape(),
+                              tensor.getDatatype(), tensor.getName());
+    }
+    // the promise is fulfilled with the time the response arrived
+    auto promise = std::make_shared<std::promise<Clock::time_point>>();
+    auto response = std::make_shared<InferenceResponse>();
+    futures.push_back(promise->get_future());
+    responses.push_back(response);
+    request->setCallback(
+      [promise, response](const InferenceResponse& result) {
+        *response = result;
+        promise->set_value(Clock::now());
+      });
+    auto request_container = std::make_unique<RequestContainer>();
+    request_container->request = std::move(request);
+#ifdef AMDINFER_ENABLE_METRICS
+    request_container->start_time = std::chrono::system_clock::now();
+#endif
+    batcher->enqueue(std::move(request_container));
+  }
+
+  std::vector<double> latencies;
+  latencies.reserve(count);
+  for (auto i = 0; i < count; ++i) {
+    auto& future = futures[i];
+    if (future.wait_for(std::chrono::seconds(kEndpointLoadTimeout)) ==
+        std::future_status::timeout) {
+      throw runtime_error("Timed out waiting for " + endpoint);
+    }
+    const auto end = future.get();
+    if (responses[i]->isError()) {
+      throw runtime_error("Request to " + endpoint +
+                          " failed: " + responses[i]->getError());
+    }
+    latencies.push_back(
+      std::chrono::duration<double, std::micro>(end - start).count());
+  }
+  return latencies;
+}
+
+void warmup(const std::string& endpoint, WorkerInfo* worker,
+            const ParameterMap& parameters, const MemoryPool* pool) {
+  if (!parameters.has("warmup_batch_sizes")) {
+    return;
+  }
+  AMDINFER_IF_LOGGING(Logger logger{Loggers::Server};)
+  const auto batch_sizes = util::parseBatchSizes(
+    parameters.get<std::string>("warmup_batch_sizes"), "warmup_batch_sizes");
+  const auto count = parameters.has("warmup_count")
+                       ? parameters.get<int32_t>("warmup_count")
+                       : 1;
+  const auto data = parameters.has("warmup_data")
+                      ? parameters.get<std::string>("warmup_data")
+                      : "zeros";
+
+  // the same data is used for every request
+  const auto inputs = makeSyntheticInputs(*worker, data);
+  for (const auto batch_size : batch_sizes) {
+    for (auto i = 0; i < count; ++i) {
+      util::Timer timer{true};
+      sendSyntheticRequests(endpoint, worker, inputs,
+                            static_cast<int>(batch_size), pool);
+      timer.stop();
+#ifdef AMDINFER_ENABLE_METRICS
+      Metrics::getInstance().observeSummary(MetricSummaryIDs::WarmupLatency,
+                                            timer.count<std::micro>());
+#endif
+      AMDINFER_LOG_DEBUG(logger, "Warmed up " + endpoint + " at batch size " +
+                                   std::to_string(batch_size) + " in " +
+                                   std::to_string(timer.count<std::micro>()) +
+                                   " us");
+    }
+  }
+  AMDINFER_LOG_INFO(logger, "Warmed up " + endpoint);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,90 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines how workers are warmed up as they load
+ */
+
+#ifndef GUARD_AMDINFER_CORE_WARMUP
+#define GUARD_AMDINFER_CORE_WARMUP
+
+#include <cstddef>  // for byte
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "amdinfer/core/tensor.hpp"  // for Tensor
+
+namespace amdinfer {
+
+class MemoryPool;
+class ParameterMap;
+class WorkerInfo;
+
+/// Input tensors and their data for synthetic requests to a worker group
+struct SyntheticInputs {
+  std::vector<Tensor> tensors;
+  std::vector<std::vector<std::byte>> data;
+};
+
+/**
+ * @brief Make the inputs for synthetic requests from the worker's metadata.
+ * Variable-sized dimensions have a size of one.
+ *
+ * @param worker the worker group the requests are for
+ * @param data "zeros", "random" or a directory of raw <input name>.bin files
+ * @return SyntheticInputs
+ * @throws invalid_argument if the data files are missing or the wrong size
+ */
+SyntheticInputs makeSyntheticInputs(const WorkerInfo& worker,
+                                    const std::string& data);
+
+/**
+ * @brief Send synthetic requests to a worker group at once and wait for all of
+ * their responses
+ *
+ * @param endpoint name of the endpoint, for errors
+ * @param worker the worker group to send the requests to
+ * @param inputs the inputs to use for every request
+ * @param count the number of requests to send
+ * @param pool the memory pool to allocate the input buffers from
+ * @return std::vector<double> the latency of each request in microseconds
+ * @throws runtime_error if a request fails or times out
+ */
+std::vector<double> sendSyntheticRequests(const std::string& endpoint,
+                                          WorkerInfo* worker,
+                                          const SyntheticInputs& inputs,
+                                          int count, const MemoryPool* pool);
+
+/**
+ * @brief Send the warmup requests described by the worker's load parameters,
+ * if there are any, and wait for them to finish. The warmup_batch_sizes
+ * parameter lists the batch sizes to warm up as a comma-separated string. For
+ * each one, that many requests are sent at once warmup_count times. The input
+ * tensors are taken from the worker's metadata and filled according to
+ * warmup_data: "zeros", "random" or a directory of raw <input name>.bin files.
+ *
+ * @param endpoint name of the endpoint being loaded
+ * @param worker the worker group to send the requests to
+ * @param parameters the worker's load parameters
+ * @param pool the memory pool to allocate the input buffers from
+ * @throws invalid_argument if the warmup data is invalid
+ * @throws runtime_error if a warmup request fails or times out
+ */
+void warmup(const std::string& endpoint, WorkerInfo* worker,
+            const ParameterMap& parameters, const MemoryPool* pool);
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_CORE_WARMUP
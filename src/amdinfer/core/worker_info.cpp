@@ -23,19 +23,26 @@
 
 #include <dlfcn.h>  // for dlerror, dlopen, dlsym, RTL...
 
+#include <atomic>       // for atomic
 #include <cctype>       // for toupper
 #include <climits>      // for UINT_MAX
-#include <cstdint>      // for int32_t
+#include <cstdint>      // for int32_t, uint64_t
 #include <exception>    // for exception
+#include <mutex>        // for lock_guard, unique_lock
 #include <string>       // for string, operator+, basic_st...
 #include <type_traits>  // for remove_reference<>::type
 #include <utility>      // for pair, move, make_pair
+#include <vector>       // for vector
 
 #include "amdinfer/batching/batcher.hpp"  // for Batcher, BatcherStatus, Bat...
 #include "amdinfer/core/exceptions.hpp"   // for invalid_argument, external_...
+#include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
 #include "amdinfer/core/memory_pool/pool.hpp"   // for MemoryPool
 #include "amdinfer/core/parameters.hpp"         // for ParameterMap
+#include "amdinfer/core/rate_limiter.hpp"       // for RateLimiter
 #include "amdinfer/core/request_container.hpp"  // for ModelMetadata
+#include "amdinfer/core/worker_registry.hpp"    // for findWorker, WorkerFa...
+#include "amdinfer/util/string.hpp"             // for parseBatchSizes
 #include "amdinfer/workers/worker.hpp"  // for Worker, WorkerStatus, Worke...
 
 namespace amdinfer {
@@ -111,22 +118,66 @@ WorkerInfo::WorkerInfo(const std::string& name, ParameterMap* parameters,
                        MemoryPool* pool, BatchPtrQueue* next,
                        std::vector<MemoryAllocators> next_allocators)
   : next_(next), next_allocators_(std::move(next_allocators)) {
-  handle_ = getHandle(name);
+  // invalid limits are found before any worker is started
+  rate_limiter_ = RateLimiter::make(*parameters);
+  // workers compiled into the server take precedence over plugins
+  factory_ = findWorker(name);
+  if (factory_ == nullptr) {
+    handle_ = getHandle(name);
+  }
   this->addAndStartWorker(name, parameters, pool);
+
+  // stateful requests depend on more than their own inputs and only the first
+  // response of a streaming worker would be cached as the whole answer
+  if (parameters->has("response_cache") &&
+      parameters->get<bool>("response_cache") &&
+      !this->batchers_[0]->isStateful() &&
+      !this->batchers_[0]->isStreaming()) {
+    static std::atomic<uint64_t> response_cache_ids = 0;
+    this->response_cache_id_ = ++response_cache_ids;
+  }
 }
 
 WorkerInfo::~WorkerInfo() {
+  // requests may still be queued if they were sent while the workers were
+  // stopping. Respond to them so their clients aren't left waiting.
+  if (workers_.empty() && !batchers_.empty()) {
+    const std::string error = "Worker was unloaded before the request ran";
+    RequestContainerPtr container;
+    while (batchers_[0]->tryDequeue(&container)) {
+      // containers without a request only wake the batcher
+      if (container != nullptr && container->request != nullptr) {
+        container->request->runCallbackError(error);
+      }
+    }
+    BatchPtr batch;
+    while (batchers_[0]->getOutputQueue()->try_dequeue(batch)) {
+      if (batch != nullptr) {
+        for (const auto& request : *batch) {
+          request->runCallbackError(error);
+        }
+      }
+    }
+  }
   batchers_.clear();
   for (const auto& [thread_id, worker] : workers_) {
     delete worker;  // NOLINT(cppcoreguidelines-owning-memory)
   }
-  dlclose(handle_);
-  handle_ = nullptr;
+  if (handle_ != nullptr) {
+    dlclose(handle_);
+    handle_ = nullptr;
+  }
 }
 
 void WorkerInfo::addAndStartWorker(const std::string& name,
                                    ParameterMap* parameters, MemoryPool* pool) {
-  auto* worker = getWorker(handle_);
+  // the requests' state would be split between the workers
+  if (!this->batchers_.empty() && this->batchers_[0]->isStateful() &&
+      !this->workers_.empty()) {
+    throw invalid_argument(
+      "Models with stateful sequence batching can only have one worker");
+  }
+  auto* worker = factory_ != nullptr ? factory_() : getWorker(handle_);
   worker->init(parameters);
 
   std::vector<MemoryAllocators> allocators = worker->getAllocators();
@@ -140,20 +191,30 @@ void WorkerInfo::addAndStartWorker(const std::string& name,
     throw runtime_error("Unknown error occurred");
   }
 
-  this->batch_size_ = worker->getBatchSize();
+  this->max_batch_size_ = worker->getBatchSize();
   worker->setNext(next_);
   worker->setNextAllocators(next_allocators_);
 
   if (this->batchers_.empty()) {
+    this->batch_size_ = this->max_batch_size_;
     int32_t batcher_count = 1;
     if (parameters->has("batchers")) {
       batcher_count = parameters->get<int32_t>("batchers");
     }
     this->batchers_ = worker->makeBatcher(batcher_count, parameters, pool);
 
+    // the batch sizes can be overridden at load time to tune the padding
+    auto batch_sizes = worker->getBatchSizes();
+    if (parameters->has("batch_sizes")) {
+      batch_sizes = util::parseBatchSizes(
+        parameters->get<std::string>("batch_sizes"), "batch_sizes");
+    }
+
     for (const auto& batcher : this->batchers_) {
       batcher->setName(name);
       batcher->setBatchSize(this->batch_size_);
+      batcher->setBatchSizes(batch_sizes, worker->getBatchPadding());
+      batcher->setStreaming(worker->isStreaming());
     }
   }
 
@@ -162,8 +223,15 @@ void WorkerInfo::addAndStartWorker(const std::string& name,
       batcher->start(allocators);
     }
   }
-  std::thread thread{&workers::Worker::run, worker,
-                     this->batchers_[0]->getOutputQueue(), pool};
+  auto* input_queue = this->batchers_[0]->getOutputQueue();
+  std::thread thread{[this, worker, input_queue, pool]() {
+    worker->run(input_queue, pool);
+    {
+      const std::lock_guard lock{this->stopped_mutex_};
+      this->stopped_.push_back(std::this_thread::get_id());
+    }
+    this->stopped_cv_.notify_all();
+  }};
 
   auto thread_id = thread.get_id();
 
@@ -196,36 +264,30 @@ void WorkerInfo::unload() {
   this->batchers_[0]->getOutputQueue()->enqueue(nullptr);
 
   bool last_worker = this->workers_.size() == 1;
-  if (last_worker) {
+  // the batchers are already stopped if the group is being drained
+  if (last_worker && this->batchers_[0]->getStatus() != BatcherStatus::Dead) {
     this->joinAll();
-    // we enqueue nullptrs to kill the batchers but don't know which batcher
-    // may receive the nullptr if there are multiple. So, we loop through all of
-    // of them until we find one that's inactive, indicating it received the
-    // nullptr, and end that one.
+    // the batchers share an input queue so we can't tell which batcher will
+    // receive a given nullptr. Each batcher stops after receiving one so we
+    // send one per batcher and then wait for all of them to end.
     for (const auto& batcher : this->batchers_) {
       batcher->enqueue(nullptr);
-      auto i = -1;
-      BatcherStatus status;
-      do {
-        i = (i + 1) % this->batchers_.size();
-        status = batchers_[i]->getStatus();
-      } while (status != BatcherStatus::Inactive);
-      this->batchers_[i]->end();
+    }
+    for (const auto& batcher : this->batchers_) {
+      batcher->end();
     }
   }
 
+  // any worker in the group may have received the nullptr so wait until one of
+  // them stops
   std::thread::id id;
-  bool found = false;
-  while (!found) {
-    for (const auto& [thread_id, worker] : this->workers_) {
-      if (worker->getStatus() == workers::WorkerStatus::Inactive) {
-        id = thread_id;
-        found = true;
-        this->join(thread_id);
-        break;
-      }
-    }
+  {
+    std::unique_lock lock{this->stopped_mutex_};
+    this->stopped_cv_.wait(lock, [this]() { return !this->stopped_.empty(); });
+    id = this->stopped_.back();
+    this->stopped_.pop_back();
   }
+  this->join(id);
   auto* worker = this->workers_[id];
   worker->release();
   worker->destroy();
@@ -236,8 +298,39 @@ void WorkerInfo::unload() {
   this->workers_.erase(id);
 }
 
+void WorkerInfo::configure(const ParameterMap& parameters) {
+  // check everything before changing anything
+  if (parameters.has("batch_size")) {
+    const auto batch_size = parameters.get<int32_t>("batch_size");
+    if (batch_size <= 0 ||
+        static_cast<size_t>(batch_size) > this->max_batch_size_) {
+      throw invalid_argument(
+        "The batch size must be between 1 and " +
+        std::to_string(this->max_batch_size_) +
+        ", the batch size the worker was loaded with");
+    }
+  }
+  if (parameters.has("timeout") && parameters.get<int32_t>("timeout") < 0) {
+    throw invalid_argument("The timeout cannot be negative");
+  }
+
+  if (parameters.has("batch_size")) {
+    this->batch_size_ = parameters.get<int32_t>("batch_size");
+  }
+  for (const auto& batcher : this->batchers_) {
+    batcher->configure(parameters);
+  }
+}
+
 size_t WorkerInfo::getGroupSize() const { return this->workers_.size(); }
 
+size_t WorkerInfo::getQueueDepth() const {
+  // batches waiting for a worker count as the requests they can hold
+  const auto& batcher = this->batchers_[0];
+  return batcher->getQueueSize() +
+         batcher->getOutputQueue()->size_approx() * this->batch_size_;
+}
+
 void WorkerInfo::shutdown() {
   auto workers = this->getGroupSize();
   for (auto i = 0U; i < workers; i++) {
@@ -245,11 +338,32 @@ void WorkerInfo::shutdown() {
   }
 }
 
+void WorkerInfo::drain() {
+  // stop the batchers first. They send their partial batches on to the workers
+  // before stopping so every queued request is ahead of the nullptrs that stop
+  // the workers
+  for (const auto& batcher : this->batchers_) {
+    batcher->enqueue(nullptr);
+  }
+  for (const auto& batcher : this->batchers_) {
+    batcher->end();
+  }
+  this->shutdown();
+}
+
 ModelMetadata WorkerInfo::getMetadata() const {
   auto* worker_class = workers_.begin()->second;
   return worker_class->getMetadata();
 }
 
+uint64_t WorkerInfo::getResponseCacheId() const {
+  return this->response_cache_id_;
+}
+
+bool WorkerInfo::admit(const std::string& client) {
+  return rate_limiter_ == nullptr || rate_limiter_->admit(client);
+}
+
 std::vector<MemoryAllocators> WorkerInfo::getAllocators() const {
   const auto* worker_class = workers_.begin()->second;
   return worker_class->getAllocators();
@@ -22,22 +22,27 @@
 #ifndef GUARD_AMDINFER_CORE_WORKER_INFO
 #define GUARD_AMDINFER_CORE_WORKER_INFO
 
-#include <cstddef>  // for size_t
-#include <map>      // for map
-#include <memory>   // for unique_ptr
-#include <string>   // for string
-#include <thread>   // for thread, thread::id
-#include <vector>   // for vector
-
-#include "amdinfer/batching/batcher.hpp"  // for BatchPtrQueue
-#include "amdinfer/declarations.hpp"      // for BufferPtr
-#include "amdinfer/util/queue.hpp"        // for BufferPtrsQueuePtr
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint64_t
+#include <map>                 // for map
+#include <memory>              // for unique_ptr
+#include <mutex>               // for mutex
+#include <string>              // for string
+#include <thread>              // for thread, thread::id
+#include <vector>              // for vector
+
+#include "amdinfer/batching/batcher.hpp"      // for BatchPtrQueue
+#include "amdinfer/core/worker_registry.hpp"  // for WorkerFactory
+#include "amdinfer/declarations.hpp"          // for BufferPtr
+#include "amdinfer/util/queue.hpp"            // for BufferPtrsQueuePtr
 
 namespace amdinfer {
 class Batcher;
 class ParameterMap;
 class ModelMetadata;
 class MemoryPool;
+class RateLimiter;
 namespace workers {
 class Worker;
 }  // namespace workers
@@ -93,9 +98,26 @@ class WorkerInfo {
   void unload();
   /// unload all workers from this worker group
   void shutdown();
+  /**
+   * @brief Unload all workers from this worker group after the requests that
+   * are already queued have been run. Requests must no longer be sent to it.
+   */
+  void drain();
 
   /// get the number of workers in the group
   [[nodiscard]] size_t getGroupSize() const;
+  /// get the approximate number of requests waiting for a worker in the group
+  [[nodiscard]] size_t getQueueDepth() const;
+
+  /**
+   * @brief Change how requests are batched for the group while it runs. The
+   * batchers use the new values from the next batch they start.
+   *
+   * @param parameters "batch_size", up to the batch size the workers were
+   * loaded with, and "timeout" in milliseconds
+   * @throws invalid_argument if a value is out of range
+   */
+  void configure(const ParameterMap& parameters);
 
   /// get the batch size of the worker group
   [[nodiscard]] auto getBatchSize() const { return this->batch_size_; }
@@ -104,14 +126,46 @@ class WorkerInfo {
 
   ModelMetadata getMetadata() const;
 
+  /**
+   * @brief Get the ID of the group's responses in the response cache. It's
+   * unique to this group so responses cached for an earlier load of its
+   * endpoint are never used. Zero if the group wasn't loaded with the
+   * "response_cache" parameter set, its requests are stateful or its workers
+   * stream their responses.
+   *
+   * @return uint64_t
+   */
+  [[nodiscard]] uint64_t getResponseCacheId() const;
+
+  /**
+   * @brief Check if a request from the client is within the group's rate
+   * limits, taking a token from its buckets if it is
+   *
+   * @param client the identity of the client. May be empty
+   * @return bool true if the request is admitted
+   */
+  bool admit(const std::string& client);
+
  private:
   std::map<std::thread::id, std::thread> worker_threads_;
+  /// the shared library of a plugin worker
   void* handle_ = nullptr;
+  /// the factory of a worker compiled into the server
+  WorkerFactory factory_ = nullptr;
   std::map<std::thread::id, workers::Worker*> workers_;
   std::vector<std::unique_ptr<Batcher>> batchers_;
   size_t batch_size_ = 1;
+  uint64_t response_cache_id_ = 0;
+  /// the group's rate limits, if it has any
+  std::unique_ptr<RateLimiter> rate_limiter_;
+  /// the batch size the workers were loaded with, which batches can't exceed
+  size_t max_batch_size_ = 1;
   BatchPtrQueue* next_;
   std::vector<MemoryAllocators> next_allocators_;
+  /// IDs of worker threads that have stopped but not been joined yet
+  std::vector<std::thread::id> stopped_;
+  std::mutex stopped_mutex_;
+  std::condition_variable stopped_cv_;
 
   friend class Manager;
 };
@@ -0,0 +1,69 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements the registry of workers compiled into the server
+ */
+
+#include "amdinfer/core/worker_registry.hpp"
+
+#include <cctype>         // for tolower
+#include <mutex>          // for lock_guard, mutex
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+
+namespace amdinfer {
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  std::unordered_map<std::string, WorkerFactory> factories;
+};
+
+// workers register themselves during static initialization so the registry is
+// created on first use rather than relying on the initialization order
+Registry& getRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+std::string normalize(const std::string& name) {
+  auto key = name.substr(0, name.find('-'));
+  for (auto& c : key) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return key;
+}
+
+}  // namespace
+
+bool registerWorker(const std::string& name, WorkerFactory factory) {
+  auto& registry = getRegistry();
+  const std::lock_guard lock{registry.mutex};
+  return registry.factories.try_emplace(normalize(name), factory).second;
+}
+
+WorkerFactory findWorker(const std::string& name) {
+  auto& registry = getRegistry();
+  const std::lock_guard lock{registry.mutex};
+  if (auto iter = registry.factories.find(normalize(name));
+      iter != registry.factories.end()) {
+    return iter->second;
+  }
+  return nullptr;
+}
+
+}  // namespace amdinfer
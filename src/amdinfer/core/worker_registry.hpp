@@ -0,0 +1,76 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines the registry of workers compiled into the server
+ */
+
+#ifndef GUARD_AMDINFER_CORE_WORKER_REGISTRY
+#define GUARD_AMDINFER_CORE_WORKER_REGISTRY
+
+#include <string>  // for string
+
+namespace amdinfer {
+
+namespace workers {
+class Worker;
+}  // namespace workers
+
+/// Function that creates a new instance of a worker
+using WorkerFactory = workers::Worker* (*)();
+
+/**
+ * @brief Register a worker compiled into the server so it can be loaded
+ * without opening a shared library
+ *
+ * @param name name of the worker. It's case-insensitive
+ * @param factory function to create instances of the worker
+ * @return bool true if the worker was added or false if the name is taken
+ */
+bool registerWorker(const std::string& name, WorkerFactory factory);
+
+/**
+ * @brief Find a worker compiled into the server. As with the shared libraries,
+ * a configuration tag starting with "-" in the name is ignored
+ *
+ * @param name name of the worker to find
+ * @return WorkerFactory the worker's factory or nullptr if it's not registered
+ */
+WorkerFactory findWorker(const std::string& name);
+
+}  // namespace amdinfer
+
+/**
+ * @brief Define how a worker is created. Workers compiled into the server,
+ * marked by AMDINFER_BUILTIN_WORKER, add themselves to the registry. Otherwise,
+ * the worker is a plugin and exports getWorker() for the server to find.
+ * Workers are managed manually because smart pointers may cause problems inside
+ * shared objects.
+ *
+ * @param name name of the worker
+ * @param ... expression that returns a new instance of the worker
+ */
+#ifdef AMDINFER_BUILTIN_WORKER
+#define AMDINFER_REGISTER_WORKER(name, ...)                                 \
+  namespace {                                                               \
+  [[maybe_unused]] const bool kWorkerRegistered = amdinfer::registerWorker( \
+    name, []() -> amdinfer::workers::Worker* { return __VA_ARGS__; });      \
+  }
+#else
+#define AMDINFER_REGISTER_WORKER(name, ...) \
+  extern "C" amdinfer::workers::Worker* getWorker() { return __VA_ARGS__; }
+#endif
+
+#endif  // GUARD_AMDINFER_CORE_WORKER_REGISTRY
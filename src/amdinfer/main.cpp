@@ -20,13 +20,17 @@
  */
 
 #include <csignal>      // for signal, SIGINT, SIGTERM
+#include <cstddef>      // for size_t
 #include <cstdint>      // for uint16_t
 #include <cstdlib>      // for exit
 #include <cxxopts.hpp>  // for value, OptionAdder, Options
+#include <exception>    // for exception
 #include <iostream>     // for operator<<, basic_ostream
 #include <string>       // for string, allocator, char_...
+#include <vector>       // for vector
 
 #include "amdinfer/build_options.hpp"        // for AMDINFER_ENABLE_HTTP
+#include "amdinfer/core/exceptions.hpp"      // for invalid_argument
 #include "amdinfer/observation/logging.hpp"  // for AMDINFER_LOG_INFO, Logger
 #include "amdinfer/servers/server.hpp"       // for Server
 
@@ -43,6 +47,57 @@ void signalCallbackHandler([[maybe_unused]] int signum) {
   usr_interrupt = true;
 }
 
+/**
+ * @brief Parse a listener address of the form "address[:port]". IPv6 addresses
+ * with a port must be bracketed e.g. "[::1]:8998"
+ *
+ * @param arg the address to parse
+ * @return amdinfer::HttpListener
+ */
+amdinfer::HttpListener parseListener(const std::string& arg) {
+  if (arg.rfind("unix:", 0) == 0) {
+    throw amdinfer::invalid_argument(
+      "Unix domain sockets are not supported by the HTTP server. Use a "
+      "loopback address such as 127.0.0.1 for local clients instead");
+  }
+
+  amdinfer::HttpListener listener;
+  auto port_separator = std::string::npos;
+  if (arg.empty()) {
+    throw amdinfer::invalid_argument("Listener address cannot be empty");
+  }
+  if (arg.front() == '[') {
+    const auto bracket = arg.find(']');
+    if (bracket == std::string::npos) {
+      throw amdinfer::invalid_argument("Invalid listener address: " + arg);
+    }
+    listener.address = arg.substr(1, bracket - 1);
+    if (bracket + 1 < arg.size()) {
+      if (arg[bracket + 1] != ':') {
+        throw amdinfer::invalid_argument("Invalid listener address: " + arg);
+      }
+      port_separator = bracket + 1;
+    }
+  } else {
+    port_separator = arg.find(':');
+    // more than one colon is an unbracketed IPv6 address with no port
+    if (port_separator != std::string::npos &&
+        arg.find(':', port_separator + 1) != std::string::npos) {
+      port_separator = std::string::npos;
+    }
+    listener.address = arg.substr(0, port_separator);
+  }
+
+  if (port_separator != std::string::npos) {
+    const auto port = std::stoi(arg.substr(port_separator + 1));
+    if (port <= 0 || port > UINT16_MAX) {
+      throw amdinfer::invalid_argument("Invalid listener port: " + arg);
+    }
+    listener.port = static_cast<uint16_t>(port);
+  }
+  return listener;
+}
+
 /**
  * @brief Parses command line options and starts amdinfer-server
  *
@@ -72,6 +127,15 @@ int main(int argc, char* argv[]) {
   bool repository_monitoring = false;
   bool use_polling_watcher = false;
   bool repository_load_existing = false;
+  bool repository_load_on_demand = false;
+  amdinfer::ModelCacheOptions model_cache;
+  size_t response_cache_size = kDefaultResponseCacheSize;
+  amdinfer::CompressionOptions compression;
+  bool disable_compression = false;
+#ifdef AMDINFER_ENABLE_HTTP
+  amdinfer::HttpOptions http_options;
+  std::vector<std::string> http_listeners;
+#endif
 
   try {
     cxxopts::Options options("amdinfer-server", "Inference in the cloud");
@@ -87,12 +151,51 @@ int main(int argc, char* argv[]) {
       cxxopts::value(repository_monitoring))
     ("use-polling-watcher", "Use polling to monitor model-repository directory",
       cxxopts::value(use_polling_watcher))
+    ("repository-load-on-demand",
+      "Load models from the model repository on the first request to them",
+      cxxopts::value(repository_load_on_demand))
+    ("repository-max-models",
+      "Unload idle models loaded on demand once more than this many are loaded. Zero means no limit",
+      cxxopts::value(model_cache.max_models))
+    ("repository-max-bytes",
+      "Unload idle models loaded on demand once their files exceed this many bytes. Zero means no limit",
+      cxxopts::value(model_cache.max_bytes))
+    ("response-cache-bytes",
+      "Bytes of responses cached for models loaded with response_cache. Zero disables caching",
+      cxxopts::value(response_cache_size))
 #ifdef AMDINFER_ENABLE_HTTP
     ("http-port", "Port to use for HTTP server", cxxopts::value(http_port))
+    ("http-threads",
+      "Number of IO threads for the HTTP server. If zero, use one per core",
+      cxxopts::value(http_options.threads))
+    ("http-listen",
+      "Address[:port] for the HTTP server to listen on. Can be repeated. Listeners without a port use http-port. Defaults to 0.0.0.0",
+      cxxopts::value(http_listeners))
+    ("http-keepalive-requests",
+      "Close HTTP connections after this many requests. Zero means no limit",
+      cxxopts::value(http_options.keepalive_requests))
+    ("http-pipelining-requests",
+      "Maximum pipelined HTTP requests per connection. Zero means no limit",
+      cxxopts::value(http_options.pipelining_requests))
+    ("http-idle-timeout",
+      "Close idle HTTP connections after this many seconds. Zero means never",
+      cxxopts::value(http_options.idle_timeout))
+    ("http-max-body-size", "Maximum size of HTTP request bodies in bytes",
+      cxxopts::value(http_options.max_body_size))
+    ("http-cors", "Allow cross-origin requests to the HTTP server",
+      cxxopts::value(http_options.cors))
 #endif
 #ifdef AMDINFER_ENABLE_GRPC
     ("grpc-port", "Port to use for gRPC server", cxxopts::value(grpc_port))
 #endif
+    ("compression-level",
+      "Level to compress responses with. A negative value uses the default",
+      cxxopts::value(compression.level))
+    ("compression-threshold",
+      "Minimum size in bytes of an HTTP response before it's compressed",
+      cxxopts::value(compression.threshold))
+    ("disable-compression", "Never compress responses",
+      cxxopts::value(disable_compression))
     ("help", "Print help");
     // clang-format on
 
@@ -102,12 +205,27 @@ int main(int argc, char* argv[]) {
       std::cout << options.help({""}) << "\n";
       exit(0);
     }
-  } catch (const cxxopts::OptionException& e) {
+
+#ifdef AMDINFER_ENABLE_HTTP
+    if (!http_listeners.empty()) {
+      http_options.listeners.clear();
+      for (const auto& listener : http_listeners) {
+        http_options.listeners.push_back(parseListener(listener));
+      }
+    }
+#endif
+  } catch (const std::exception& e) {
     std::cout << "Error parsing options: " << e.what() << "\n";
     exit(1);
   }
 
   amdinfer::Server server;
+  compression.enable = !disable_compression;
+  server.setCompression(compression);
+  server.setResponseCacheSize(response_cache_size);
+#ifdef AMDINFER_ENABLE_HTTP
+  server.setHttpOptions(http_options);
+#endif
 
   AMDINFER_IF_LOGGING(amdinfer::Logger logger{amdinfer::Loggers::Server};)
 
@@ -124,6 +242,10 @@ int main(int argc, char* argv[]) {
     server.enableRepositoryMonitoring(use_polling_watcher);
   }
 
+  if (repository_load_on_demand) {
+    server.enableModelCache(model_cache);
+  }
+
 #ifdef AMDINFER_ENABLE_GRPC
   std::cout << "gRPC server starting at port " << grpc_port << "\n";
   server.startGrpc(grpc_port);
@@ -147,6 +147,44 @@ Metrics::Metrics()
                          {{"direction", "input"}, {"stage", "buffer"}}},
                         {MetricGaugeIDs::QueuesBufferOutput,
                          {{"direction", "output"}, {"stage", "buffer"}}}}),
+    model_cache_total_(
+      "amdinfer_model_cache_total",
+      "Number of requests and evictions in the on-demand model cache",
+      registry_.get(),
+      {{MetricCounterIDs::ModelCacheHits, {{"event", "hit"}}},
+       {MetricCounterIDs::ModelCacheMisses, {{"event", "miss"}}},
+       {MetricCounterIDs::ModelCacheEvictions, {{"event", "eviction"}}}}),
+    model_cache_size_(
+      "amdinfer_model_cache_size",
+      "Size of the models loaded by the on-demand model cache",
+      registry_.get(),
+      {{MetricGaugeIDs::ModelCacheModels, {{"unit", "models"}}},
+       {MetricGaugeIDs::ModelCacheBytes, {{"unit", "bytes"}}}}),
+    autoscale_total_(
+      "amdinfer_autoscale_total",
+      "Number of workers added and retired by the autoscaler",
+      registry_.get(),
+      {{MetricCounterIDs::AutoscaleUp, {{"direction", "up"}}},
+       {MetricCounterIDs::AutoscaleDown, {{"direction", "down"}}}}),
+    batch_slots_total_(
+      "amdinfer_batch_slots_total",
+      "Number of slots in batches padded to a supported batch size that were "
+      "used by requests or padding",
+      registry_.get(),
+      {{MetricCounterIDs::BatchSlotsRequest, {{"slot", "request"}}},
+       {MetricCounterIDs::BatchSlotsPadding, {{"slot", "padding"}}}}),
+    requests_coalesced_total_(
+      "amdinfer_requests_coalesced_total",
+      "Number of requests that shared the response of an identical request "
+      "in flight",
+      registry_.get(), {{MetricCounterIDs::RequestsCoalesced, {}}}),
+    response_cache_total_(
+      "amdinfer_response_cache_total",
+      "Number of requests and evictions in the models' response caches",
+      registry_.get(),
+      {{MetricCounterIDs::ResponseCacheHits, {{"event", "hit"}}},
+       {MetricCounterIDs::ResponseCacheMisses, {{"event", "miss"}}},
+       {MetricCounterIDs::ResponseCacheEvictions, {{"event", "eviction"}}}}),
     metric_latency_("exposer_request_latencies",
                     "Latencies of serving scrape requests, in microseconds",
                     registry_.get(),
@@ -158,7 +196,14 @@ Metrics::Metrics()
                      registry_.get(),
                      {{MetricSummaryIDs::RequestLatency,
                        prometheus::Summary::Quantiles{
-                         kPercentile50, kPercentile90, kPercentile99}}}) {
+                         kPercentile50, kPercentile90, kPercentile99}}}),
+    warmup_latency_("amdinfer_warmup_latency",
+                    "Latencies of warmup batches sent to models as they load, "
+                    "in microseconds",
+                    registry_.get(),
+                    {{MetricSummaryIDs::WarmupLatency,
+                      prometheus::Summary::Quantiles{
+                        kPercentile50, kPercentile90, kPercentile99}}}) {
   std::lock_guard lock{this->collectables_mutex_};
   collectables_.push_back(this->registry_);
 
@@ -186,6 +231,27 @@ void Metrics::incrementCounter(MetricCounterIDs id, size_t increment) {
     case MetricCounterIDs::MetricScrapes:
       this->num_scrapes_.increment(id);
       break;
+    case MetricCounterIDs::ModelCacheHits:
+    case MetricCounterIDs::ModelCacheMisses:
+    case MetricCounterIDs::ModelCacheEvictions:
+      this->model_cache_total_.increment(id);
+      break;
+    case MetricCounterIDs::AutoscaleUp:
+    case MetricCounterIDs::AutoscaleDown:
+      this->autoscale_total_.increment(id);
+      break;
+    case MetricCounterIDs::BatchSlotsRequest:
+    case MetricCounterIDs::BatchSlotsPadding:
+      this->batch_slots_total_.increment(id, increment);
+      break;
+    case MetricCounterIDs::RequestsCoalesced:
+      this->requests_coalesced_total_.increment(id);
+      break;
+    case MetricCounterIDs::ResponseCacheHits:
+    case MetricCounterIDs::ResponseCacheMisses:
+    case MetricCounterIDs::ResponseCacheEvictions:
+      this->response_cache_total_.increment(id);
+      break;
     default:
       break;
   }
@@ -199,6 +265,10 @@ void Metrics::setGauge(MetricGaugeIDs id, double value) {
     case MetricGaugeIDs::QueuesBufferOutput:
       this->queue_sizes_total_.set(id, value);
       break;
+    case MetricGaugeIDs::ModelCacheModels:
+    case MetricGaugeIDs::ModelCacheBytes:
+      this->model_cache_size_.set(id, value);
+      break;
     default:
       break;
   }
@@ -212,6 +282,9 @@ void Metrics::observeSummary(MetricSummaryIDs id, double value) {
     case MetricSummaryIDs::RequestLatency:
       this->request_latency_.observe(id, value);
       break;
+    case MetricSummaryIDs::WarmupLatency:
+      this->warmup_latency_.observe(id, value);
+      break;
     default:
       break;
   }
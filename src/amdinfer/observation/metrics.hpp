@@ -58,6 +58,17 @@ enum class MetricCounterIDs {
   PipelineEgressWorker,
   TransferredBytes,
   MetricScrapes,
+  ModelCacheHits,
+  ModelCacheMisses,
+  ModelCacheEvictions,
+  AutoscaleUp,
+  AutoscaleDown,
+  BatchSlotsRequest,
+  BatchSlotsPadding,
+  RequestsCoalesced,
+  ResponseCacheHits,
+  ResponseCacheMisses,
+  ResponseCacheEvictions,
 };
 
 /// Defines the IDs of the tracked gauges
@@ -66,12 +77,15 @@ enum class MetricGaugeIDs {
   QueuesBatcherOutput,
   QueuesBufferInput,
   QueuesBufferOutput,
+  ModelCacheModels,
+  ModelCacheBytes,
 };
 
 /// Defines the IDs of the tracked summaries
 enum class MetricSummaryIDs {
   MetricLatency,
   RequestLatency,
+  WarmupLatency,
 };
 
 /**
@@ -229,8 +243,15 @@ class Metrics {
   CounterFamily bytes_transferred_;
   CounterFamily num_scrapes_;
   GaugeFamily queue_sizes_total_;
+  CounterFamily model_cache_total_;
+  GaugeFamily model_cache_size_;
+  CounterFamily autoscale_total_;
+  CounterFamily batch_slots_total_;
+  CounterFamily requests_coalesced_total_;
+  CounterFamily response_cache_total_;
   SummaryFamily metric_latency_;
   SummaryFamily request_latency_;
+  SummaryFamily warmup_latency_;
 };
 
 }  // namespace amdinfer
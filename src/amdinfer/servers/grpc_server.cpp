@@ -21,6 +21,7 @@
 #include "amdinfer/servers/grpc_server.hpp"
 
 #include <google/protobuf/repeated_ptr_field.h>  // for RepeatedPtrField
+#include <grpc/compression.h>                    // for grpc_compression_level
 #include <grpc/support/log.h>                    // for GPR_ASSERT, GPR_UNL...
 #include <grpcpp/grpcpp.h>                       // for ServerCompletionQueue
 
@@ -48,6 +49,7 @@
 #include "amdinfer/core/shared_state.hpp"        // for SharedState
 #include "amdinfer/declarations.hpp"             // for BufferRawPtrs, Infe...
 #include "amdinfer/observation/observer.hpp"     // for Logger, Loggers
+#include "amdinfer/servers/server.hpp"           // for CompressionOptions
 #include "amdinfer/util/containers.hpp"          // for containerProduct
 #include "amdinfer/util/string.hpp"              // for toLower
 #include "amdinfer/util/traits.hpp"              // IWYU pragma: keep
@@ -61,6 +63,7 @@ class CallDataModelLoad;
 class CallDataWorkerLoad;
 class CallDataModelReady;
 class CallDataModelUnload;
+class CallDataModelConfigure;
 class CallDataWorkerUnload;
 class CallDataServerLive;
 class CallDataServerMetadata;
@@ -520,6 +523,28 @@ CALLDATA_IMPL(ModelUnload, Unary) {
 }
 CALLDATA_IMPL_END
 
+CALLDATA_IMPL(ModelConfigure, Unary) {
+  auto parameters = mapProtoToParameters(request_.parameters());
+
+  auto* model = request_.mutable_name();
+  const auto& version = request_.version();
+  util::toLower(model);
+  try {
+    state_->modelConfigure(*model, version, parameters);
+  } catch (const invalid_argument& e) {
+    AMDINFER_LOG_ERROR(logger_, e.what());
+    finish(::grpc::Status(StatusCode::INVALID_ARGUMENT, e.what()));
+    return;
+  } catch (const std::exception& e) {
+    AMDINFER_LOG_ERROR(logger_, e.what());
+    finish(::grpc::Status(StatusCode::UNKNOWN, e.what()));
+    return;
+  }
+
+  finish(::grpc::Status::OK);
+}
+CALLDATA_IMPL_END
+
 CALLDATA_IMPL(WorkerLoad, Unary) {
   auto parameters = mapProtoToParameters(request_.parameters());
 
@@ -564,11 +589,26 @@ void CallDataModelInfer::handleRequest() noexcept {
   trace->startSpan("request_handler");
 #endif
 
+  std::string client;
+  const auto& metadata = ctx_.client_metadata();
+  if (auto found = metadata.find(kClientIdHeader); found != metadata.end()) {
+    client.assign(found->second.data(), found->second.size());
+  }
+
   try {
+    // requests over the model's rate limits are rejected before they're
+    // decoded
+    if (!state_->modelAdmit(model, version, client)) {
+      AMDINFER_LOG_INFO(logger_, "Rate limited request for " + model);
+      finish(::grpc::Status(StatusCode::RESOURCE_EXHAUSTED,
+                            "Too many requests for " + model));
+      return;
+    }
     auto request = amdinfer::getRequest(request_, state_->getPool());
     setCallback(request.get(), this);
     auto request_container = std::make_unique<RequestContainer>();
     request_container->request = request;
+    request_container->client = std::move(client);
 #ifdef AMDINFER_ENABLE_TRACING
     trace->endSpan();
     request_container->trace = std::move(trace);
@@ -583,16 +623,39 @@ void CallDataModelInfer::handleRequest() noexcept {
   }
 }
 
+/**
+ * @brief gRPC only exposes coarse compression levels so map the zlib-style
+ * 0-9 level to the closest one
+ *
+ * @param level the compression level
+ * @return grpc_compression_level
+ */
+grpc_compression_level toGrpcLevel(int level) {
+  constexpr auto kMaxLowLevel = 3;
+  constexpr auto kMaxMedLevel = 6;
+  if (level == 0) {
+    return GRPC_COMPRESS_LEVEL_NONE;
+  }
+  if (level <= kMaxLowLevel) {
+    return GRPC_COMPRESS_LEVEL_LOW;
+  }
+  if (level <= kMaxMedLevel) {
+    return GRPC_COMPRESS_LEVEL_MED;
+  }
+  return GRPC_COMPRESS_LEVEL_HIGH;
+}
+
 class GrpcServer final {
  public:
   /// Get the singleton GrpcServer instance
-  static GrpcServer& getInstance() { return create("", -1, nullptr); }
+  static GrpcServer& getInstance() { return create("", -1, nullptr, {}); }
 
   // using this singleton approach here because the start() method is state-
   // independent. The HTTP server is already global like this
   static GrpcServer& create(const std::string& address, const int cq_count,
-                            SharedState* state) {
-    static GrpcServer server(address, cq_count, state);
+                            SharedState* state,
+                            const CompressionOptions& compression) {
+    static GrpcServer server(address, cq_count, state, compression);
     return server;
   }
 
@@ -622,11 +685,18 @@ class GrpcServer final {
   }
 
  private:
-  GrpcServer(const std::string& address, const int cq_count, SharedState* state)
+  GrpcServer(const std::string& address, const int cq_count, SharedState* state,
+             const CompressionOptions& compression)
     : state_(state) {
     ServerBuilder builder;
     builder.SetMaxReceiveMessageSize(kMaxGrpcMessageSize);
     builder.SetMaxSendMessageSize(kMaxGrpcMessageSize);
+    // gRPC picks an algorithm that the client accepts for the chosen level
+    if (!compression.enable) {
+      builder.SetDefaultCompressionLevel(GRPC_COMPRESS_LEVEL_NONE);
+    } else if (compression.level >= 0) {
+      builder.SetDefaultCompressionLevel(toGrpcLevel(compression.level));
+    }
     // Listen on the given address without any authentication mechanism.
     builder.AddListeningPort(address, ::grpc::InsecureServerCredentials());
     // Register "service_" as the instance through which we'll communicate
@@ -659,6 +729,7 @@ class GrpcServer final {
     new CallDataModelReady(&service_, my_cq.get(), state_);
     new CallDataModelLoad(&service_, my_cq.get(), state_);
     new CallDataModelUnload(&service_, my_cq.get(), state_);
+    new CallDataModelConfigure(&service_, my_cq.get(), state_);
     new CallDataWorkerLoad(&service_, my_cq.get(), state_);
     new CallDataWorkerUnload(&service_, my_cq.get(), state_);
     new CallDataModelInfer(&service_, my_cq.get(), state_);
@@ -694,9 +765,10 @@ class GrpcServer final {
 
 namespace grpc {
 
-void start(SharedState* state, int port) {
+void start(SharedState* state, int port,
+           const CompressionOptions& compression) {
   const std::string address = "0.0.0.0:" + std::to_string(port);
-  GrpcServer::create(address, 1, state);
+  GrpcServer::create(address, 1, state, compression);
 }
 
 void stop() {
@@ -27,11 +27,12 @@
 
 namespace amdinfer {
 class SharedState;
-}
+struct CompressionOptions;
+}  // namespace amdinfer
 
 namespace amdinfer::grpc {
 
-void start(SharedState* state, int port);
+void start(SharedState* state, int port, const CompressionOptions& compression);
 void stop();
 
 }  // namespace amdinfer::grpc
@@ -25,9 +25,11 @@
 #include <json/value.h>               // for Value, arrayValue
 #include <trantor/utils/Logger.h>     // for Logger, Logger::Warn
 
+#include <algorithm>      // for min
 #include <chrono>         // for high_resolution_clock
 #include <memory>         // for shared_ptr, __share...
 #include <string>         // for allocator, operator+
+#include <string_view>    // for string_view
 #include <unordered_set>  // for unordered_set
 #include <utility>        // for move
 #include <vector>         // for vector
@@ -44,8 +46,12 @@
 #include "amdinfer/observation/logging.hpp"       // for Logger, AMDINFER_LOG...
 #include "amdinfer/observation/metrics.hpp"       // for Metrics, MetricCoun...
 #include "amdinfer/observation/tracing.hpp"       // for startTrace, Trace
+#include "amdinfer/servers/json_writer.hpp"       // for writeInferenceRes...
 #include "amdinfer/servers/websocket_server.hpp"  // for WebsocketServer
-#include "amdinfer/util/compression.hpp"          // for zDecompress
+#ifdef AMDINFER_ENABLE_SIMDJSON
+#include "amdinfer/servers/simdjson_request.hpp"  // for parseInferenceRequest
+#endif
+#include "amdinfer/util/compression.hpp"          // for decompress, Encoding
 #include "amdinfer/util/containers.hpp"           // for containerProduct
 #include "amdinfer/util/string.hpp"               // for toLower
 
@@ -58,8 +64,9 @@ namespace amdinfer {
 
 namespace http {
 
-void start(SharedState *state, uint16_t port) {
-  auto controller = std::make_shared<HttpServer>(state);
+void start(SharedState *state, uint16_t port, const HttpOptions &options,
+           const CompressionOptions &compression) {
+  auto controller = std::make_shared<HttpServer>(state, options, compression);
   auto ws_controller = std::make_shared<WebsocketServer>(state);
 
   auto &app = drogon::app();
@@ -72,14 +79,24 @@ void start(SharedState *state, uint16_t port) {
   app.setLogLevel(trantor::Logger::kFatal).setLogPath(".");
 #endif
 
-  app.addListener("0.0.0.0", port)
-    .setThreadNum(kDefaultDrogonThreads)
-    .registerPostHandlingAdvice([](const drogon::HttpRequestPtr &req,
-                                   const drogon::HttpResponsePtr &resp) {
+  for (const auto &listener : options.listeners) {
+    app.addListener(listener.address,
+                    listener.port == 0 ? port : listener.port);
+  }
+  // the advice runs on every response so only add it if it's needed
+  if (options.cors) {
+    app.registerPostHandlingAdvice([](const drogon::HttpRequestPtr &req,
+                                      const drogon::HttpResponsePtr &resp) {
       (void)req;  // suppress unused variable warning
       resp->addHeader("Access-Control-Allow-Origin", "*");
-    })
-    .setClientMaxBodySize(kMaxClientBodySize)
+    });
+  }
+
+  app.setThreadNum(options.threads)
+    .setKeepaliveRequestsNumber(options.keepalive_requests)
+    .setPipeliningRequestsNumber(options.pipelining_requests)
+    .setIdleConnectionTimeout(options.idle_timeout)
+    .setClientMaxBodySize(options.max_body_size)
     .disableSigtermHandling()
     // .enableRunAsDaemon()
     .run();
@@ -89,7 +106,37 @@ void stop() { drogon::app().quit(); }
 
 }  // namespace http
 
-std::shared_ptr<Json::Value> parseJson(const drogon::HttpRequest *req) {
+/**
+ * @brief Decompress a request body that was sent with a Content-Encoding
+ *
+ * @param encoding the encoding of the body
+ * @param body the compressed body
+ * @param max_size maximum allowed size of the decompressed body
+ * @return std::string the decompressed body
+ */
+std::string decompressBody(util::Encoding encoding, std::string_view body,
+                           size_t max_size) {
+  std::string decompressed;
+  // the hint comes from the client so clamp it to the maximum body size
+  const auto hint = util::decompressedSizeHint(encoding, body);
+  decompressed.reserve(std::min(hint, max_size));
+  util::decompress(encoding, body, max_size,
+                   [&decompressed](const char *data, size_t size) {
+                     decompressed.append(data, size);
+                   });
+  return decompressed;
+}
+
+/**
+ * @brief Parse the JSON body of a request. Bodies that aren't JSON are assumed
+ * to be zlib-compressed without a Content-Encoding, as older clients send them
+ *
+ * @param req the request
+ * @param max_size maximum allowed size of the decompressed body
+ * @return std::shared_ptr<Json::Value> the parsed body
+ */
+std::shared_ptr<Json::Value> parseJson(const drogon::HttpRequest *req,
+                                       size_t max_size) {
 #ifdef AMDINFER_ENABLE_LOGGING
   Logger logger{Loggers::Server};
 #endif
@@ -107,21 +154,26 @@ std::shared_ptr<Json::Value> parseJson(const drogon::HttpRequest *req) {
 
   std::string errors;
   Json::CharReaderBuilder builder;
-  Json::CharReader *reader = builder.newCharReader();
+  const std::unique_ptr<Json::CharReader> reader{builder.newCharReader()};
   auto body = req->getBody();
-  bool success =
-    reader->parse(body.data(), body.data() + body.size(), root.get(), &errors);
-  if (success) {
-    return root;
-  }
 
-  AMDINFER_LOG_DEBUG(logger, "Failed to interpret body as JSON data");
+  // Drogon has already tried (and failed) to parse a body that was labelled
+  // as JSON so don't parse it a second time
+  if (req->contentType() != drogon::CT_APPLICATION_JSON) {
+    bool success = reader->parse(body.data(), body.data() + body.size(),
+                                 root.get(), &errors);
+    if (success) {
+      return root;
+    }
+    AMDINFER_LOG_DEBUG(logger, "Failed to interpret body as JSON data");
+  }
 
   // if it's still not valid, attempt to uncompress the body and convert to JSON
-  auto body_decompress = util::zDecompress(body.data(), body.length());
-  success = reader->parse(body_decompress.data(),
-                          body_decompress.data() + body_decompress.size(),
-                          root.get(), &errors);
+  const auto body_decompress =
+    decompressBody(util::Encoding::Deflate, body, max_size);
+  bool success = reader->parse(body_decompress.data(),
+                               body_decompress.data() + body_decompress.size(),
+                               root.get(), &errors);
   if (success) {
     return root;
   }
@@ -129,29 +181,19 @@ std::shared_ptr<Json::Value> parseJson(const drogon::HttpRequest *req) {
   throw invalid_argument("Failed to interpret request body as JSON");
 }
 
-Json::Value parseResponse(InferenceResponse response) {
-  Json::Value ret;
-  ret["model_name"] = response.getModel();
-  ret["outputs"] = Json::arrayValue;
-  ret["id"] = response.getID();
-  auto outputs = response.getOutputs();
-  for (const InferenceResponseOutput &output : outputs) {
-    Json::Value json_output;
-    json_output["name"] = output.getName();
-    json_output["parameters"] = Json::objectValue;
-    json_output["data"] = Json::arrayValue;
-    json_output["shape"] = Json::arrayValue;
-    json_output["datatype"] = output.getDatatype().str();
-    const auto &shape = output.getShape();
-    for (const auto &index : shape) {
-      json_output["shape"].append(static_cast<Json::UInt>(index));
-    }
+std::shared_ptr<Json::Value> parseJson(std::string_view body) {
+  auto root = std::make_shared<Json::Value>();
 
-    switchOverTypes(SetInputData(), output.getDatatype(),
-                    &(json_output["data"]), output.getData(), output.getSize());
-    ret["outputs"].append(json_output);
+  std::string errors;
+  Json::CharReaderBuilder builder;
+  const std::unique_ptr<Json::CharReader> reader{builder.newCharReader()};
+  bool success = reader->parse(body.data(), body.data() + body.size(),
+                               root.get(), &errors);
+  if (success) {
+    return root;
   }
-  return ret;
+
+  throw invalid_argument("Failed to interpret request body as JSON");
 }
 
 struct WriteData {
@@ -175,7 +217,11 @@ drogon::HttpResponsePtr errorHttpResponse(const std::string &error,
   return resp;
 }
 
-HttpServer::HttpServer(SharedState *state) : state_(state) {
+HttpServer::HttpServer(SharedState *state, const HttpOptions &options,
+                       const CompressionOptions &compression)
+  : state_(state),
+    max_body_size_(options.max_body_size),
+    compression_(compression) {
   AMDINFER_LOG_DEBUG(logger_, "Constructed HttpServer");
 }
 
@@ -413,17 +459,29 @@ InferenceRequestOutput getOutput(const Json::Value &json) {
   return output;
 }
 
-void setCallback(InferenceRequest *request, DrogonCallback &&drogon_callback) {
-  Callback callback = [callback = std::move(drogon_callback)](
-                        const InferenceResponse &response) {
+void setCallback(InferenceRequest *request, DrogonCallback &&drogon_callback,
+                 util::Encoding encoding,
+                 const CompressionOptions &compression) {
+  Callback callback = [callback = std::move(drogon_callback), encoding,
+                       compression](const InferenceResponse &response) {
     drogon::HttpResponsePtr resp;
     if (response.isError()) {
       resp =
         errorHttpResponse(response.getError(), HttpStatusCode::k400BadRequest);
     } else {
       try {
-        Json::Value ret = parseResponse(response);
-        resp = drogon::HttpResponse::newHttpJsonResponse(ret);
+        resp = drogon::HttpResponse::newHttpResponse();
+        resp->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+        auto body = writeInferenceResponse(response);
+        if (compression.enable && encoding != util::Encoding::Identity &&
+            body.size() >= compression.threshold) {
+          body = util::compress(encoding, body, compression.level);
+          resp->addHeader("Content-Encoding",
+                          std::string{util::toString(encoding)});
+        }
+        // the body may vary between clients for the same request
+        resp->addHeader("Vary", "Accept-Encoding");
+        resp->setBody(std::move(body));
       } catch (const invalid_argument &e) {
         resp = errorHttpResponse(e.what(), HttpStatusCode::k400BadRequest);
       }
@@ -485,7 +543,8 @@ InferenceRequestPtr getRequest(const std::shared_ptr<Json::Value> &json,
 
 void modelInfer(const HttpRequestPtr &req, DrogonCallback &&callback,
                 SharedState *state, const std::string &endpoint,
-                const std::string &version) {
+                const std::string &version,
+                const CompressionOptions &compression, size_t max_body_size) {
 #ifdef AMDINFER_ENABLE_TRACING
   const auto &drogon_headers = req->getHeaders();
   StringMap headers{drogon_headers.begin(), drogon_headers.end()};
@@ -504,12 +563,60 @@ void modelInfer(const HttpRequestPtr &req, DrogonCallback &&callback,
   trace->startSpan("request_handler");
 #endif
 
-  auto json = req->getJsonObject();
+  // requests over the model's rate limits are rejected before they're decoded
+  const auto &client = req->getHeader(kClientIdHeader);
+  if (!state->modelAdmit(endpoint, version, client)) {
+    AMDINFER_LOG_INFO(logger, "Rate limited request for " + endpoint);
+    callback(errorHttpResponse("Too many requests for " + endpoint,
+                               HttpStatusCode::k429TooManyRequests));
+    return;
+  }
+
+  auto content_encoding = util::Encoding::Identity;
   try {
-    auto request = getRequest(json, state->getPool());
-    setCallback(request.get(), std::move(callback));
+    content_encoding =
+      util::parseContentEncoding(req->getHeader("content-encoding"));
+  } catch (const invalid_argument &e) {
+    AMDINFER_LOG_INFO(logger, e.what());
+    callback(errorHttpResponse(e.what(),
+                               HttpStatusCode::k415UnsupportedMediaType));
+    return;
+  }
+  const auto accept_encoding =
+    util::negotiateEncoding(req->getHeader("accept-encoding"));
+
+  try {
+    InferenceRequestPtr request;
+    if (content_encoding != util::Encoding::Identity) {
+      const auto body =
+        decompressBody(content_encoding, req->getBody(), max_body_size);
+#ifdef AMDINFER_ENABLE_SIMDJSON
+      request = parseInferenceRequest(body, state->getPool());
+#else
+      request = getRequest(parseJson(body), state->getPool());
+#endif
+    } else {
+#ifdef AMDINFER_ENABLE_SIMDJSON
+      auto body = req->getBody();
+      // match parseJson's fallback for compressed bodies
+      std::string body_decompress;
+      const auto first = body.find_first_not_of(" \t\r\n");
+      if (first != std::string_view::npos && body[first] != '{') {
+        body_decompress =
+          decompressBody(util::Encoding::Deflate, body, max_body_size);
+        body = body_decompress;
+      }
+      request = parseInferenceRequest(body, state->getPool());
+#else
+      auto json = parseJson(req.get(), max_body_size);
+      request = getRequest(json, state->getPool());
+#endif
+    }
+    setCallback(request.get(), std::move(callback), accept_encoding,
+                compression);
     auto request_container = std::make_unique<RequestContainer>();
     request_container->request = request;
+    request_container->client = client;
 #ifdef AMDINFER_ENABLE_METRICS
     request_container->start_time = now;
 #endif
@@ -533,14 +640,16 @@ void modelInfer(const HttpRequestPtr &req, DrogonCallback &&callback,
 void HttpServer::modelInfer(const HttpRequestPtr &req,
                             DrogonCallback &&callback,
                             const std::string &model) const {
-  amdinfer::modelInfer(req, std::move(callback), state_, model, "");
+  amdinfer::modelInfer(req, std::move(callback), state_, model, "",
+                       compression_, max_body_size_);
 }
 
 void HttpServer::modelInferVersion(const HttpRequestPtr &req,
                                    DrogonCallback &&callback,
                                    const std::string &model,
                                    const std::string &version) const {
-  amdinfer::modelInfer(req, std::move(callback), state_, model, version);
+  amdinfer::modelInfer(req, std::move(callback), state_, model, version,
+                       compression_, max_body_size_);
 }
 
 void modelLoad(const HttpRequestPtr &req, DrogonCallback &&callback,
@@ -597,6 +706,58 @@ void HttpServer::modelLoadVersion(const HttpRequestPtr &req,
   amdinfer::modelLoad(req, std::move(callback), state_, model, version);
 }
 
+void modelConfigure(const HttpRequestPtr &req, DrogonCallback &&callback,
+                    SharedState *state, const std::string &model,
+                    const std::string &version) {
+  auto model_lower = util::toLower(model);
+#ifdef AMDINFER_ENABLE_TRACING
+  const auto &drogon_headers = req->getHeaders();
+  StringMap headers{drogon_headers.begin(), drogon_headers.end()};
+  auto trace = startTrace(&(__func__[0]), headers);
+  trace->setAttribute("model", model_lower);
+#endif
+  AMDINFER_IF_LOGGING(Logger logger{Loggers::Server});
+  AMDINFER_LOG_INFO(logger,
+                    "Received modelConfigure request for " + model_lower);
+
+  auto json = req->getJsonObject();
+  ParameterMap parameters;
+  if (json != nullptr) {
+    parameters = mapJsonToParameters(*json);
+  }
+#ifdef AMDINFER_ENABLE_TRACING
+  trace->setAttributes(parameters);
+#endif
+
+  HttpResponsePtr resp;
+  try {
+    state->modelConfigure(model_lower, version, parameters);
+    resp = HttpResponse::newHttpResponse();
+  } catch (const runtime_error &e) {
+    AMDINFER_LOG_ERROR(logger, e.what());
+    resp = errorHttpResponse(e.what(), HttpStatusCode::k400BadRequest);
+  }
+
+#ifdef AMDINFER_ENABLE_TRACING
+  auto context = trace->propagate();
+  propagate(resp.get(), context);
+#endif
+  callback(resp);
+}
+
+void HttpServer::modelConfigure(const HttpRequestPtr &req,
+                                DrogonCallback &&callback,
+                                const std::string &model) const {
+  amdinfer::modelConfigure(req, std::move(callback), state_, model, "");
+}
+
+void HttpServer::modelConfigureVersion(const HttpRequestPtr &req,
+                                       DrogonCallback &&callback,
+                                       const std::string &model,
+                                       const std::string &version) const {
+  amdinfer::modelConfigure(req, std::move(callback), state_, model, version);
+}
+
 void modelUnload([[maybe_unused]] const HttpRequestPtr &req,
                  DrogonCallback &&callback, SharedState *state,
                  const std::string &endpoint, const std::string &version) {
@@ -28,6 +28,7 @@
 #include "amdinfer/build_options.hpp"  // for AMDINFER_ENABLE_HTTP, PROT...
 #include "amdinfer/core/request_container.hpp"  // for InferenceRequestBuilder
 #include "amdinfer/observation/logging.hpp"     // for LoggerPtr
+#include "amdinfer/servers/server.hpp"          // for CompressionOptions
 
 #ifdef AMDINFER_ENABLE_HTTP
 #include <drogon/HttpController.h>  // for ADD_METHOD_TO, HttpContro...
@@ -55,8 +56,15 @@ using DrogonCallback = std::function<void(const drogon::HttpResponsePtr &)>;
  */
 class HttpServer : public drogon::HttpController<HttpServer, false> {
  public:
-  /// Constructor
-  explicit HttpServer(SharedState *state);
+  /**
+   * @brief Construct a new HttpServer object
+   *
+   * @param state the server's shared state
+   * @param options options for handling connections
+   * @param compression options for compressing responses
+   */
+  HttpServer(SharedState *state, const HttpOptions &options,
+             const CompressionOptions &compression);
 
   METHOD_LIST_BEGIN
 
@@ -85,6 +93,11 @@ class HttpServer : public drogon::HttpController<HttpServer, false> {
   ADD_METHOD_TO(HttpServer::modelInferVersion,
                 "v2/models/{model}/versions/{version}/infer", drogon::Post,
                 drogon::Options);
+  ADD_METHOD_TO(HttpServer::modelConfigure, "v2/models/{model}/configure",
+                drogon::Post, drogon::Options);
+  ADD_METHOD_TO(HttpServer::modelConfigureVersion,
+                "v2/models/{model}/versions/{version}/configure", drogon::Post,
+                drogon::Options);
   ADD_METHOD_TO(HttpServer::modelLoad, "v2/repository/models/{model}/load",
                 drogon::Post, drogon::Options);
   ADD_METHOD_TO(HttpServer::modelLoadVersion,
@@ -261,6 +274,30 @@ class HttpServer : public drogon::HttpController<HttpServer, false> {
                           DrogonCallback &&callback, const std::string &model,
                           const std::string &version) const;
 
+  /**
+   * @brief Changes the batching parameters and worker count of a loaded model
+   *
+   * @param req the REST request object
+   * @param callback the callback function to respond to the client
+   * @param model name of the model to change
+   */
+  void modelConfigure(const drogon::HttpRequestPtr &req,
+                      DrogonCallback &&callback,
+                      const std::string &model) const;
+
+  /**
+   * @brief Changes the batching parameters and worker count of a loaded model
+   *
+   * @param req the REST request object
+   * @param callback the callback function to respond to the client
+   * @param model name of the model to change
+   * @param version version of the model to change
+   */
+  void modelConfigureVersion(const drogon::HttpRequestPtr &req,
+                             DrogonCallback &&callback,
+                             const std::string &model,
+                             const std::string &version) const;
+
   /**
    * @brief Loads and starts a worker
    *
@@ -293,6 +330,8 @@ class HttpServer : public drogon::HttpController<HttpServer, false> {
 #endif
  private:
   SharedState *state_;
+  size_t max_body_size_;
+  CompressionOptions compression_;
 #ifdef AMDINFER_ENABLE_LOGGING
   Logger logger_{Loggers::Server};
 #endif
@@ -305,9 +344,12 @@ namespace http {
 /**
  * @brief Start the HTTP REST server
  *
- * @param port the port to use for the server
+ * @param port the port to use for listeners that don't specify one
+ * @param options options for handling connections
+ * @param compression options for compressing responses
  */
-void start(SharedState *state, uint16_t port);
+void start(SharedState *state, uint16_t port, const HttpOptions &options,
+           const CompressionOptions &compression);
 
 /// Stop the REST server
 void stop();
@@ -0,0 +1,233 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements a direct-to-buffer JSON writer for inference responses
+ */
+
+#include "amdinfer/servers/json_writer.hpp"
+
+#include <array>         // for array
+#include <charconv>      // for to_chars
+#include <cmath>         // for isnan, isinf
+#include <cstdint>       // for uint8_t, int8_t...
+#include <limits>        // for numeric_limits
+#include <type_traits>   // for is_same_v, conditional_t
+#include <utility>       // for move
+
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/util/traits.hpp"              // for is_any_v
+
+namespace amdinfer {
+
+namespace {
+
+// long enough for the shortest round-trip representation of any double
+constexpr auto kMaxNumberLength = 32;
+
+/**
+ * @brief Maximum number of characters needed to print one element of the type,
+ * not including the separator
+ */
+struct MaxElementLength {
+  template <typename T>
+  size_t operator()() const {
+    if constexpr (std::is_same_v<T, bool>) {
+      return 5;  // false
+    } else if constexpr (util::is_any_v<T, fp16, float>) {
+      return 15;  // -1.17549435e-38
+    } else if constexpr (std::is_same_v<T, double>) {
+      return 24;  // -2.2250738585072014e-308
+    } else if constexpr (std::is_same_v<T, char>) {
+      return 1;
+    } else {
+      // digits10 is one less than the max number of digits
+      return std::numeric_limits<T>::digits10 + 1 +
+             static_cast<size_t>(std::is_signed_v<T>);
+    }
+  }
+};
+
+struct WriteArray {
+  template <typename T>
+  void operator()(std::string* buffer, const void* data, size_t size) const {
+    const auto* typed = static_cast<const T*>(data);
+    std::array<char, kMaxNumberLength> chars{};
+
+    for (size_t i = 0; i < size; ++i) {
+      if (i != 0) {
+        buffer->push_back(',');
+      }
+      if constexpr (std::is_same_v<T, bool>) {
+        buffer->append(typed[i] ? "true" : "false");
+      } else {
+        std::to_chars_result result;
+        if constexpr (util::is_any_v<T, fp16, float, double>) {
+          using Float =
+            std::conditional_t<std::is_same_v<T, double>, double, float>;
+          const auto value = static_cast<Float>(typed[i]);
+          // JSON has no representation for these so match jsoncpp's defaults
+          if (std::isnan(value)) {
+            buffer->append("null");
+            continue;
+          }
+          if (std::isinf(value)) {
+            buffer->append(value < 0 ? "-1e+9999" : "1e+9999");
+            continue;
+          }
+          result = std::to_chars(chars.begin(), chars.end(), value);
+        } else if constexpr (util::is_any_v<T, int8_t, uint8_t>) {
+          // print as numbers and not as characters
+          result = std::to_chars(chars.begin(), chars.end(),
+                                 static_cast<int>(typed[i]));
+        } else {
+          result = std::to_chars(chars.begin(), chars.end(), typed[i]);
+        }
+        buffer->append(chars.data(), result.ptr);
+      }
+    }
+  }
+};
+
+}  // namespace
+
+JsonWriter::JsonWriter(size_t reserve) { buffer_.reserve(reserve); }
+
+void JsonWriter::raw(std::string_view json) { buffer_.append(json); }
+
+void JsonWriter::string(std::string_view str) {
+  constexpr std::array<char, 16> kHex{'0', '1', '2', '3', '4', '5', '6', '7',
+                                      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+  buffer_.push_back('"');
+  size_t start = 0;
+  for (size_t i = 0; i < str.size(); ++i) {
+    const auto c = static_cast<uint8_t>(str[i]);
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    // flush the run of characters that didn't need escaping
+    buffer_.append(str.substr(start, i - start));
+    start = i + 1;
+    switch (c) {
+      case '"':
+        buffer_.append("\\\"");
+        break;
+      case '\\':
+        buffer_.append("\\\\");
+        break;
+      case '\n':
+        buffer_.append("\\n");
+        break;
+      case '\r':
+        buffer_.append("\\r");
+        break;
+      case '\t':
+        buffer_.append("\\t");
+        break;
+      default: {
+        const std::array<char, 6> escaped{'\\', 'u', '0', '0', kHex.at(c >> 4),
+                                          kHex.at(c & 0xF)};
+        buffer_.append(escaped.data(), escaped.size());
+      }
+    }
+  }
+  buffer_.append(str.substr(start));
+  buffer_.push_back('"');
+}
+
+void JsonWriter::key(std::string_view key) {
+  this->string(key);
+  buffer_.push_back(':');
+}
+
+void JsonWriter::comma() { buffer_.push_back(','); }
+
+void JsonWriter::array(DataType type, const void* data, size_t size) {
+  buffer_.push_back('[');
+  if (type == DataType::Bytes) {
+    // string data is sent as a single string element
+    this->string({static_cast<const char*>(data), size});
+  } else {
+    switchOverTypes(WriteArray(), type, &buffer_, data, size);
+  }
+  buffer_.push_back(']');
+}
+
+const std::string& JsonWriter::str() const& { return buffer_; }
+
+std::string JsonWriter::str() && { return std::move(buffer_); }
+
+size_t estimateJsonSize(DataType type, size_t size) {
+  // brackets + one separator per element
+  return 2 + size * (switchOverTypes(MaxElementLength(), type) + 1);
+}
+
+std::string writeInferenceResponse(const InferenceResponse& response) {
+  // fixed keys and punctuation for the response and each output
+  constexpr auto kResponseOverhead = 64;
+  constexpr auto kOutputOverhead = 96;
+  constexpr auto kMaxShapeLength = 21;
+
+  const auto model = response.getModel();
+  const auto id = response.getID();
+  const auto& outputs = response.getOutputs();
+
+  size_t reserve = kResponseOverhead + model.size() + id.size();
+  for (const auto& output : outputs) {
+    reserve += kOutputOverhead + output.getName().size() +
+               output.getShape().size() * kMaxShapeLength +
+               estimateJsonSize(output.getDatatype(), output.getSize());
+  }
+
+  JsonWriter writer{reserve};
+  writer.raw("{");
+  writer.key("model_name");
+  writer.string(model);
+  writer.comma();
+  writer.key("outputs");
+  writer.raw("[");
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    const auto& output = outputs[i];
+    if (i != 0) {
+      writer.comma();
+    }
+    writer.raw("{");
+    writer.key("name");
+    writer.string(output.getName());
+    writer.comma();
+    writer.key("parameters");
+    writer.raw("{}");
+    writer.comma();
+    writer.key("data");
+    writer.array(output.getDatatype(), output.getData(), output.getSize());
+    writer.comma();
+    writer.key("shape");
+    const auto& shape = output.getShape();
+    writer.array(DataType::Int64, shape.data(), shape.size());
+    writer.comma();
+    writer.key("datatype");
+    writer.string(output.getDatatype().str());
+    writer.raw("}");
+  }
+  writer.raw("]");
+  writer.comma();
+  writer.key("id");
+  writer.string(id);
+  writer.raw("}");
+
+  return std::move(writer).str();
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,95 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines a direct-to-buffer JSON writer for inference responses
+ */
+
+#ifndef GUARD_AMDINFER_SERVERS_JSON_WRITER
+#define GUARD_AMDINFER_SERVERS_JSON_WRITER
+
+#include <cstddef>      // for size_t
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+#include "amdinfer/core/data_types.hpp"  // for DataType
+#include "amdinfer/declarations.hpp"     // for InferenceResponse
+
+namespace amdinfer {
+
+/**
+ * @brief Appends JSON tokens directly to a string. The writer does not build
+ * an intermediate tree and does no validation of the structure: the caller is
+ * responsible for balancing objects/arrays and adding separators.
+ */
+class JsonWriter {
+ public:
+  /**
+   * @brief Construct a new JsonWriter object
+   *
+   * @param reserve number of bytes to reserve in the output up front
+   */
+  explicit JsonWriter(size_t reserve = 0);
+
+  /// Append raw, already-valid JSON
+  void raw(std::string_view json);
+  /// Append a quoted and escaped string
+  void string(std::string_view str);
+  /// Append the key of a key-value pair, including the trailing colon
+  void key(std::string_view key);
+  /// Append a comma
+  void comma();
+
+  /**
+   * @brief Append a JSON array of numbers (or booleans) from raw tensor data.
+   * Floating point values use the shortest representation that round-trips.
+   *
+   * @param type the type of the data
+   * @param data pointer to the data
+   * @param size number of elements
+   */
+  void array(DataType type, const void* data, size_t size);
+
+  /// Get the written JSON
+  [[nodiscard]] const std::string& str() const&;
+  /// Move the written JSON out of the writer
+  std::string str() &&;
+
+ private:
+  std::string buffer_;
+};
+
+/**
+ * @brief Estimate the number of bytes needed to write a tensor's data as a
+ * JSON array. The estimate is an upper bound for numeric types.
+ *
+ * @param type the type of the data
+ * @param size number of elements
+ * @return size_t
+ */
+size_t estimateJsonSize(DataType type, size_t size);
+
+/**
+ * @brief Serialize an inference response to JSON according to the KServe v2
+ * spec
+ *
+ * @param response the response to serialize
+ * @return std::string
+ */
+std::string writeInferenceResponse(const InferenceResponse& response);
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_SERVERS_JSON_WRITER
@@ -93,7 +93,9 @@ Server::~Server() {
 void Server::startHttp([[maybe_unused]] uint16_t port) const {
 #ifdef AMDINFER_ENABLE_HTTP
   if (!impl_->http_started) {
-    impl_->http_thread = std::thread{http::start, &(impl_->state), port};
+    impl_->http_thread =
+      std::thread{http::start, &(impl_->state), port, impl_->http,
+                  impl_->compression};
     impl_->http_started = true;
   }
 #endif
@@ -114,7 +116,7 @@ void Server::stopHttp() const {
 void Server::startGrpc([[maybe_unused]] uint16_t port) const {
 #ifdef AMDINFER_ENABLE_GRPC
   if (!impl_->grpc_started) {
-    grpc::start(&(impl_->state), port);
+    grpc::start(&(impl_->state), port, impl_->compression);
     impl_->grpc_started = true;
   }
 #endif
@@ -129,6 +131,14 @@ void Server::stopGrpc() const {
 #endif
 }
 
+void Server::setCompression(const CompressionOptions& options) {
+  impl_->compression = options;
+}
+
+void Server::setHttpOptions(const HttpOptions& options) {
+  impl_->http = options;
+}
+
 void Server::setModelRepository(const fs::path& repository_path,
                                 bool load_existing) {
   impl_->state.setRepository(repository_path, load_existing);
@@ -138,4 +148,12 @@ void Server::enableRepositoryMonitoring(bool use_polling) {
   impl_->state.enableRepositoryMonitoring(use_polling);
 }
 
+void Server::enableModelCache(const ModelCacheOptions& options) {
+  impl_->state.enableModelCache(options.max_models, options.max_bytes);
+}
+
+void Server::setResponseCacheSize(size_t max_bytes) {
+  impl_->state.setResponseCacheSize(max_bytes);
+}
+
 }  // namespace amdinfer
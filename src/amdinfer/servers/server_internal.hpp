@@ -33,6 +33,8 @@ struct Server::ServerImpl {
 #ifdef AMDINFER_ENABLE_GRPC
   bool grpc_started = false;
 #endif
+  CompressionOptions compression;
+  HttpOptions http;
   SharedState state;
 };
 
@@ -0,0 +1,260 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements the simdjson-based parser for HTTP inference requests
+ */
+
+#include "amdinfer/servers/simdjson_request.hpp"
+
+#include <simdjson.h>  // for ondemand, padded_string, simdjson_error
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t, uint64_t
+#include <cstring>      // for memcpy
+#include <limits>       // for numeric_limits
+#include <memory>       // for make_shared
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <type_traits>  // for is_same_v, is_unsigned_v
+#include <vector>       // for vector
+
+#include "amdinfer/buffers/buffer.hpp"          // for Buffer
+#include "amdinfer/core/data_types.hpp"         // for DataType, switchOverTypes
+#include "amdinfer/core/exceptions.hpp"         // for invalid_argument
+#include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
+#include "amdinfer/core/memory_pool/pool.hpp"   // for MemoryPool
+#include "amdinfer/core/parameters.hpp"         // for ParameterMap
+#include "amdinfer/util/traits.hpp"             // for is_any_v
+
+namespace amdinfer {
+
+namespace ondemand = simdjson::ondemand;
+
+namespace {
+
+ParameterMap parseParameters(ondemand::value value) {
+  ParameterMap parameters;
+  for (auto field : value.get_object()) {
+    std::string key{field.unescaped_key().value()};
+    auto datum = field.value();
+    switch (datum.type()) {
+      case ondemand::json_type::string:
+        parameters.put(key, std::string{datum.get_string().value()});
+        break;
+      case ondemand::json_type::boolean:
+        parameters.put(key, static_cast<bool>(datum.get_bool()));
+        break;
+      case ondemand::json_type::number: {
+        // like mapJsonToParameters, non-negative integers are ints and
+        // everything else is a double. Integers too large for an int are
+        // doubles too, where mapJsonToParameters rejects those up to UINT_MAX
+        ondemand::number number = datum.get_number();
+        if (number.is_int64() && number.get_int64() >= 0 &&
+            number.get_int64() <= std::numeric_limits<int>::max()) {
+          parameters.put(key, static_cast<int>(number.get_int64()));
+        } else {
+          parameters.put(key, number.as_double());
+        }
+        break;
+      }
+      default:
+        throw invalid_argument("Unknown parameter type, skipping");
+    }
+  }
+  return parameters;
+}
+
+struct StreamData {
+  template <typename T>
+  void operator()(ondemand::array* array, std::byte* dst,
+                  size_t capacity) const {
+    size_t offset = 0;
+    if constexpr (std::is_same_v<T, char>) {
+      for (auto element : *array) {
+        std::string_view str = element.get_string();
+        if (offset + str.size() > capacity) {
+          throw invalid_argument("'data' is larger than the declared shape");
+        }
+        std::memcpy(dst + offset, str.data(), str.size());
+        offset += str.size();
+        if (offset < capacity) {
+          dst[offset++] = std::byte{0};
+        }
+      }
+    } else {
+      auto* typed = reinterpret_cast<T*>(dst);
+      const auto count = capacity / sizeof(T);
+      size_t index = 0;
+      for (auto element : *array) {
+        if (index == count) {
+          throw invalid_argument("'data' is larger than the declared shape");
+        }
+        if constexpr (std::is_same_v<T, bool>) {
+          typed[index] = element.get_bool();
+        } else if constexpr (std::is_same_v<T, double>) {
+          typed[index] = element.get_double();
+        } else if constexpr (util::is_any_v<T, fp16, float>) {
+          typed[index] =
+            static_cast<T>(static_cast<float>(element.get_double().value()));
+        } else if constexpr (std::is_unsigned_v<T>) {
+          typed[index] = static_cast<T>(element.get_uint64().value());
+        } else {
+          typed[index] = static_cast<T>(element.get_int64().value());
+        }
+        ++index;
+      }
+    }
+  }
+};
+
+InferenceRequestInput parseInput(ondemand::object object,
+                                 const MemoryPool* pool) {
+  InferenceRequestInput input;
+  input.setData(nullptr);
+
+  // find_field_unordered lets clients send keys in any order while still only
+  // moving forward through the document for the common KServe ordering
+  ondemand::value value;
+  if (object.find_field_unordered("name").get(value) != simdjson::SUCCESS) {
+    throw invalid_argument("No 'name' key present in request input");
+  }
+  input.setName(std::string{value.get_string().value()});
+
+  if (object.find_field_unordered("shape").get(value) != simdjson::SUCCESS) {
+    throw invalid_argument("No 'shape' key present in request input");
+  }
+  std::vector<int64_t> shape;
+  for (auto index : value.get_array()) {
+    uint64_t dim = 0;
+    if (index.get_uint64().get(dim) != simdjson::SUCCESS) {
+      throw invalid_argument("'shape' must be specified by uint64 elements");
+    }
+    shape.push_back(static_cast<int64_t>(dim));
+  }
+  input.setShape(shape);
+
+  if (object.find_field_unordered("datatype").get(value) !=
+      simdjson::SUCCESS) {
+    throw invalid_argument("No 'datatype' key present in request input");
+  }
+  std::string datatype{value.get_string().value()};
+  input.setDatatype(DataType(datatype.c_str()));
+
+  if (object.find_field_unordered("data").get(value) != simdjson::SUCCESS) {
+    throw invalid_argument("No 'data' key present in request input");
+  }
+  auto buffer = pool->get({MemoryAllocators::Cpu}, input, 1);
+  auto* dst = static_cast<std::byte*>(buffer->data(0));
+  input.setData(dst);
+  try {
+    auto array = value.get_array().value();
+    switchOverTypes(StreamData(), input.getDatatype(), &array, dst,
+                    input.getSize() * input.getDatatype().size());
+
+    // parameters are looked up last so the lookup doesn't skip over "data"
+    if (object.find_field_unordered("parameters").get(value) ==
+        simdjson::SUCCESS) {
+      input.setParameters(parseParameters(value));
+    }
+  } catch (const simdjson::simdjson_error&) {
+    pool->put(MemoryAllocators::Cpu, dst);
+    throw invalid_argument(
+      "Could not convert some data to the provided data type");
+  } catch (...) {
+    pool->put(MemoryAllocators::Cpu, dst);
+    throw;
+  }
+
+  return input;
+}
+
+InferenceRequestOutput parseOutput(ondemand::object object) {
+  InferenceRequestOutput output;
+  output.setData(nullptr);
+  for (auto field : object) {
+    auto key = field.unescaped_key().value();
+    if (key == "name") {
+      output.setName(std::string{field.value().get_string().value()});
+    } else if (key == "parameters") {
+      output.setParameters(parseParameters(field.value()));
+    }
+  }
+  return output;
+}
+
+}  // namespace
+
+InferenceRequestPtr parseInferenceRequest(std::string_view body,
+                                          const MemoryPool* pool) {
+  // the parser reuses its internal buffers between documents so keep one per
+  // server thread rather than allocating it per request
+  thread_local ondemand::parser parser;
+
+  auto request = std::make_shared<InferenceRequest>();
+  request->setID("");
+  request->setCallback(nullptr);
+
+  bool has_inputs = false;
+  try {
+    const simdjson::padded_string padded{body};
+    auto document = parser.iterate(padded);
+    for (auto field : document.get_object()) {
+      auto key = field.unescaped_key().value();
+      if (key == "id") {
+        request->setID(field.value().get_string().value());
+      } else if (key == "parameters") {
+        request->setParameters(parseParameters(field.value()));
+      } else if (key == "inputs") {
+        ondemand::array inputs;
+        if (field.value().get_array().get(inputs) != simdjson::SUCCESS) {
+          throw invalid_argument("'inputs' is not an array");
+        }
+        for (auto input : inputs) {
+          ondemand::object object;
+          if (input.get_object().get(object) != simdjson::SUCCESS) {
+            throw invalid_argument(
+              "At least one element in 'inputs' is not an obj");
+          }
+          request->addInputTensor(parseInput(object, pool));
+        }
+        has_inputs = true;
+      } else if (key == "outputs") {
+        for (auto output : field.value().get_array()) {
+          request->addOutputTensor(parseOutput(output.get_object()));
+        }
+      }
+    }
+    if (!has_inputs) {
+      throw invalid_argument("No 'inputs' key present in request");
+    }
+  } catch (const simdjson::simdjson_error& e) {
+    for (const auto& input : request->getInputs()) {
+      pool->put(MemoryAllocators::Cpu, input.getData());
+    }
+    throw invalid_argument(std::string{"Failed to parse request: "} +
+                           e.what());
+  } catch (...) {
+    // any error, not just a bad request, returns the inputs' buffers
+    for (const auto& input : request->getInputs()) {
+      pool->put(MemoryAllocators::Cpu, input.getData());
+    }
+    throw;
+  }
+
+  return request;
+}
+
+}  // namespace amdinfer
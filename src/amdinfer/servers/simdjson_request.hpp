@@ -0,0 +1,47 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines the simdjson-based parser for HTTP inference requests
+ */
+
+#ifndef GUARD_AMDINFER_SERVERS_SIMDJSON_REQUEST
+#define GUARD_AMDINFER_SERVERS_SIMDJSON_REQUEST
+
+#include <string_view>  // for string_view
+
+#include "amdinfer/declarations.hpp"  // for InferenceRequestPtr
+
+namespace amdinfer {
+
+class MemoryPool;
+
+/**
+ * @brief Parse a KServe v2 inference request body directly into an
+ * InferenceRequest. Unlike the jsoncpp path, no DOM is built: the body is
+ * walked once with simdjson's on-demand API and the elements of each input's
+ * "data" array are written directly into a typed buffer from the pool.
+ *
+ * @param body the raw (uncompressed) request body
+ * @param pool the memory pool to allocate input buffers from
+ * @return InferenceRequestPtr
+ * @throws invalid_argument if the body is not a valid inference request
+ */
+InferenceRequestPtr parseInferenceRequest(std::string_view body,
+                                          const MemoryPool* pool);
+
+}  // namespace amdinfer
+
+#endif  // GUARD_AMDINFER_SERVERS_SIMDJSON_REQUEST
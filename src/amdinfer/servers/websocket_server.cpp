@@ -24,13 +24,17 @@
 #include <string>     // for string, operator+, char_t...
 #include <utility>    // for move
 
-#include "amdinfer/core/exceptions.hpp"          // for invalid_argument
-#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
-#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
-#include "amdinfer/core/request_container.hpp"   // for ParameterMapPtr
-#include "amdinfer/core/shared_state.hpp"        // for SharedState
-#include "amdinfer/observation/tracing.hpp"      // for startSpan, Span
-#include "amdinfer/servers/http_server.hpp"      // for RequestBuilder
+#include "amdinfer/clients/websocket_internal.hpp"  // for encodeWsResponse
+#include "amdinfer/core/data_types.hpp"             // for DataType
+#include "amdinfer/core/exceptions.hpp"             // for invalid_argument
+#include "amdinfer/core/inference_request.hpp"      // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"     // for InferenceResponse
+#include "amdinfer/core/request_container.hpp"      // for ParameterMapPtr
+#include "amdinfer/core/shared_state.hpp"           // for SharedState
+#include "amdinfer/observation/tracing.hpp"         // for startSpan, Span
+#include "amdinfer/servers/http_server.hpp"         // for RequestBuilder
+#include "amdinfer/servers/json_writer.hpp"         // for JsonWriter
+#include "amdinfer/util/base64.hpp"                 // for base64Encode
 
 using drogon::HttpRequestPtr;
 using drogon::WebSocketConnectionPtr;
@@ -38,18 +42,81 @@ using drogon::WebSocketMessageType;
 
 namespace amdinfer::http {
 
+namespace {
+
+/**
+ * @brief Check if the response is a video frame from makeFrameResponse(),
+ * which JSON clients expect in the JSON message the streaming workers used to
+ * send
+ */
+bool isVideoFrame(const InferenceResponse &response) {
+  const auto *parameters = response.getParameters();
+  const auto &outputs = response.getOutputs();
+  return parameters != nullptr && parameters->has("key") &&
+         parameters->has("labels") && outputs.size() == 1 &&
+         outputs[0].getName() == "image" &&
+         outputs[0].getDatatype() == DataType::Uint8;
+}
+
+/// Make the JSON message with the video frame as a base64 data URL
+std::string makeLegacyFrame(const InferenceResponse &response) {
+  const auto *parameters = response.getParameters();
+  const auto &output = response.getOutputs()[0];
+  const auto image = util::base64Encode(
+    static_cast<const char *>(output.getData()), output.getSize());
+
+  // the key comes from the client so it's escaped. The labels are JSON already
+  JsonWriter writer;
+  writer.raw("{");
+  writer.key("key");
+  writer.string(parameters->get<std::string>("key"));
+  writer.comma();
+  writer.key("data");
+  writer.raw("{");
+  writer.key("img");
+  writer.string("data:image/jpg;base64," + image);
+  writer.comma();
+  writer.key("labels");
+  writer.raw(parameters->get<std::string>("labels"));
+  writer.raw("}}");
+  return std::move(writer).str();
+}
+
+}  // namespace
+
+/**
+ * @brief Set the callback for a websocket request. Requests sent in binary
+ * frames get all their outputs back in binary frames. Requests sent as JSON
+ * text only get the first output back: string data is sent as text and
+ * anything else, such as an encoded image, as binary. Video frames are sent to
+ * them as text in the JSON message with a base64-encoded image that the
+ * streaming workers sent before they switched to binary frames.
+ *
+ * @param request the request to set the callback for
+ * @param conn the connection to respond on
+ * @param binary true if the request was sent in a binary frame
+ */
 void setCallback(InferenceRequest *request,
-                 drogon::WebSocketConnectionPtr conn) {
-  Callback callback = [conn =
-                         std::move(conn)](const InferenceResponse &response) {
-    if (response.isError()) {
+                 drogon::WebSocketConnectionPtr conn, bool binary) {
+  Callback callback = [conn = std::move(conn),
+                       binary](const InferenceResponse &response) {
+    if (!conn->connected()) {
+      return;
+    }
+    if (binary) {
+      conn->send(encodeWsResponse(response), WebSocketMessageType::Binary);
+    } else if (response.isError()) {
       conn->send(response.getError());
+    } else if (isVideoFrame(response)) {
+      conn->send(makeLegacyFrame(response));
     } else {
-      auto outputs = response.getOutputs();
-      const auto *msg = static_cast<char *>(outputs[0].getData());
-      if (conn->connected()) {
-        conn->send(msg, outputs[0].getSize());
-      }
+      const auto &output = response.getOutputs()[0];
+      const auto *msg = static_cast<char *>(output.getData());
+      const auto size = output.getSize() * output.getDatatype().size();
+      conn->send(msg, size,
+                 output.getDatatype() == DataType::Bytes
+                   ? WebSocketMessageType::Text
+                   : WebSocketMessageType::Binary);
     }
   };
   request->setCallback(std::move(callback));
@@ -72,36 +139,47 @@ void WebsocketServer::handleNewMessage(const WebSocketConnectionPtr &conn,
     return;
   }
 
-  auto json = std::make_shared<Json::Value>();
-  std::string errors;
-  Json::CharReaderBuilder builder;
-  Json::CharReader *reader = builder.newCharReader();
-  bool parsing_successful = reader->parse(
-    message.data(), message.data() + message.size(), json.get(), &errors);
-  delete reader;  // NOLINT(cppcoreguidelines-owning-memory)
-
-  // if we fail to get the JSON object, return
-  if (!parsing_successful) {
-    AMDINFER_LOG_INFO(logger_, "Failed to parse JSON request to websocket");
-    conn->shutdown(drogon::CloseCode::kInvalidMessage,
-                   "No JSON could be parsed in the request");
-    return;
-  }
-
+  InferenceRequestPtr request;
   std::string model;
-  if (json->isMember("model")) {
-    model = json->get("model", "").asString();
+  const bool binary = type == WebSocketMessageType::Binary;
+  if (binary) {
+    try {
+      request = decodeWsRequest(message, state_->getPool(), &model);
+    } catch (const invalid_argument &e) {
+      AMDINFER_LOG_INFO(logger_, e.what());
+      conn->shutdown(drogon::CloseCode::kInvalidMessage, e.what());
+      return;
+    }
   } else {
-    AMDINFER_LOG_INFO(logger_, "No model request found in websocket");
-    conn->shutdown(drogon::CloseCode::kInvalidMessage,
-                   "No model found in request");
-    return;
+    auto json = std::make_shared<Json::Value>();
+    std::string errors;
+    Json::CharReaderBuilder builder;
+    const std::unique_ptr<Json::CharReader> reader{builder.newCharReader()};
+    bool parsing_successful = reader->parse(
+      message.data(), message.data() + message.size(), json.get(), &errors);
+
+    // if we fail to get the JSON object, return
+    if (!parsing_successful) {
+      AMDINFER_LOG_INFO(logger_, "Failed to parse JSON request to websocket");
+      conn->shutdown(drogon::CloseCode::kInvalidMessage,
+                     "No JSON could be parsed in the request");
+      return;
+    }
+
+    if (json->isMember("model")) {
+      model = json->get("model", "").asString();
+    } else {
+      AMDINFER_LOG_INFO(logger_, "No model request found in websocket");
+      conn->shutdown(drogon::CloseCode::kInvalidMessage,
+                     "No model found in request");
+      return;
+    }
+    request = getRequest(json, state_->getPool());
   }
   std::transform(model.begin(), model.end(), model.begin(),
                  [](unsigned char c) { return std::tolower(c); });
 
-  auto request = getRequest(json, state_->getPool());
-  setCallback(request.get(), conn);
+  setCallback(request.get(), conn, binary);
   auto request_container = std::make_unique<RequestContainer>();
   request_container->request = request;
 #ifdef AMDINFER_ENABLE_TRACING
@@ -17,8 +17,25 @@
 
 #include <zlib.h>  // for z_stream, inflate, inflateEnd, Z_OK, Z_NO_FLUSH
 
-#include <array>    // for array
-#include <cstring>  // for memset
+#include <algorithm>  // for transform
+#include <array>      // for array
+#include <cctype>     // for tolower
+#include <cstdint>    // for uint32_t
+#include <cstring>    // for memset
+#include <memory>     // for unique_ptr
+#include <string>     // for to_string
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+#include "amdinfer/build_options.hpp"    // for AMDINFER_ENABLE_ZSTD
+#include "amdinfer/core/exceptions.hpp"  // for invalid_argument
+
+#ifdef AMDINFER_ENABLE_ZSTD
+#include <zstd.h>  // for ZSTD_decompressStream, ZSTD_compress
+#endif
+#ifdef AMDINFER_ENABLE_LZ4
+#include <lz4frame.h>  // for LZ4F_decompress, LZ4F_compressFrame
+#endif
 
 namespace amdinfer::util {
 
@@ -52,4 +69,408 @@ std::string zDecompress(const char *str, int len) {
   return "";
 }
 
+namespace {
+
+constexpr auto kChunkSize = 65'536;
+
+// zlib's windowBits: 15 for zlib-wrapped data, +16 for gzip and +32 to
+// auto-detect either when inflating
+constexpr auto kZlibWindowBits = 15;
+constexpr auto kGzipWindowBits = kZlibWindowBits + 16;
+constexpr auto kDetectWindowBits = kZlibWindowBits + 32;
+constexpr auto kZlibMemLevel = 8;
+
+bool isSupported(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::Identity:
+    case Encoding::Deflate:
+    case Encoding::Gzip:
+      return true;
+    case Encoding::Zstd:
+#ifdef AMDINFER_ENABLE_ZSTD
+      return true;
+#else
+      return false;
+#endif
+    case Encoding::Lz4:
+#ifdef AMDINFER_ENABLE_LZ4
+      return true;
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+/// Ranks supported encodings. Higher is preferred when the client has no
+/// preference. Favours compression ratio since bytes on the wire dominate.
+int preference(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::Zstd:
+      return 4;
+    case Encoding::Gzip:
+      return 3;
+    case Encoding::Deflate:
+      return 2;
+    case Encoding::Lz4:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+std::string_view trim(std::string_view str) {
+  const auto *whitespace = " \t";
+  const auto start = str.find_first_not_of(whitespace);
+  if (start == std::string_view::npos) {
+    return {};
+  }
+  const auto end = str.find_last_not_of(whitespace);
+  return str.substr(start, end - start + 1);
+}
+
+std::string toLower(std::string_view str) {
+  std::string lower{str};
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return lower;
+}
+
+std::pair<bool, Encoding> toEncoding(std::string_view token) {
+  const auto lower = toLower(token);
+  if (lower == "identity") {
+    return {true, Encoding::Identity};
+  }
+  if (lower == "deflate") {
+    return {true, Encoding::Deflate};
+  }
+  if (lower == "gzip" || lower == "x-gzip") {
+    return {true, Encoding::Gzip};
+  }
+  if (lower == "zstd") {
+    return {true, Encoding::Zstd};
+  }
+  if (lower == "lz4") {
+    return {true, Encoding::Lz4};
+  }
+  return {false, Encoding::Identity};
+}
+
+void checkSize(size_t size, size_t max_size) {
+  if (size > max_size) {
+    throw invalid_argument("Decompressed body exceeds the maximum size of " +
+                           std::to_string(max_size) + " bytes");
+  }
+}
+
+void zlibDecompress(std::string_view data, size_t max_size,
+                    const DecompressSink &sink) {
+  z_stream zs;
+  memset(&zs, 0, sizeof(zs));
+  if (inflateInit2(&zs, kDetectWindowBits) != Z_OK) {
+    throw runtime_error("Failed to initialize zlib");
+  }
+  const std::unique_ptr<z_stream, decltype(&inflateEnd)> guard{&zs,
+                                                               inflateEnd};
+  const auto *input = reinterpret_cast<const Bytef *>(data.data());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  zs.next_in = const_cast<Bytef *>(input);
+  zs.avail_in = static_cast<uInt>(data.size());
+
+  std::vector<char> chunk(kChunkSize);
+  int ret = Z_OK;
+  while (ret != Z_STREAM_END) {
+    zs.next_out = reinterpret_cast<Bytef *>(chunk.data());
+    zs.avail_out = static_cast<uInt>(chunk.size());
+    ret = inflate(&zs, Z_NO_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END) {
+      throw invalid_argument("Failed to decompress body: corrupt data");
+    }
+    const auto produced = chunk.size() - zs.avail_out;
+    if (produced == 0 && zs.avail_in == 0 && ret != Z_STREAM_END) {
+      throw invalid_argument("Failed to decompress body: truncated data");
+    }
+    checkSize(zs.total_out, max_size);
+    sink(chunk.data(), produced);
+  }
+}
+
+std::string zlibCompress(std::string_view data, int level, int window_bits) {
+  z_stream zs;
+  memset(&zs, 0, sizeof(zs));
+  if (deflateInit2(&zs, level < 0 ? Z_DEFAULT_COMPRESSION : level, Z_DEFLATED,
+                   window_bits, kZlibMemLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw runtime_error("Failed to initialize zlib");
+  }
+  const std::unique_ptr<z_stream, decltype(&deflateEnd)> guard{&zs,
+                                                               deflateEnd};
+
+  std::string out;
+  out.resize(deflateBound(&zs, data.size()));
+  const auto *input = reinterpret_cast<const Bytef *>(data.data());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  zs.next_in = const_cast<Bytef *>(input);
+  zs.avail_in = static_cast<uInt>(data.size());
+  zs.next_out = reinterpret_cast<Bytef *>(out.data());
+  zs.avail_out = static_cast<uInt>(out.size());
+  if (deflate(&zs, Z_FINISH) != Z_STREAM_END) {
+    throw runtime_error("Failed to compress data");
+  }
+  out.resize(zs.total_out);
+  return out;
+}
+
+#ifdef AMDINFER_ENABLE_ZSTD
+void zstdDecompress(std::string_view data, size_t max_size,
+                    const DecompressSink &sink) {
+  const std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{
+    ZSTD_createDCtx(), ZSTD_freeDCtx};
+
+  std::vector<char> chunk(ZSTD_DStreamOutSize());
+  ZSTD_inBuffer input{data.data(), data.size(), 0};
+  size_t total = 0;
+  size_t ret = 1;
+  while (input.pos < input.size || ret != 0) {
+    ZSTD_outBuffer output{chunk.data(), chunk.size(), 0};
+    ret = ZSTD_decompressStream(context.get(), &output, &input);
+    if (ZSTD_isError(ret) != 0U) {
+      throw invalid_argument(std::string{"Failed to decompress body: "} +
+                             ZSTD_getErrorName(ret));
+    }
+    if (output.pos == 0 && input.pos == input.size && ret != 0) {
+      throw invalid_argument("Failed to decompress body: truncated data");
+    }
+    total += output.pos;
+    checkSize(total, max_size);
+    sink(chunk.data(), output.pos);
+  }
+}
+#endif
+
+#ifdef AMDINFER_ENABLE_LZ4
+void lz4Decompress(std::string_view data, size_t max_size,
+                   const DecompressSink &sink) {
+  LZ4F_dctx *raw_context = nullptr;
+  if (LZ4F_isError(LZ4F_createDecompressionContext(&raw_context,
+                                                   LZ4F_VERSION)) != 0U) {
+    throw runtime_error("Failed to initialize lz4");
+  }
+  const std::unique_ptr<LZ4F_dctx, decltype(&LZ4F_freeDecompressionContext)>
+    context{raw_context, LZ4F_freeDecompressionContext};
+
+  std::vector<char> chunk(kChunkSize);
+  size_t offset = 0;
+  size_t total = 0;
+  size_t ret = 1;
+  while (ret != 0) {
+    auto chunk_size = chunk.size();
+    auto src_size = data.size() - offset;
+    ret = LZ4F_decompress(context.get(), chunk.data(), &chunk_size,
+                          data.data() + offset, &src_size, nullptr);
+    if (LZ4F_isError(ret) != 0U) {
+      throw invalid_argument(std::string{"Failed to decompress body: "} +
+                             LZ4F_getErrorName(ret));
+    }
+    if (src_size == 0 && chunk_size == 0 && ret != 0) {
+      throw invalid_argument("Failed to decompress body: truncated data");
+    }
+    offset += src_size;
+    total += chunk_size;
+    checkSize(total, max_size);
+    sink(chunk.data(), chunk_size);
+  }
+}
+#endif
+
+}  // namespace
+
+std::string_view toString(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::Identity:
+      return "identity";
+    case Encoding::Deflate:
+      return "deflate";
+    case Encoding::Gzip:
+      return "gzip";
+    case Encoding::Zstd:
+      return "zstd";
+    case Encoding::Lz4:
+      return "lz4";
+  }
+  return "identity";
+}
+
+Encoding parseContentEncoding(std::string_view header) {
+  const auto token = trim(header);
+  if (token.empty()) {
+    return Encoding::Identity;
+  }
+  if (token.find(',') != std::string_view::npos) {
+    throw invalid_argument("Multiple content encodings are not supported");
+  }
+  const auto [known, encoding] = toEncoding(token);
+  if (!known || !isSupported(encoding)) {
+    throw invalid_argument("Unsupported content encoding: " +
+                           std::string{token});
+  }
+  return encoding;
+}
+
+Encoding negotiateEncoding(std::string_view header) {
+  auto best = Encoding::Identity;
+  double best_quality = 0;
+
+  while (!header.empty()) {
+    const auto comma = header.find(',');
+    auto item = header.substr(0, comma);
+    header = comma == std::string_view::npos ? std::string_view{}
+                                             : header.substr(comma + 1);
+
+    double quality = 1;
+    const auto semicolon = item.find(';');
+    if (semicolon != std::string_view::npos) {
+      const auto params = trim(item.substr(semicolon + 1));
+      if (params.size() > 2 && (params[0] == 'q' || params[0] == 'Q') &&
+          params[1] == '=') {
+        try {
+          quality = std::stod(std::string{params.substr(2)});
+        } catch (const std::exception &) {
+          quality = 0;
+        }
+      }
+      item = item.substr(0, semicolon);
+    }
+    item = trim(item);
+
+    Encoding encoding = Encoding::Identity;
+    if (item == "*") {
+      encoding = Encoding::Gzip;
+    } else {
+      const auto [known, parsed] = toEncoding(item);
+      if (!known) {
+        continue;
+      }
+      encoding = parsed;
+    }
+    if (quality <= 0 || !isSupported(encoding)) {
+      continue;
+    }
+    if (quality > best_quality ||
+        (quality == best_quality && preference(encoding) > preference(best))) {
+      best = encoding;
+      best_quality = quality;
+    }
+  }
+  return best;
+}
+
+void decompress(Encoding encoding, std::string_view data, size_t max_size,
+                const DecompressSink &sink) {
+  switch (encoding) {
+    case Encoding::Identity:
+      checkSize(data.size(), max_size);
+      sink(data.data(), data.size());
+      break;
+    case Encoding::Deflate:
+    case Encoding::Gzip:
+      zlibDecompress(data, max_size, sink);
+      break;
+    case Encoding::Zstd:
+#ifdef AMDINFER_ENABLE_ZSTD
+      zstdDecompress(data, max_size, sink);
+      break;
+#else
+      throw invalid_argument("Unsupported content encoding: zstd");
+#endif
+    case Encoding::Lz4:
+#ifdef AMDINFER_ENABLE_LZ4
+      lz4Decompress(data, max_size, sink);
+      break;
+#else
+      throw invalid_argument("Unsupported content encoding: lz4");
+#endif
+    default:
+      throw invalid_argument("Unsupported content encoding: " +
+                             std::string{toString(encoding)});
+  }
+}
+
+size_t decompressedSizeHint(Encoding encoding, std::string_view data) {
+  // the gzip trailer ends with the uncompressed size modulo 2^32
+  constexpr auto kGzipTrailerSize = 4;
+  switch (encoding) {
+    case Encoding::Identity:
+      return data.size();
+    case Encoding::Gzip: {
+      if (data.size() < kGzipTrailerSize) {
+        return 0;
+      }
+      const auto *trailer = reinterpret_cast<const unsigned char *>(
+        data.data() + data.size() - kGzipTrailerSize);
+      return static_cast<uint32_t>(trailer[0]) |
+             (static_cast<uint32_t>(trailer[1]) << 8U) |
+             (static_cast<uint32_t>(trailer[2]) << 16U) |
+             (static_cast<uint32_t>(trailer[3]) << 24U);
+    }
+#ifdef AMDINFER_ENABLE_ZSTD
+    case Encoding::Zstd: {
+      const auto size = ZSTD_getFrameContentSize(data.data(), data.size());
+      if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR) {
+        return 0;
+      }
+      return size;
+    }
+#endif
+    default:
+      return 0;
+  }
+}
+
+std::string compress(Encoding encoding, std::string_view data, int level) {
+  switch (encoding) {
+    case Encoding::Identity:
+      return std::string{data};
+    case Encoding::Deflate:
+      return zlibCompress(data, level, kZlibWindowBits);
+    case Encoding::Gzip:
+      return zlibCompress(data, level, kGzipWindowBits);
+#ifdef AMDINFER_ENABLE_ZSTD
+    case Encoding::Zstd: {
+      std::string out;
+      out.resize(ZSTD_compressBound(data.size()));
+      const auto size =
+        ZSTD_compress(out.data(), out.size(), data.data(), data.size(),
+                      level < 0 ? ZSTD_CLEVEL_DEFAULT : level);
+      if (ZSTD_isError(size) != 0U) {
+        throw runtime_error(std::string{"Failed to compress data: "} +
+                            ZSTD_getErrorName(size));
+      }
+      out.resize(size);
+      return out;
+    }
+#endif
+#ifdef AMDINFER_ENABLE_LZ4
+    case Encoding::Lz4: {
+      LZ4F_preferences_t preferences;
+      memset(&preferences, 0, sizeof(preferences));
+      preferences.compressionLevel = level < 0 ? 0 : level;
+      preferences.frameInfo.contentSize = data.size();
+      std::string out;
+      out.resize(LZ4F_compressFrameBound(data.size(), &preferences));
+      const auto size = LZ4F_compressFrame(out.data(), out.size(), data.data(),
+                                           data.size(), &preferences);
+      if (LZ4F_isError(size) != 0U) {
+        throw runtime_error(std::string{"Failed to compress data: "} +
+                            LZ4F_getErrorName(size));
+      }
+      out.resize(size);
+      return out;
+    }
+#endif
+    default:
+      throw invalid_argument("Unsupported content encoding: " +
+                             std::string{toString(encoding)});
+  }
+}
+
 }  // namespace amdinfer::util
@@ -16,7 +16,10 @@
 #ifndef GUARD_AMDINFER_HELPERS_COMPRESSION
 #define GUARD_AMDINFER_HELPERS_COMPRESSION
 
-#include <string>
+#include <cstddef>      // for size_t
+#include <functional>   // for function
+#include <string>       // for string
+#include <string_view>  // for string_view
 
 namespace amdinfer::util {
 
@@ -29,6 +32,69 @@ namespace amdinfer::util {
  */
 std::string zDecompress(const char *str, int len);
 
+/// Content encodings that may be used for HTTP request and response bodies
+enum class Encoding { Identity, Deflate, Gzip, Zstd, Lz4 };
+
+/// Get the HTTP token for an encoding e.g. "gzip"
+std::string_view toString(Encoding encoding);
+
+/**
+ * @brief Parse the value of a Content-Encoding header. Only a single encoding
+ * is supported.
+ *
+ * @param header the header value. An empty header is Identity
+ * @return Encoding
+ * @throws invalid_argument if the encoding is unknown or not supported by
+ * this build
+ */
+Encoding parseContentEncoding(std::string_view header);
+
+/**
+ * @brief Pick the best encoding supported by this build that the client lists
+ * in its Accept-Encoding header. Encodings with q=0 are ignored.
+ *
+ * @param header the value of the Accept-Encoding header
+ * @return Encoding Identity if there's no acceptable encoding
+ */
+Encoding negotiateEncoding(std::string_view header);
+
+/// Called with each chunk of decompressed data, in order
+using DecompressSink = std::function<void(const char *data, size_t size)>;
+
+/**
+ * @brief Decompress data incrementally, passing each decompressed chunk to the
+ * sink as it's produced rather than accumulating the result
+ *
+ * @param encoding the encoding of the data
+ * @param data the compressed data
+ * @param max_size maximum allowed size of the decompressed data
+ * @param sink callback to consume the decompressed data
+ * @throws invalid_argument if the data is corrupt or exceeds max_size
+ */
+void decompress(Encoding encoding, std::string_view data, size_t max_size,
+                const DecompressSink &sink);
+
+/**
+ * @brief Get a hint for the size of the decompressed data from the compressed
+ * data's headers/trailers, if the format records it.
+ *
+ * @param encoding the encoding of the data
+ * @param data the compressed data
+ * @return size_t the size hint or 0 if unknown
+ */
+size_t decompressedSizeHint(Encoding encoding, std::string_view data);
+
+/**
+ * @brief Compress data
+ *
+ * @param encoding the encoding to use
+ * @param data the data to compress
+ * @param level the compression level, which is passed to the underlying
+ * library. A negative value uses the library's default level.
+ * @return std::string the compressed data
+ */
+std::string compress(Encoding encoding, std::string_view data, int level);
+
 }  // namespace amdinfer::util
 
 #endif  // GUARD_AMDINFER_HELPERS_COMPRESSION
@@ -17,8 +17,15 @@
 #define GUARD_AMDINFER_HELPERS_STRING
 
 #include <algorithm>
+#include <charconv>
+#include <cstddef>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "amdinfer/core/exceptions.hpp"
 
 namespace amdinfer::util {
 
@@ -63,6 +70,38 @@ inline std::vector<std::string> split(std::string_view str,
   return substrings;
 }
 
+/**
+ * @brief Parse a comma-separated list of batch sizes, such as "1,4,16". Each
+ * size must be a positive integer, optionally surrounded by spaces, so
+ * something like "4abc" is rejected rather than read as 4.
+ *
+ * @param batch_sizes the list to parse
+ * @param name name of the parameter the list came from to use in errors
+ * @return std::vector<size_t>
+ * @throws invalid_argument if any of the sizes is invalid
+ */
+inline std::vector<size_t> parseBatchSizes(std::string_view batch_sizes,
+                                           std::string_view name) {
+  std::vector<size_t> sizes;
+  for (const auto& size : split(batch_sizes, ",")) {
+    const auto first = size.find_first_not_of(' ');
+    const auto last = size.find_last_not_of(' ');
+    size_t value = 0;
+    if (first != std::string::npos) {
+      const auto* begin = size.data() + first;
+      const auto* end = size.data() + last + 1;
+      const auto [ptr, error] = std::from_chars(begin, end, value);
+      if (error == std::errc{} && ptr == end && value > 0) {
+        sizes.push_back(value);
+        continue;
+      }
+    }
+    throw invalid_argument("Invalid batch size in " + std::string{name} +
+                           ": " + size);
+  }
+  return sizes;
+}
+
 inline std::string toLower(const std::string& str) {
   auto str_lower = str;
   std::transform(str_lower.begin(), str_lower.end(), str_lower.begin(),
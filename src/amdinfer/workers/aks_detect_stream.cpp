@@ -49,10 +49,10 @@
 #include "amdinfer/declarations.hpp"         // for BufferPtrs, InferenceRe...
 #include "amdinfer/observation/logging.hpp"  // for Logger
 #include "amdinfer/observation/tracing.hpp"  // for Trace
-#include "amdinfer/util/base64.hpp"          // for base64_encode
 #include "amdinfer/util/parse_env.hpp"       // for autoExpandEnvironmentVa...
 #include "amdinfer/util/thread.hpp"          // for setThreadName
 #include "amdinfer/workers/aks_detect.hpp"   // for DetectResponse
+#include "amdinfer/workers/video_frames.hpp"  // for makeFrameResponse
 #include "amdinfer/workers/worker.hpp"       // for Worker, kNumBufferAuto
 
 namespace AKS {  // NOLINT(readability-identifier-naming)
@@ -78,6 +78,7 @@ class AksDetectStream : public SingleThreadedWorker {
  public:
   using SingleThreadedWorker::SingleThreadedWorker;
   [[nodiscard]] std::vector<MemoryAllocators> getAllocators() const override;
+  [[nodiscard]] bool isStreaming() const override;
 
  private:
   void doInit(ParameterMap* parameters) override;
@@ -94,6 +95,8 @@ std::vector<MemoryAllocators> AksDetectStream::getAllocators() const {
   return {MemoryAllocators::Cpu};
 }
 
+bool AksDetectStream::isStreaming() const { return true; }
+
 void AksDetectStream::doInit([[maybe_unused]] ParameterMap* parameters) {
   constexpr auto kBatchSize = 4;
 
@@ -194,7 +197,7 @@ BatchPtr AksDetectStream::doRun(Batch* batch,
       auto count_adjusted = count - (count % this->batch_size_);
       std::queue<std::future<std::vector<std::unique_ptr<vart::TensorBuffer>>>>
         futures;
-      std::queue<std::string> frames;
+      std::queue<std::vector<unsigned char>> frames;
       for (unsigned int frame_num = 0; frame_num < count_adjusted;
            frame_num += this->batch_size_) {
         std::vector<std::unique_ptr<vart::TensorBuffer>> v;
@@ -226,11 +229,11 @@ BatchPtr AksDetectStream::doRun(Batch* batch,
             reinterpret_cast<uint8_t*>(v[0]->data().first) + (i * input_size),
             frame.data, input_size);
 
+          // the encoded frames are sent as is in binary frames so there's no
+          // need to base64 encode them
           std::vector<unsigned char> buf;
           cv::imencode(".jpg", frame, buf);
-          const auto* enc_msg = reinterpret_cast<const char*>(buf.data());
-          std::string encoded = util::base64Encode(enc_msg, buf.size());
-          frames.push("data:image/jpg;base64," + encoded);
+          frames.push(std::move(buf));
         }
         AMDINFER_LOG_INFO(logger, "Enqueuing in " + key);
         futures.push(this->sys_manager_->enqueueJob(this->graph_, "",
@@ -271,21 +274,8 @@ BatchPtr AksDetectStream::doRun(Batch* batch,
               labels[j].pop_back();  // trim trailing comma
             }
             labels[j] += "]";
-            InferenceResponse resp;
-            resp.setID(req->getID());
-            resp.setModel("invert_video");
-
-            InferenceResponseOutput output;
-            output.setName("image");
-            output.setDatatype(DataType::Bytes);
-            auto message = constructMessage(key, frames.front(), labels[j]);
-            std::vector<std::byte> buffer;
-            buffer.resize(message.size());
-            memcpy(buffer.data(), message.data(), message.size());
-            output.setData(std::move(buffer));
-            output.setShape({static_cast<int64_t>(message.size())});
-            resp.addOutput(output);
-            req->runCallback(resp);
+            req->runCallback(makeFrameResponse(
+              req->getID(), this->getName(), key, frames.front(), labels[j]));
             frames.pop();
           }
         }
@@ -322,21 +312,8 @@ BatchPtr AksDetectStream::doRun(Batch* batch,
             labels[j].pop_back();  // trim trailing comma
           }
           labels[j] += "]";
-          InferenceResponse resp;
-          resp.setID(req->getID());
-          resp.setModel("invert_video");
-
-          InferenceResponseOutput output;
-          output.setName("image");
-          output.setDatatype(DataType::Bytes);
-          auto message = constructMessage(key, frames.front(), labels[j]);
-          std::vector<std::byte> buffer;
-          buffer.resize(message.size());
-          memcpy(buffer.data(), message.data(), message.size());
-          output.setData(std::move(buffer));
-          output.setShape({static_cast<int64_t>(message.size())});
-          resp.addOutput(output);
-          req->runCallback(resp);
+          req->runCallback(makeFrameResponse(
+            req->getID(), this->getName(), key, frames.front(), labels[j]));
           frames.pop();
         }
       }
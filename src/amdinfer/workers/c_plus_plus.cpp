@@ -37,6 +37,7 @@
 #include "amdinfer/core/inference_request.hpp"  // for InferenceRequest, Infe...
 #include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
 #include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/core/worker_registry.hpp"  // for AMDINFER_REGISTER_WORKER
 #include "amdinfer/declarations.hpp"         // for BufferPtr, InferenceRes...
 #include "amdinfer/observation/logging.hpp"  // for Logger
 #include "amdinfer/observation/metrics.hpp"  // for Metrics
@@ -218,10 +219,5 @@ void CPlusPlus::doDestroy() { dlclose(handle_); }
 
 }  // namespace amdinfer
 
-extern "C" {
-// using smart pointer here may cause problems inside shared object so managing
-// manually
-amdinfer::workers::Worker* getWorker() {
-  return new amdinfer::workers::CPlusPlus("CPlusPlus", "CPU", true);
-}
-}  // extern C
+AMDINFER_REGISTER_WORKER(
+  "cplusplus", new amdinfer::workers::CPlusPlus("CPlusPlus", "CPU", true))
@@ -34,11 +34,12 @@
 #include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
 #include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
 #include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/core/worker_registry.hpp"  // for AMDINFER_REGISTER_WORKER
 #include "amdinfer/declarations.hpp"         // for BufferPtr, InferenceRes...
 #include "amdinfer/observation/logging.hpp"  // for Logger
 #include "amdinfer/observation/tracing.hpp"  // for startFollowSpan, SpanPtr
-#include "amdinfer/util/base64.hpp"          // for base64_encode
 #include "amdinfer/util/thread.hpp"          // for setThreadName
+#include "amdinfer/workers/video_frames.hpp"  // for makeFrameResponse
 #include "amdinfer/workers/worker.hpp"       // for Worker
 
 namespace amdinfer {
@@ -53,13 +54,16 @@ namespace workers {
 
 /**
  * @brief The InvertVideo worker is a simple worker that accepts an path to a
- * video and sends the inverted frames back to the client over a websocket.
+ * video and sends the inverted frames back to the client over a websocket. The
+ * first response contains the video's FPS as a JSON string. Each subsequent
+ * response contains one inverted frame, made with makeFrameResponse().
  *
  */
 class InvertVideo : public SingleThreadedWorker {
  public:
   using SingleThreadedWorker::SingleThreadedWorker;
   [[nodiscard]] std::vector<MemoryAllocators> getAllocators() const override;
+  [[nodiscard]] bool isStreaming() const override;
 
  private:
   void doInit(ParameterMap* parameters) override;
@@ -73,6 +77,8 @@ std::vector<MemoryAllocators> InvertVideo::getAllocators() const {
   return {MemoryAllocators::Cpu};
 }
 
+bool InvertVideo::isStreaming() const { return true; }
+
 void InvertVideo::doInit([[maybe_unused]] ParameterMap* parameters) {
   constexpr auto kBatchSize = 1;
 
@@ -156,25 +162,8 @@ BatchPtr InvertVideo::doRun(Batch* batch,
         cv::bitwise_not(frame, frame);
         std::vector<unsigned char> buf;
         cv::imencode(".jpg", frame, buf);
-        const auto* enc_msg = reinterpret_cast<const char*>(buf.data());
-        std::string encoded =
-          "data:image/jpg;base64," + util::base64Encode(enc_msg, buf.size());
-
-        InferenceResponse resp;
-        resp.setID(req->getID());
-        resp.setModel("invert_video");
-
-        InferenceResponseOutput output;
-        output.setName("image");
-        output.setDatatype(DataType::Bytes);
-        message = constructMessage(key, encoded);
-        std::vector<std::byte> buffer;
-        buffer.resize(message.size());
-        memcpy(buffer.data(), message.data(), message.size());
-        output.setData(std::move(buffer));
-        output.setShape({static_cast<int64_t>(message.size())});
-        resp.addOutput(output);
-        req->runCallback(resp);
+        req->runCallback(
+          makeFrameResponse(req->getID(), "invert_video", key, buf));
       }
     }
   }
@@ -190,10 +179,6 @@ void InvertVideo::doDestroy() {}
 
 }  // namespace amdinfer
 
-extern "C" {
-// using smart pointer here may cause problems inside shared object so managing
-// manually
-amdinfer::workers::Worker* getWorker() {
-  return new amdinfer::workers::InvertVideo("InvertVideo", "CPU", false);
-}
-}  // extern C
+AMDINFER_REGISTER_WORKER("invertvideo",
+                         new amdinfer::workers::InvertVideo("InvertVideo",
+                                                            "CPU", false))
@@ -17,7 +17,8 @@
  * @brief Implements the Migraphx worker.
  */
 
-#include <migraphx/migraphx.h>  // for migraphx_shape_datatype_t
+#include <hip/hip_runtime_api.h>  // for hipGetDeviceProperties
+#include <migraphx/migraphx.h>      // for migraphx_shape_datatype_t
 
 #include <algorithm>              // for max
 #include <cstddef>                // for byte, size_t
@@ -37,6 +38,7 @@
 
 #include "amdinfer/batching/hard.hpp"           // for BatchPtr, Batch, Batch...
 #include "amdinfer/build_options.hpp"           // for AMDINFER_ENABLE_LOGGING
+#include "amdinfer/core/artifact_cache.hpp"     // for ArtifactCache
 #include "amdinfer/core/data_types.hpp"         // for DataType, operator<<
 #include "amdinfer/core/exceptions.hpp"         // for invalid_argument, runt...
 #include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
@@ -73,6 +75,7 @@ class MIGraphXWorker : public SingleThreadedWorker {
   void doDestroy() override;
 
   void compile(const std::string& onnx_path, const std::string& compiled_path);
+  void load(const std::string& compiled_path);
 
   // the model file to be loaded.  Supported types are *.onnx and *.mxr
   std::filesystem::path input_file_;
@@ -83,11 +86,9 @@ class MIGraphXWorker : public SingleThreadedWorker {
 
   // flag to pad out a batch with dummy data.  Sending a batch of requests
   // with uninitialized data may crash MIGraphX, for certain models.
-  // If pad_batch_ is true, this worker will pad any unused request slots
+  // If pad_batch_ is true, the batcher will pad any unused request slots
   // in a batch with dummy copies of the first request.
   bool pad_batch_ = true;
-  // Calculated sizes in bytes for each input tensor, by input name
-  std::map<std::string, size_t, std::less<>> input_sizes_;
 };
 
 std::vector<MemoryAllocators> MIGraphXWorker::getAllocators() const {
@@ -133,6 +134,22 @@ DataType toDataType(migraphx_shape_datatype_t in) {
   }
 }
 
+/**
+ * @brief Get the architecture of the GPU that models are compiled for, such as
+ * gfx90a:sramecc+:xnack-. Compiled programs only run on a matching GPU.
+ *
+ * @return std::string
+ */
+std::string getGpuArch() {
+  int device = 0;
+  hipDeviceProp_t properties;
+  if (hipGetDevice(&device) != hipSuccess ||
+      hipGetDeviceProperties(&properties, device) != hipSuccess) {
+    throw runtime_error("migraphx worker cannot get the GPU's properties");
+  }
+  return properties.gcnArchName;
+}
+
 void MIGraphXWorker::compile(const std::string& onnx_path,
                              const std::string& compiled_path) {
 #ifdef AMDINFER_ENABLE_LOGGING
@@ -200,6 +217,33 @@ void MIGraphXWorker::compile(const std::string& onnx_path,
   }
 }
 
+void MIGraphXWorker::load(const std::string& compiled_path) {
+#ifdef AMDINFER_ENABLE_LOGGING
+  const auto& logger = this->getLogger();
+#endif
+
+  // Load the compiled MessagePack (*.mxr) file
+  AMDINFER_LOG_INFO(
+    logger, std::string("migraphx worker loading compiled model file ") +
+              compiled_path);
+  migraphx::file_options options;
+  options.set_file_format("msgpack");
+
+  // The hip library will throw a cryptic error if unable to connect with a
+  // GPU at this point.
+  try {
+    this->prog_ = migraphx::load(compiled_path.c_str(), options);
+  } catch (const std::exception& e) {
+    std::string emsg = e.what();
+    if (emsg.find("Failed to call function") != std::string::npos) {
+      emsg = emsg + ".  Server could not connect to a GPU.";
+    }
+    AMDINFER_LOG_ERROR(logger, emsg);
+    throw std::runtime_error(emsg);
+    // prog_ does not need to be compiled.
+  }
+}
+
 void MIGraphXWorker::doInit(ParameterMap* parameters) {
   // default batch size; client may request a change. Arbitrarily set to 64
   const int default_batch_size = 64;
@@ -252,29 +296,25 @@ void MIGraphXWorker::doInit(ParameterMap* parameters) {
   compiled_path += (std::string("_b") + std::to_string(batch_size_) + ".mxr");
   onnx_path.replace_extension(".onnx");
 
-  // Is there an mxr file?
-  std::ifstream f(compiled_path.c_str());
-  if (f.good()) {
-    // Load the compiled MessagePack (*.mxr) file
-    AMDINFER_LOG_INFO(
-      logger, std::string("migraphx worker loading compiled model file ") +
-                compiled_path.c_str());
-    migraphx::file_options options;
-    options.set_file_format("msgpack");
-
-    // The hip library will throw a cryptic error if unable to connect with a
-    // GPU at this point.
-    try {
-      this->prog_ = migraphx::load(compiled_path.c_str(), options);
-    } catch (const std::exception& e) {
-      std::string emsg = e.what();
-      if (emsg.find("Failed to call function") != std::string::npos) {
-        emsg = emsg + ".  Server could not connect to a GPU.";
-      }
-      AMDINFER_LOG_ERROR(logger, emsg);
-      throw std::runtime_error(emsg);
-      // prog_ does not need to be compiled.
+  if (ArtifactCache::enabled(*parameters)) {
+    // artifacts in the cache are found by the ONNX file's contents rather than
+    // its name so a changed model is never matched with a stale *.mxr file
+    auto cache = ArtifactCache::fromParameters(*parameters);
+    const auto key = ArtifactCache::makeKey(
+      onnx_path, "migraphx",
+      {{"batch_size", std::to_string(batch_size_)}, {"target", getGpuArch()}});
+    bool compiled = false;
+    const auto artifact =
+      cache.get(key, [&](const std::filesystem::path& path) {
+        compile(onnx_path, path);
+        compiled = true;
+      });
+    if (!compiled) {
+      load(artifact);
     }
+  } else if (std::ifstream(compiled_path.c_str()).good()) {
+    // Is there an mxr file?
+    load(compiled_path);
   } else {
     compile(onnx_path, compiled_path);
   }
@@ -287,14 +327,9 @@ void MIGraphXWorker::doInit(ParameterMap* parameters) {
   auto length = sh.lengths();
   migraphx::api::shapes output_shapes = prog_.get_output_shapes();
   this->batch_size_ = length[0];
-
-  for (const auto* aname : input_shapes.names()) {
-    migraphx::shape ashape = input_shapes[aname];
-    auto llen = ashape.lengths();
-    // size of the buffer needed for this input
-    auto asize = ashape.bytes();
-    // size of a single request input (divide by batch size)
-    input_sizes_[aname] = asize / *(ashape.lengths().begin());
+  if (pad_batch_) {
+    this->batch_sizes_ = {batch_size_};
+    this->batch_padding_ = BatchPadding::Replicate;
   }
 }
 
@@ -382,29 +417,6 @@ BatchPtr MIGraphXWorker::doRun(Batch* batch, const MemoryPool* pool) {
       auto* a_data = aninput.getData();  //  void *
       params.add(aname.c_str(), migraphx::argument(modelshape, a_data));
     }
-    // If there were fewer requests in the batch than the stated batch size,
-    // pad the various input tensors with copies of the 0'th request's data.
-
-    if (pad_batch_) {
-      // for each named input channel
-      for (const auto& aninput : inputs0) {
-        auto aname = aninput.getName();
-        // Look up the shape by name in the model, but if there's only 1 input
-        // then the name in the request isn't required to match.
-        if (inputs0.size() == 1) {
-          aname = param_shapes.names().front();
-        }
-        auto* a_data = static_cast<char*>(aninput.getData());
-        // For each empty slot in buffer, i.e. from end of real requests up to
-        // batch size
-        for (size_t req_idx = batch->getRequests().size();
-             req_idx < batch_size_; req_idx++) {
-          memcpy(a_data + req_idx * input_sizes_[aname], a_data,
-                 input_sizes_[aname]);
-        }
-      }
-    }
-
     //
     // Run the inference
     //
@@ -49,9 +49,9 @@
 #include "amdinfer/core/parameters.hpp"          // for ParameterMap
 #include "amdinfer/declarations.hpp"         // for BufferPtrs, InferenceRe...
 #include "amdinfer/observation/logging.hpp"  // for Logger
-#include "amdinfer/util/base64.hpp"          // for base64_encode
 #include "amdinfer/util/parse_env.hpp"       // for autoExpandEnvironmentVa...
 #include "amdinfer/util/thread.hpp"          // for setThreadName
+#include "amdinfer/workers/video_frames.hpp"  // for makeFrameResponse
 #include "amdinfer/workers/worker.hpp"       // for Worker, kNumBufferAuto
 
 namespace AKS {  // NOLINT(readability-identifier-naming)
@@ -79,6 +79,7 @@ class ResNet50Stream : public SingleThreadedWorker {
  public:
   using SingleThreadedWorker::SingleThreadedWorker;
   [[nodiscard]] std::vector<MemoryAllocators> getAllocators() const override;
+  [[nodiscard]] bool isStreaming() const override;
 
  private:
   void doInit(ParameterMap* parameters) override;
@@ -96,6 +97,8 @@ std::vector<MemoryAllocators> ResNet50Stream::getAllocators() const {
   return {MemoryAllocators::Cpu};
 }
 
+bool ResNet50Stream::isStreaming() const { return true; }
+
 void ResNet50Stream::doInit(ParameterMap* parameters) {
   constexpr auto kBatchSize = 4;
   (void)parameters;  // suppress unused variable warning
@@ -198,7 +201,7 @@ BatchPtr ResNet50Stream::doRun(Batch* batch,
       auto count_adjusted = count - (count % this->batch_size_);
       std::queue<std::future<std::vector<std::unique_ptr<vart::TensorBuffer>>>>
         futures;
-      std::queue<std::string> frames;
+      std::queue<std::vector<unsigned char>> frames;
       for (unsigned int num_frames = 0; num_frames < count_adjusted;
            num_frames += this->batch_size_) {
         std::vector<std::unique_ptr<vart::TensorBuffer>> v;
@@ -221,11 +224,11 @@ BatchPtr ResNet50Stream::doRun(Batch* batch,
             reinterpret_cast<uint8_t*>(v[0]->data().first) + (i * kImageSize),
             frame.data, kImageSize);
 
+          // the encoded frames are sent as is in binary frames so there's no
+          // need to base64 encode them
           std::vector<unsigned char> buf;
           cv::imencode(".jpg", frame, buf);
-          const auto* enc_msg = reinterpret_cast<const char*>(buf.data());
-          std::string encoded = util::base64Encode(enc_msg, buf.size());
-          frames.push("data:image/jpg;base64," + encoded);
+          frames.push(std::move(buf));
         }
         futures.push(this->sys_manager_->enqueueJob(this->graph_, "",
                                                     std::move(v), nullptr));
@@ -250,21 +253,8 @@ BatchPtr ResNet50Stream::doRun(Batch* batch,
             }
             labels.pop_back();  // trim trailing comma
             labels += "]";
-            InferenceResponse resp;
-            resp.setID(req->getID());
-            resp.setModel("invert_video");
-
-            InferenceResponseOutput output;
-            output.setName("image");
-            output.setDatatype(DataType::Bytes);
-            auto message = constructMessage(key, frames.front(), labels);
-            std::vector<std::byte> buffer;
-            buffer.resize(message.size());
-            memcpy(buffer.data(), message.data(), message.size());
-            output.setData(std::move(buffer));
-            output.setShape({static_cast<int64_t>(message.size())});
-            resp.addOutput(output);
-            req->runCallback(resp);
+            req->runCallback(makeFrameResponse(
+              req->getID(), this->getName(), key, frames.front(), labels));
             frames.pop();
           }
         }
@@ -289,21 +279,8 @@ BatchPtr ResNet50Stream::doRun(Batch* batch,
           }
           labels.pop_back();  // trim trailing comma
           labels += "]";
-          InferenceResponse resp;
-          resp.setID(req->getID());
-          resp.setModel("invert_video");
-
-          InferenceResponseOutput output;
-          output.setName("image");
-          output.setDatatype(DataType::Bytes);
-          auto message = constructMessage(key, frames.front(), labels);
-          std::vector<std::byte> buffer;
-          buffer.resize(message.size());
-          memcpy(buffer.data(), message.data(), message.size());
-          output.setData(std::move(buffer));
-          output.setShape({static_cast<int64_t>(message.size())});
-          resp.addOutput(output);
-          req->runCallback(resp);
+          req->runCallback(makeFrameResponse(
+            req->getID(), this->getName(), key, frames.front(), labels));
           frames.pop();
         }
       }
@@ -35,6 +35,7 @@
 #include "amdinfer/core/inference_request.hpp"  // for InferenceRequest, Infe...
 #include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
 #include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/core/worker_registry.hpp"  // for AMDINFER_REGISTER_WORKER
 #include "amdinfer/declarations.hpp"         // for BufferPtr, InferenceRes...
 #include "amdinfer/observation/logging.hpp"  // for Logger
 #include "amdinfer/observation/metrics.hpp"  // for Metrics
@@ -157,10 +158,5 @@ void Responder::doDestroy() {}
 
 }  // namespace amdinfer::workers
 
-extern "C" {
-// using smart pointer here may cause problems inside shared object so managing
-// manually
-amdinfer::workers::Worker* getWorker() {
-  return new amdinfer::workers::Responder("responder", "CPU", false);
-}
-}  // extern C
+AMDINFER_REGISTER_WORKER(
+  "responder", new amdinfer::workers::Responder("responder", "CPU", false))
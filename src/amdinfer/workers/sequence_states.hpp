@@ -0,0 +1,73 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Defines the per-sequence state storage for workers
+ */
+
+#ifndef GUARD_AMDINFER_WORKERS_SEQUENCE_STATES
+#define GUARD_AMDINFER_WORKERS_SEQUENCE_STATES
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int32_t
+#include <vector>   // for vector
+
+#include "amdinfer/core/exceptions.hpp"         // for invalid_argument
+#include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
+#include "amdinfer/core/parameters.hpp"         // for ParameterMap
+
+namespace amdinfer::workers {
+
+/**
+ * @brief Workers that use the SequenceBatcher keep the state of each sequence
+ * between its requests here, indexed by the sequence's slot. A slot's state is
+ * reset by the request that starts a new sequence in it.
+ *
+ * @tparam State the state of one sequence. It must be default-constructible
+ */
+template <typename State>
+class SequenceStates {
+ public:
+  /**
+   * @brief Get the state of the request's sequence
+   *
+   * @param request a request batched by the SequenceBatcher
+   * @return State&
+   */
+  State& get(const InferenceRequest& request) {
+    const auto& parameters = request.getParameters();
+    if (!parameters.has("sequence_slot")) {
+      throw invalid_argument("The request isn't part of a sequence");
+    }
+    const auto slot =
+      static_cast<size_t>(parameters.get<int32_t>("sequence_slot"));
+    if (slot >= states_.size()) {
+      states_.resize(slot + 1);
+    }
+    if (parameters.has("sequence_start") &&
+        parameters.get<bool>("sequence_start")) {
+      states_[slot] = State{};
+    }
+    return states_[slot];
+  }
+
+ private:
+  std::vector<State> states_;
+};
+
+}  // namespace amdinfer::workers
+
+#endif  // GUARD_AMDINFER_WORKERS_SEQUENCE_STATES
@@ -0,0 +1,74 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines the responses of the workers that stream video frames
+ */
+
+#ifndef GUARD_AMDINFER_WORKERS_VIDEO_FRAMES
+#define GUARD_AMDINFER_WORKERS_VIDEO_FRAMES
+
+#include <cstddef>  // for byte
+#include <cstdint>  // for int64_t
+#include <cstring>  // for memcpy
+#include <string>   // for string
+#include <utility>  // for move
+#include <vector>   // for vector
+
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+
+namespace amdinfer::workers {
+
+/**
+ * @brief Make the response for one frame of a streamed video. The frame is
+ * sent as raw JPEG bytes in the "image" output, with the request's key and the
+ * frame's labels, a JSON array of boxes, as parameters. The websocket server
+ * turns it back into the JSON message with a base64-encoded image for clients
+ * that send their requests as JSON text.
+ *
+ * @param id the request's ID
+ * @param model the worker's name
+ * @param key the request's key
+ * @param frame the frame encoded as a JPEG
+ * @param labels the frame's labels
+ * @return InferenceResponse
+ */
+inline InferenceResponse makeFrameResponse(
+  const std::string& id, const std::string& model, const std::string& key,
+  const std::vector<unsigned char>& frame, const std::string& labels = "[]") {
+  InferenceResponse response;
+  response.setID(id);
+  response.setModel(model);
+  ParameterMap parameters;
+  parameters.put("key", key);
+  parameters.put("labels", labels);
+  response.setParameters(parameters);
+
+  InferenceResponseOutput output;
+  output.setName("image");
+  output.setDatatype(DataType::Uint8);
+  std::vector<std::byte> buffer(frame.size());
+  std::memcpy(buffer.data(), frame.data(), frame.size());
+  output.setData(std::move(buffer));
+  output.setShape({static_cast<int64_t>(frame.size())});
+  response.addOutput(output);
+  return response;
+}
+
+}  // namespace amdinfer::workers
+
+#endif  // GUARD_AMDINFER_WORKERS_VIDEO_FRAMES
@@ -21,7 +21,10 @@
 #ifndef GUARD_AMDINFER_WORKERS_WORKER
 #define GUARD_AMDINFER_WORKERS_WORKER
 
+#include <algorithm>
 #include <cassert>
+#include <deque>
+#include <exception>
 #include <limits>
 #include <memory>
 #include <string>
@@ -32,6 +35,7 @@
 #include "amdinfer/batching/soft.hpp"
 #include "amdinfer/buffers/buffer.hpp"
 #include "amdinfer/build_options.hpp"
+#include "amdinfer/core/inference_request.hpp"
 #include "amdinfer/core/memory_pool/pool.hpp"
 #include "amdinfer/core/model_metadata.hpp"
 #include "amdinfer/observation/logging.hpp"
@@ -103,7 +107,22 @@ class Worker {
   }
 
   [[nodiscard]] size_t getBatchSize() const { return this->batch_size_; }
+  /// Get the batch sizes the worker supports, or empty if it supports any
+  [[nodiscard]] const std::vector<size_t>& getBatchSizes() const {
+    return this->batch_sizes_;
+  }
+  /// Get what fills the padded slots of batches padded to a supported size
+  [[nodiscard]] BatchPadding getBatchPadding() const {
+    return this->batch_padding_;
+  }
   [[nodiscard]] WorkerStatus getStatus() const { return this->status_; }
+  /**
+   * @brief Check if the worker may respond to a request more than once,
+   * streaming partial responses with runCallback() before the final one
+   *
+   * @return bool
+   */
+  [[nodiscard]] virtual bool isStreaming() const { return false; }
 
   virtual std::vector<std::unique_ptr<Batcher>> makeBatcher(
     int num, ParameterMap* parameters, MemoryPool* pool) {
@@ -142,6 +161,9 @@ class Worker {
 #endif
 
   size_t batch_size_ = 1;
+  /// Batch sizes the worker is compiled for. Smaller batches are padded up
+  std::vector<size_t> batch_sizes_;
+  BatchPadding batch_padding_ = BatchPadding::Zeros;
   ModelMetadata metadata_;
   std::vector<MemoryAllocators> next_allocators_;
   BatchPtrQueue* next_ = nullptr;
@@ -333,6 +355,162 @@ class MultiThreadedWorker : public Worker {
   util::ThreadPool thread_pool_;
 };
 
+/**
+ * @brief A request run a step at a time by a ContinuousWorker, such as a
+ * sequence being generated by an autoregressive model
+ */
+struct Sequence {
+  InferenceRequestPtr request;
+  /// Number of steps that have run for this sequence
+  size_t step = 0;
+  /// Set by the worker once it has sent the sequence's final response
+  bool finished = false;
+  /// The batch the request came in, which holds its input data
+  std::shared_ptr<Batch> batch;
+};
+
+/**
+ * @brief Continuous workers schedule at the level of steps rather than
+ * batches. Each step runs every active sequence once and finished sequences
+ * leave while new requests join at the step boundaries so a long sequence
+ * doesn't hold up the others. The worker's batch size is the maximum number of
+ * active sequences.
+ */
+class ContinuousWorker : public Worker {
+ public:
+  using Worker::Worker;
+
+  /// Steps may stream their outputs before the sequence's final response
+  [[nodiscard]] bool isStreaming() const override { return true; }
+
+  std::vector<std::unique_ptr<Batcher>> makeBatcher(
+    int num, ParameterMap* parameters, MemoryPool* pool) override {
+    // pass on requests as they arrive rather than waiting to fill a batch and
+    // pack just the requests' data since each batch may only be partly full
+    ParameterMap batcher_parameters;
+    if (parameters != nullptr) {
+      batcher_parameters = *parameters;
+    }
+    if (!batcher_parameters.has("timeout")) {
+      const int32_t timeout = 0;
+      batcher_parameters.put("timeout", timeout);
+    }
+    batcher_parameters.put("ragged", true);
+    return this->Worker::makeBatcher<SoftBatcher>(num, &batcher_parameters,
+                                                  pool);
+  }
+
+  /**
+   * @brief The main body of the worker executes the work
+   *
+   * @param input_queue queue that receives incoming requests
+   */
+  void run(BatchPtrQueue* input_queue, const MemoryPool* pool) override {
+    this->status_ = WorkerStatus::Run;
+    const auto& name = this->getName();
+    AMDINFER_IF_LOGGING(const auto logger = this->getLogger();)
+    util::setThreadName(name);
+
+    std::vector<Sequence> active;
+    std::deque<Sequence> waiting;
+    bool run = true;
+    while (run || !active.empty() || !waiting.empty()) {
+      // new requests join at step boundaries. Only wait for them if there's
+      // nothing else to do
+      while (run) {
+        BatchPtr batch;
+        if (active.empty() && waiting.empty()) {
+          input_queue->wait_dequeue(batch);
+        } else if (!input_queue->try_dequeue(batch)) {
+          break;
+        }
+        if (batch == nullptr) {
+          run = false;
+          break;
+        }
+        this->addBatch(std::move(batch), &waiting);
+        AMDINFER_LOG_INFO(logger, "Got request in " + name);
+      }
+
+      while (!waiting.empty() && active.size() < this->batch_size_) {
+        active.push_back(std::move(waiting.front()));
+        waiting.pop_front();
+      }
+      if (active.empty()) {
+        continue;
+      }
+
+      try {
+        this->doStep(active, pool);
+      } catch (const std::exception& e) {
+        // the sequences can't continue if a step fails partway through
+        for (auto& sequence : active) {
+          sequence.request->runCallbackError(e.what());
+          sequence.finished = true;
+        }
+      }
+      for (auto& sequence : active) {
+        sequence.step++;
+      }
+      active.erase(std::remove_if(active.begin(), active.end(),
+                                  [](const Sequence& sequence) {
+                                    return sequence.finished;
+                                  }),
+                   active.end());
+    }
+
+    AMDINFER_LOG_INFO(logger, name + " ending");
+
+    status_ = WorkerStatus::Inactive;
+  }
+
+ protected:
+  /**
+   * @brief Run one step of each active sequence. The worker may stream each
+   * step's outputs with the request's runCallback(). Once a sequence is done,
+   * the worker sends its final response with runCallbackOnce() and marks it
+   * as finished so it leaves before the next step.
+   *
+   * @param sequences the active sequences, in the order they joined
+   * @param pool the memory pool
+   */
+  virtual void doStep(std::vector<Sequence>& sequences,
+                      const MemoryPool* pool) = 0;
+
+  /// Continuous workers run steps rather than whole batches
+  std::unique_ptr<Batch> doRun([[maybe_unused]] Batch* batch,
+                               [[maybe_unused]] const MemoryPool* pool) final {
+    return nullptr;
+  }
+
+ private:
+  /// Queue the batch's requests as new sequences that share the batch
+  void addBatch(BatchPtr batch, std::deque<Sequence>* waiting) const {
+#ifdef AMDINFER_ENABLE_TRACING
+    for (auto i = 0U; i < batch->size(); ++i) {
+      batch->getTrace(i)->startSpan(this->getName().c_str());
+    }
+#endif
+#ifdef AMDINFER_ENABLE_METRICS
+    Metrics::getInstance().incrementCounter(
+      MetricCounterIDs::PipelineIngressWorker);
+#endif
+    // the buffers are freed once all of the batch's sequences have finished
+    auto free_buffers = [](Batch* finished) {
+      for (const auto& buffer : finished->getInputBuffers()) {
+        buffer->free();
+      }
+      delete finished;  // NOLINT(cppcoreguidelines-owning-memory)
+    };
+    std::shared_ptr<Batch> shared{batch.release(), free_buffers};
+    for (const auto& request : *shared) {
+      waiting->push_back(Sequence{request, 0, false, shared});
+    }
+  }
+
+  using Worker::status_;
+};
+
 }  // namespace workers
 
 }  // namespace amdinfer
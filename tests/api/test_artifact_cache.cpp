@@ -0,0 +1,85 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Loads a worker with a slow compile step twice and checks that the
+ * second load reuses the compiled artifact until the model file changes
+ */
+
+#include <chrono>      // for milliseconds, steady_clock, duration_cast
+#include <cstdint>     // for int32_t, int64_t
+#include <filesystem>  // for path, remove_all, directory_iterator
+#include <fstream>     // for ofstream
+#include <iterator>    // for distance
+#include <string>      // for string
+
+#include "amdinfer/amdinfer.hpp"                // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"  // for BaseFixture
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+/// Load the worker and return how long it took in milliseconds
+int64_t timeLoad(const NativeClient& client, const ParameterMap& parameters) {
+  const auto start = std::chrono::steady_clock::now();
+  const auto endpoint = client.workerLoad("fake", parameters);
+  const auto duration = std::chrono::steady_clock::now() - start;
+  EXPECT_TRUE(client.modelReady(endpoint));
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+  return std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+    .count();
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, ArtifactCache) {
+  const NativeClient client(&server_);
+  const auto directory =
+    fs::temp_directory_path() / "amdinfer_test_artifact_cache";
+  fs::remove_all(directory);
+  fs::create_directories(directory);
+  const auto model = directory / "model.bin";
+  const auto cache = directory / "cache";
+  std::ofstream{model} << "model";
+
+  const int32_t compile_delay = 1000;
+  ParameterMap parameters;
+  parameters.put("model", model.string());
+  parameters.put("compile_delay", compile_delay);
+  parameters.put("artifact_cache", cache.string());
+
+  auto count_artifacts = [&cache]() {
+    return std::distance(fs::directory_iterator(cache),
+                         fs::directory_iterator{});
+  };
+
+  EXPECT_GE(timeLoad(client, parameters), compile_delay);
+  EXPECT_EQ(count_artifacts(), 1);
+
+  // the artifact is reused so the second load skips compiling
+  EXPECT_LT(timeLoad(client, parameters), compile_delay);
+  EXPECT_EQ(count_artifacts(), 1);
+
+  // changing the model file's contents compiles it again
+  std::ofstream{model} << "changed";
+  EXPECT_GE(timeLoad(client, parameters), compile_delay);
+  EXPECT_EQ(count_artifacts(), 2);
+
+  fs::remove_all(directory);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,90 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Loads a worker whose latency grows with its batch size and checks
+ * that profiling picks the largest batch that stays within the latency target
+ */
+
+#include <cstdint>     // for int32_t
+#include <filesystem>  // for path, remove, temp_directory_path
+#include <fstream>     // for ifstream, ofstream
+#include <sstream>     // for stringstream
+#include <string>      // for string, getline
+
+#include "amdinfer/amdinfer.hpp"                // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"  // for BaseFixture
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+std::string readValue(const fs::path& path, const std::string& key) {
+  std::ifstream file{path};
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.rfind(key + " = ", 0) == 0) {
+      return line.substr(key.size() + 3);
+    }
+  }
+  return "";
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, Autotune) {
+  const NativeClient client(&server_);
+  const auto cache = fs::temp_directory_path() / "amdinfer_test_autotune.toml";
+  fs::remove(cache);
+
+  // each batch takes 10 ms + 5 ms per request so batches of 1, 2, 4, 8 and 16
+  // take 15, 20, 30, 50 and 90 ms. With a 40 ms target, 4 is the best
+  const int32_t delay = 10;
+  const int32_t delay_per_request = 5;
+  const int32_t rounds = 2;
+  ParameterMap parameters;
+  parameters.put("delay", delay);
+  parameters.put("delay_per_request", delay_per_request);
+  parameters.put("autotune_latency", 40.0);
+  parameters.put("autotune_batch_sizes", "1,2,4,8,16");
+  parameters.put("autotune_rounds", rounds);
+  parameters.put("autotune_cache", cache.string());
+
+  auto endpoint = client.workerLoad("fake", parameters);
+  EXPECT_TRUE(client.modelReady(endpoint));
+  EXPECT_EQ(readValue(cache, "batch_size"), "4");
+  const auto timeout = std::stoi(readValue(cache, "timeout"));
+  EXPECT_GE(timeout, 0);
+  EXPECT_LE(timeout, 10);
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+
+  // a matching cache is used as is instead of profiling again
+  std::stringstream contents;
+  contents << std::ifstream{cache}.rdbuf();
+  auto edited = contents.str();
+  edited.replace(edited.find("batch_size = 4"), 14, "batch_size = 2");
+  std::ofstream{cache} << edited;
+
+  endpoint = client.workerLoad("fake", parameters);
+  EXPECT_TRUE(client.modelReady(endpoint));
+  EXPECT_EQ(readValue(cache, "batch_size"), "2");
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+
+  fs::remove(cache);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,82 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Stress test that sends inference requests while the target endpoint
+ * is repeatedly loaded and unloaded. Every request must either succeed or fail
+ * cleanly: none may crash the server or wait forever for a response.
+ */
+
+#include <atomic>   // for atomic
+#include <cstdint>  // for uint32_t
+#include <string>   // for string
+#include <thread>   // for thread
+#include <vector>   // for vector
+
+#include "amdinfer/amdinfer.hpp"                // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"  // for BaseFixture
+
+namespace amdinfer {
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, InferDuringLoadAndUnload) {
+  const NativeClient client(&server_);
+  const ParameterMap parameters{{"model"}, {std::string{"echo"}}};
+  const auto endpoint = client.workerLoad("cplusplus", parameters);
+
+  const auto kInferThreads = 8;
+  const auto kCycles = 50;
+
+  std::atomic_bool done = false;
+  std::atomic_int succeeded = 0;
+  std::vector<std::thread> threads;
+  threads.reserve(kInferThreads);
+  for (auto i = 0; i < kInferThreads; ++i) {
+    threads.emplace_back([&]() {
+      std::vector<uint32_t> data{1};
+      InferenceRequest request;
+      request.addInputTensor(data.data(), {1}, DataType::Uint32);
+      while (!done) {
+        try {
+          auto response = client.modelInfer(endpoint, request);
+          if (!response.isError()) {
+            const auto* output =
+              static_cast<uint32_t*>(response.getOutputs()[0].getData());
+            EXPECT_EQ(output[0], 2);
+            succeeded++;
+          }
+        } catch (const invalid_argument&) {
+          // the endpoint doesn't exist right now
+        }
+      }
+    });
+  }
+
+  for (auto i = 0; i < kCycles; ++i) {
+    client.workerUnload(endpoint);
+    EXPECT_EQ(client.workerLoad("cplusplus", parameters), endpoint);
+  }
+
+  done = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_GT(succeeded, 0);
+
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,93 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Loads models from a repository on the first request to them and
+ * checks that the least recently used idle model is unloaded once more models
+ * are loaded than the cache allows
+ */
+
+#include <cstdint>     // for uint32_t
+#include <filesystem>  // for path, create_directories, temp_directory_path
+#include <string>      // for string
+#include <tuple>       // for ignore
+#include <vector>      // for vector
+
+#include "amdinfer/amdinfer.hpp"                  // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"    // for BaseFixture
+#include "amdinfer/testing/model_repository.hpp"  // for addEchoModel
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+void expectEcho(const NativeClient& client, const std::string& model) {
+  std::vector<uint32_t> data{1};
+  InferenceRequest request;
+  request.addInputTensor(data.data(), {1}, DataType::Uint32);
+  auto response = client.modelInfer(model, request);
+  ASSERT_FALSE(response.isError()) << response.getError();
+  const auto* output =
+    static_cast<uint32_t*>(response.getOutputs()[0].getData());
+  EXPECT_EQ(output[0], 2);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, ModelCache) {
+  const auto repository = fs::temp_directory_path() / "amdinfer_model_cache";
+  fs::remove_all(repository);
+  const std::vector<std::string> models{"echo_0", "echo_1", "echo_2"};
+  for (const auto& model : models) {
+    addEchoModel(repository, model);
+  }
+
+  server_.setModelRepository(repository, false);
+  ModelCacheOptions options;
+  options.max_models = 2;
+  server_.enableModelCache(options);
+  const NativeClient client(&server_);
+
+  // models are loaded by the first request to them
+  EXPECT_FALSE(client.modelReady("echo_0"));
+  expectEcho(client, "echo_0");
+  EXPECT_TRUE(client.modelReady("echo_0"));
+  expectEcho(client, "echo_1");
+  expectEcho(client, "echo_0");
+
+  // echo_1 is the least recently used so it's evicted to make room
+  expectEcho(client, "echo_2");
+  waitUntilModelNotReady(&client, "echo_1");
+  EXPECT_TRUE(client.modelReady("echo_0"));
+  EXPECT_TRUE(client.modelReady("echo_2"));
+
+  // and it's loaded again on demand
+  expectEcho(client, "echo_1");
+  waitUntilModelNotReady(&client, "echo_0");
+
+  // models that aren't in the repository are still an error
+  std::vector<uint32_t> data{1};
+  InferenceRequest request;
+  request.addInputTensor(data.data(), {1}, DataType::Uint32);
+  EXPECT_THROW(std::ignore = client.modelInfer("echo_3", request),
+               invalid_argument);
+
+  for (const auto& model : models) {
+    client.modelUnload(model);
+    waitUntilModelNotReady(&client, model);
+  }
+  fs::remove_all(repository);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,95 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Changes the batching parameters and worker count of a loaded worker
+ * and checks that requests see the change without reloading it
+ */
+
+#include <chrono>   // for milliseconds, steady_clock
+#include <cstdint>  // for int32_t, uint32_t
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "amdinfer/amdinfer.hpp"                // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"  // for BaseFixture
+
+namespace amdinfer {
+
+/// Make one request and return how long it took
+std::chrono::milliseconds timeRequest(const NativeClient& client,
+                                      const std::string& endpoint) {
+  std::vector<uint32_t> data{1};
+  InferenceRequest request;
+  request.addInputTensor(data.data(), {1}, DataType::Uint32);
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto response = client.modelInfer(endpoint, request);
+  EXPECT_FALSE(response.isError());
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, ModelConfigure) {
+  const NativeClient client(&server_);
+  // a lone request waits for the timeout because the batch never fills
+  const int32_t batch_size = 4;
+  const int32_t timeout = 500;
+  ParameterMap parameters;
+  parameters.put("batch_size", batch_size);
+  parameters.put("timeout", timeout);
+  const auto endpoint = client.workerLoad("fake", parameters);
+  EXPECT_GE(timeRequest(client, endpoint).count(), timeout);
+
+  // a batch of one is full as soon as the request arrives
+  const int32_t new_batch_size = 1;
+  ParameterMap batching;
+  batching.put("batch_size", new_batch_size);
+  client.modelConfigure(endpoint, batching);
+  EXPECT_LT(timeRequest(client, endpoint).count(), timeout / 2);
+
+  // as is a batch with a short timeout
+  const int32_t new_timeout = 1;
+  batching.put("batch_size", batch_size);
+  batching.put("timeout", new_timeout);
+  client.modelConfigure(endpoint, batching);
+  EXPECT_LT(timeRequest(client, endpoint).count(), timeout / 2);
+
+  const int32_t workers = 3;
+  ParameterMap scaling;
+  scaling.put("workers", workers);
+  client.modelConfigure(endpoint, scaling);
+  scaling.put("workers", 1);
+  client.modelConfigure(endpoint, scaling);
+  EXPECT_LT(timeRequest(client, endpoint).count(), timeout / 2);
+
+  // nothing changes if any parameter can't be applied
+  ParameterMap invalid;
+  invalid.put("batch_size", 2 * batch_size);
+  EXPECT_THROW(client.modelConfigure(endpoint, invalid), invalid_argument);
+  invalid = ParameterMap{};
+  invalid.put("model", "other");
+  EXPECT_THROW(client.modelConfigure(endpoint, invalid), invalid_argument);
+  EXPECT_THROW(client.modelConfigure("does_not_exist", batching),
+               invalid_argument);
+  EXPECT_LT(timeRequest(client, endpoint).count(), timeout / 2);
+
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+}
+
+}  // namespace amdinfer
@@ -15,6 +15,7 @@
 
 #include <cstdint>  // for uint8_t, uint64_t, uin...
 #include <memory>   // for allocator, unique_ptr
+#include <tuple>    // for ignore
 #include <vector>   // for vector
 
 #include "amdinfer/amdinfer.hpp"                // for InferenceResponse, Grp...
@@ -64,6 +65,38 @@ TEST_F(BaseFixture, ModelInfer) {
   test(&client);
 }
 
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, ModelInferHandle) {
+  NativeClient client(&server_);
+  const ParameterMap parameters{{"model"}, {std::string{"echo"}}};
+  auto endpoint = client.workerLoad("cplusplus", parameters);
+
+  std::vector<uint32_t> data{1};
+  InferenceRequest request;
+  request.addInputTensor(data.data(), {1}, DataType::Uint32);
+
+  auto handle = client.modelHandle(endpoint);
+  const auto generation = handle.generation;
+  EXPECT_NE(generation, 0);
+  auto response = client.modelInfer(&handle, request);
+  ASSERT_FALSE(response.isError());
+  EXPECT_EQ(*static_cast<uint32_t*>(response.getOutputs()[0].getData()), 2);
+  EXPECT_EQ(handle.generation, generation);
+
+  // reloading the endpoint makes the handle stale so it's resolved again
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+  endpoint = client.workerLoad("cplusplus", parameters);
+  response = client.modelInfer(&handle, request);
+  ASSERT_FALSE(response.isError());
+  EXPECT_NE(handle.generation, generation);
+
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+  EXPECT_THROW(std::ignore = client.modelInfer(&handle, request),
+               invalid_argument);
+}
+
 #ifdef AMDINFER_ENABLE_HTTP
 // NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
 TEST_F(HttpFixture, ModelInfer) { test(client_.get()); }
@@ -0,0 +1,106 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Swaps a model between versions repeatedly while clients keep sending
+ * requests to it and checks that no request fails or stalls
+ */
+
+#include <algorithm>   // for max
+#include <atomic>      // for atomic
+#include <chrono>      // for milliseconds, steady_clock
+#include <cstdint>     // for uint32_t
+#include <filesystem>  // for path, create_directories, temp_directory_path
+#include <string>      // for string
+#include <thread>      // for thread
+#include <vector>      // for vector
+
+#include "amdinfer/amdinfer.hpp"                  // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"    // for BaseFixture
+#include "amdinfer/testing/model_repository.hpp"  // for addEchoModel
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, ModelSwap) {
+  const auto repository = fs::temp_directory_path() / "amdinfer_model_swap";
+  fs::remove_all(repository);
+  const std::string model = "swap";
+  addEchoModel(repository, model, {"1", "2"});
+
+  server_.setModelRepository(repository, false);
+  const NativeClient client(&server_);
+  client.modelLoad(model, {});
+
+  // no request should wait anywhere near this long. An endpoint that goes away
+  // during a swap shows up as errors and a queue that stalls shows up here
+  const std::chrono::milliseconds max_latency{500};
+  const auto clients = 8;
+  const auto swaps = 20;
+
+  std::atomic<bool> run = true;
+  std::atomic<int> errors = 0;
+  std::atomic<int> requests = 0;
+  // the worst latency seen by each client
+  std::vector<std::chrono::steady_clock::duration> worst(clients);
+  std::vector<std::thread> threads;
+  threads.reserve(clients);
+  for (auto i = 0; i < clients; ++i) {
+    threads.emplace_back([&, i]() {
+      std::vector<uint32_t> data{1};
+      InferenceRequest request;
+      request.addInputTensor(data.data(), {1}, DataType::Uint32);
+      while (run) {
+        const auto start = std::chrono::steady_clock::now();
+        auto response = client.modelInfer(model, request);
+        worst[i] = std::max(worst[i], std::chrono::steady_clock::now() - start);
+        requests++;
+        if (response.isError()) {
+          errors++;
+          continue;
+        }
+        const auto* output =
+          static_cast<uint32_t*>(response.getOutputs()[0].getData());
+        if (output[0] != 2) {
+          errors++;
+        }
+      }
+    });
+  }
+
+  for (auto i = 0; i < swaps; ++i) {
+    client.modelSwap(model, {}, i % 2 == 0 ? "2" : "");
+    EXPECT_TRUE(client.modelReady(model));
+  }
+  run = false;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_GT(requests, 0);
+  EXPECT_EQ(errors, 0);
+  for (const auto& latency : worst) {
+    EXPECT_LT(latency, max_latency);
+  }
+
+  client.modelUnload(model);
+  waitUntilModelNotReady(&client, model);
+  fs::remove_all(repository);
+}
+
+}  // namespace amdinfer
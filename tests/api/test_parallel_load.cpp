@@ -0,0 +1,95 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Loads several slow workers at the same time. Independent loads run in
+ * parallel so the total time should approach that of the slowest one rather
+ * than the sum of all of them.
+ */
+
+#include <chrono>   // for milliseconds, steady_clock
+#include <cstdint>  // for int32_t
+#include <string>   // for string
+#include <thread>   // for thread
+#include <vector>   // for vector
+
+#include "amdinfer/amdinfer.hpp"                // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"  // for BaseFixture
+
+namespace amdinfer {
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, ParallelLoad) {
+  const NativeClient client(&server_);
+  // the fake worker sleeps for this long in both init and acquire
+  const std::vector<int32_t> delays{500, 1000, 1500};
+  const auto slowest = std::chrono::milliseconds(2 * delays.back());
+  std::chrono::milliseconds sum{0};
+  for (const auto& delay : delays) {
+    sum += std::chrono::milliseconds(2 * delay);
+  }
+
+  std::vector<std::string> endpoints(delays.size());
+  std::vector<std::thread> threads;
+  threads.reserve(delays.size());
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < delays.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      ParameterMap parameters;
+      parameters.put("load_delay", delays[i]);
+      endpoints[i] = client.workerLoad("fake", parameters);
+    });
+  }
+
+  // while they're loading, the endpoints are not ready but asking doesn't wait
+  // for the loads to finish. Whichever load started first got this name
+  std::this_thread::sleep_for(std::chrono::milliseconds(delays.front()));
+  const auto query_start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(client.modelReady("fake"));
+  EXPECT_LT(std::chrono::steady_clock::now() - query_start,
+            std::chrono::milliseconds(delays.front()));
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, slowest);
+  EXPECT_LT(elapsed, sum);
+
+  for (const auto& endpoint : endpoints) {
+    EXPECT_TRUE(client.modelReady(endpoint));
+    client.workerUnload(endpoint);
+    waitUntilModelNotReady(&client, endpoint);
+  }
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, ParallelLoadFailure) {
+  const NativeClient client(&server_);
+  ParameterMap parameters;
+  parameters.put("load_delay", 100);
+  const auto endpoint = client.workerLoad("fake", parameters);
+
+  // a failed load doesn't affect the other endpoints
+  EXPECT_THROW(client.workerLoad("does_not_exist", {}),
+               file_not_found_error);
+  EXPECT_FALSE(client.modelReady("does_not_exist"));
+  EXPECT_TRUE(client.modelReady(endpoint));
+
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+}
+
+}  // namespace amdinfer
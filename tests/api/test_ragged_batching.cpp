@@ -0,0 +1,73 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Sends requests of different lengths to a worker using ragged batches
+ * and checks that they're batched together and each gets its own data back
+ */
+
+#include <cstdint>  // for uint32_t, int32_t, int64_t
+#include <vector>   // for vector
+
+#include "amdinfer/amdinfer.hpp"                // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"  // for BaseFixture
+
+namespace amdinfer {
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, RaggedBatching) {
+  const NativeClient client(&server_);
+  const int32_t batch_size = 4;
+  const int32_t timeout = 10000;
+  ParameterMap parameters;
+  parameters.put("batch_size", batch_size);
+  parameters.put("timeout", timeout);
+  const auto endpoint = client.workerLoad("raggedecho", parameters);
+  EXPECT_TRUE(client.modelReady(endpoint));
+
+  std::vector<std::vector<uint32_t>> data{
+    {1}, {2, 3, 4}, {5, 6}, {7, 8, 9, 10, 11}};
+  std::vector<InferenceRequest> requests;
+  for (auto& request_data : data) {
+    InferenceRequest request;
+    request.addInputTensor(request_data.data(),
+                           {static_cast<int64_t>(request_data.size())},
+                           DataType::Uint32);
+    requests.push_back(request);
+  }
+
+  // all the requests are sent before waiting so they form one batch well
+  // before the timeout
+  const auto responses = inferAsyncOrdered(&client, endpoint, requests);
+  ASSERT_EQ(responses.size(), data.size());
+  for (auto i = 0U; i < data.size(); ++i) {
+    const auto& response = responses[i];
+    ASSERT_FALSE(response.isError());
+    EXPECT_EQ(response.getParameters()->get<int32_t>("batch_size"),
+              batch_size);
+    const auto& outputs = response.getOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    EXPECT_EQ(outputs[0].getShape(),
+              (std::vector<int64_t>{static_cast<int64_t>(data[i].size())}));
+    const auto* output = static_cast<const uint32_t*>(outputs[0].getData());
+    EXPECT_EQ((std::vector<uint32_t>{output, output + data[i].size()}),
+              data[i]);
+  }
+
+  client.workerUnload(endpoint);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,77 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Sends interleaved sequences of requests to a stateful worker and
+ * checks that each sequence keeps its own state
+ */
+
+#include <cstdint>  // for int32_t
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "amdinfer/amdinfer.hpp"                // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"  // for BaseFixture
+
+namespace amdinfer {
+
+InferenceRequest makeStep(const std::string& id, int32_t* value, bool start,
+                          bool end) {
+  InferenceRequest request;
+  request.addInputTensor(value, {1}, DataType::Int32);
+  ParameterMap parameters;
+  parameters.put("sequence_id", id);
+  parameters.put("sequence_start", start);
+  parameters.put("sequence_end", end);
+  request.setParameters(parameters);
+  return request;
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, SequenceBatching) {
+  const NativeClient client(&server_);
+  const int32_t batch_size = 2;
+  ParameterMap parameters;
+  parameters.put("batch_size", batch_size);
+  const auto endpoint = client.workerLoad("accumulate", parameters);
+  EXPECT_TRUE(client.modelReady(endpoint));
+
+  // a sequence's state is kept only by its one worker
+  parameters.put("share", false);
+  EXPECT_THROW(client.workerLoad("accumulate", parameters), invalid_argument);
+
+  const std::vector<std::string> ids{"a", "b"};
+  std::vector<int32_t> values{1, 10, 2, 20, 3, 30};
+  const std::vector<int32_t> sums{1, 10, 3, 30, 6, 60};
+  const auto steps = static_cast<int>(values.size() / ids.size());
+  for (auto i = 0U; i < values.size(); ++i) {
+    const auto step = static_cast<int>(i / ids.size());
+    const auto request = makeStep(ids[i % ids.size()], &values[i], step == 0,
+                                  step == steps - 1);
+    const auto response = client.modelInfer(endpoint, request);
+    ASSERT_FALSE(response.isError()) << response.getError();
+    const auto& outputs = response.getOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    EXPECT_EQ(*static_cast<const int32_t*>(outputs[0].getData()), sums[i]);
+  }
+
+  // the sequences have ended
+  auto request = makeStep("a", values.data(), false, false);
+  EXPECT_THROW(client.modelInfer(endpoint, request), runtime_error);
+
+  client.workerUnload(endpoint);
+}
+
+}  // namespace amdinfer
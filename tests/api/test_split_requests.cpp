@@ -0,0 +1,92 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Sends a request with more samples than the batch size to a worker
+ * group that splits requests and checks that its samples run across the
+ * group's workers and are reassembled in order
+ */
+
+#include <chrono>   // for milliseconds, steady_clock
+#include <cstdint>  // for int32_t, uint32_t, int64_t
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "amdinfer/amdinfer.hpp"                // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"  // for BaseFixture
+
+namespace amdinfer {
+
+/// Send a request with the samples and check the response echoes them
+std::chrono::milliseconds timeSplitRequest(const NativeClient& client,
+                                           const std::string& endpoint,
+                                           std::vector<uint32_t> samples) {
+  InferenceRequest request;
+  request.addInputTensor(samples.data(),
+                         {static_cast<int64_t>(samples.size())},
+                         DataType::Uint32);
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto response = client.modelInfer(endpoint, request);
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start);
+
+  EXPECT_FALSE(response.isError());
+  const auto& outputs = response.getOutputs();
+  EXPECT_EQ(outputs.size(), 1);
+  if (!outputs.empty()) {
+    EXPECT_EQ(outputs[0].getShape(),
+              (std::vector<int64_t>{static_cast<int64_t>(samples.size())}));
+    const auto* data = static_cast<const uint32_t*>(outputs[0].getData());
+    EXPECT_EQ((std::vector<uint32_t>{data, data + samples.size()}), samples);
+  }
+  return elapsed;
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, SplitRequests) {
+  const NativeClient client(&server_);
+  // the eight samples are split into one request each, which fill four
+  // batches of two that each take the delay to run
+  const int32_t batch_size = 2;
+  const int32_t timeout = 100;
+  const int32_t delay = 500;
+  ParameterMap parameters;
+  parameters.put("batch_size", batch_size);
+  parameters.put("timeout", timeout);
+  parameters.put("delay", delay);
+  parameters.put("split_requests", true);
+  const auto endpoint = client.workerLoad("fake", parameters);
+  const std::vector<uint32_t> samples{1, 2, 3, 4, 5, 6, 7, 8};
+
+  // one worker runs the batches one after the other
+  const auto batches = 4;
+  EXPECT_GE(timeSplitRequest(client, endpoint, samples).count(),
+            batches * delay);
+
+  // two workers run them two at a time
+  const int32_t workers = 2;
+  ParameterMap scaling;
+  scaling.put("workers", workers);
+  client.modelConfigure(endpoint, scaling);
+  EXPECT_LT(timeSplitRequest(client, endpoint, samples).count(),
+            batches * delay);
+
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,86 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Loads workers that are warmed up before they're ready and checks that
+ * the endpoint only becomes ready once warmup is done and that a failed warmup
+ * fails the load
+ */
+
+#include <chrono>   // for milliseconds, steady_clock
+#include <cstdint>  // for int32_t
+#include <string>   // for string
+#include <thread>   // for thread, sleep_for
+
+#include "amdinfer/amdinfer.hpp"                // for NativeClient
+#include "amdinfer/testing/gtest_fixtures.hpp"  // for BaseFixture
+
+namespace amdinfer {
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, Warmup) {
+  const NativeClient client(&server_);
+  // the fake worker sleeps for the load delay in both init and acquire and
+  // then each of the warmup requests takes the delay to run
+  const int32_t load_delay = 100;
+  const int32_t delay = 500;
+  const int32_t count = 2;
+  ParameterMap parameters;
+  parameters.put("load_delay", load_delay);
+  parameters.put("delay", delay);
+  parameters.put("warmup_batch_sizes", "1");
+  parameters.put("warmup_count", count);
+
+  std::string endpoint;
+  const auto start = std::chrono::steady_clock::now();
+  std::thread load{
+    [&]() { endpoint = client.workerLoad("fake", parameters); }};
+
+  // by now the worker has loaded but it's still running warmup requests
+  const auto loaded = std::chrono::milliseconds(2 * load_delay);
+  std::this_thread::sleep_for(loaded + std::chrono::milliseconds(delay));
+  EXPECT_FALSE(client.modelReady("fake"));
+
+  load.join();
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            loaded + std::chrono::milliseconds(count * delay));
+  EXPECT_TRUE(client.modelReady(endpoint));
+
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(BaseFixture, WarmupFailure) {
+  const NativeClient client(&server_);
+  ParameterMap parameters;
+  parameters.put("load_delay", 100);
+  parameters.put("fail_requests", true);
+  parameters.put("warmup_batch_sizes", "1");
+
+  EXPECT_THROW(client.workerLoad("fake", parameters), runtime_error);
+  EXPECT_FALSE(client.modelReady("fake"));
+
+  // without warmup, the same worker loads
+  parameters.erase("warmup_batch_sizes");
+  const auto endpoint = client.workerLoad("fake", parameters);
+  EXPECT_TRUE(client.modelReady(endpoint));
+
+  client.workerUnload(endpoint);
+  waitUntilModelNotReady(&client, endpoint);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,127 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Compares the tail latency of bursty traffic to a worker with a fixed
+ * number of instances and to one that's autoscaled. Each iteration sends a
+ * burst of requests at once and then waits before the next one. The latency
+ * percentiles are reported as counters in milliseconds.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>  // for sort
+#include <chrono>     // for steady_clock, duration, milliseconds
+#include <cstdint>    // for uint32_t
+#include <string>     // for string
+#include <thread>     // for sleep_for
+#include <vector>     // for vector
+
+#include "amdinfer/amdinfer.hpp"  // for NativeClient, Server, ParameterMap
+
+namespace amdinfer {
+
+// milliseconds that the fake worker takes for each batch
+const auto kDelay = 5;
+// milliseconds between bursts
+const auto kGap = 200;
+
+double percentile(std::vector<double>* latencies, double fraction) {
+  std::sort(latencies->begin(), latencies->end());
+  const auto index = static_cast<size_t>(
+    fraction * static_cast<double>(latencies->size() - 1));
+  return latencies->at(index);
+}
+
+// NOLINTNEXTLINE(google-runtime-references)
+void burstyLoad(benchmark::State& st, const Server* server,
+                const std::string* endpoint) {
+  const NativeClient client{server};
+  const auto burst = st.range(0);
+
+  std::vector<uint32_t> data{1};
+  InferenceRequest request;
+  request.addInputTensor(data.data(), {1}, DataType::Uint32);
+
+  std::vector<double> latencies;
+  std::vector<InferenceResponseFuture> futures;
+  futures.reserve(burst);
+  for ([[maybe_unused]] auto _ : st) {
+    const auto start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < burst; ++i) {
+      futures.push_back(client.modelInferAsync(*endpoint, request));
+    }
+    // responses come back roughly in order so waiting for them in order only
+    // slightly overestimates the early ones
+    for (auto& future : futures) {
+      if (future.get().isError()) {
+        st.SkipWithError("Error response from the server");
+        return;
+      }
+      latencies.push_back(std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+    }
+    futures.clear();
+
+    st.PauseTiming();
+    std::this_thread::sleep_for(std::chrono::milliseconds(kGap));
+    st.ResumeTiming();
+  }
+  st.counters["p50_ms"] = percentile(&latencies, 0.5);
+  st.counters["p99_ms"] = percentile(&latencies, 0.99);
+  st.SetItemsProcessed(st.iterations() * burst);
+}
+
+}  // namespace amdinfer
+
+int main(int argc, char* argv[]) {
+  amdinfer::Server server;
+  const amdinfer::NativeClient client{&server};
+
+  amdinfer::ParameterMap parameters;
+  parameters.put("delay", amdinfer::kDelay);
+  const auto fixed = client.workerLoad("fake", parameters);
+
+  // stays scaled up between bursts but otherwise has the same parameters
+  parameters.put("autoscale_max_workers", 8);
+  parameters.put("autoscale_cooldown", 2 * amdinfer::kGap);
+  const auto autoscaled = client.workerLoad("fake", parameters);
+  amdinfer::waitUntilModelReady(&client, fixed);
+  amdinfer::waitUntilModelReady(&client, autoscaled);
+
+  for (const auto* endpoint : {&fixed, &autoscaled}) {
+    const auto name = std::string{"BurstyLoad/"} +
+                      (endpoint == &fixed ? "fixed" : "autoscaled");
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    benchmark::RegisterBenchmark(name.c_str(), amdinfer::burstyLoad, &server,
+                                 endpoint)
+      ->ArgName("burst")
+      ->Arg(16)
+      ->Arg(64)
+      ->Iterations(20)
+      ->UseRealTime()
+      ->Unit(benchmark::kMillisecond);
+  }
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  client.workerUnload(fixed);
+  client.workerUnload(autoscaled);
+  return 0;
+}
@@ -0,0 +1,95 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Measures the CPU used by the server while it answers a steady rate of
+ * readiness probes, like those sent by load balancers. The cpu_utilization
+ * counter is the process CPU time divided by the wall time so 1.0 is one fully
+ * busy core.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>  // for steady_clock, duration
+#include <ctime>   // for clock, CLOCKS_PER_SEC
+#include <string>  // for string
+#include <thread>  // for sleep_until
+
+#include "amdinfer/amdinfer.hpp"  // for NativeClient, Server
+
+namespace amdinfer {
+
+// NOLINTNEXTLINE(google-runtime-references)
+void readinessProbes(benchmark::State& st, const Server* server,
+                     const std::string* endpoint) {
+  const NativeClient client{server};
+  const auto probes_per_second = st.range(0);
+  const auto period = std::chrono::nanoseconds(std::chrono::seconds(1)) /
+                      probes_per_second;
+
+  double cpu_seconds = 0;
+  double wall_seconds = 0;
+  for ([[maybe_unused]] auto _ : st) {
+    const auto wall_start = std::chrono::steady_clock::now();
+    const auto cpu_start = std::clock();
+
+    // send one second's worth of probes at a steady rate
+    auto next = wall_start;
+    for (auto i = 0; i < probes_per_second; ++i) {
+      if (!client.modelReady(*endpoint)) {
+        st.SkipWithError("Model is not ready");
+        return;
+      }
+      next += period;
+      std::this_thread::sleep_until(next);
+    }
+
+    cpu_seconds +=
+      static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    wall_seconds += std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - wall_start)
+                      .count();
+  }
+  st.counters["cpu_utilization"] = cpu_seconds / wall_seconds;
+  st.SetItemsProcessed(st.iterations() * probes_per_second);
+}
+
+}  // namespace amdinfer
+
+int main(int argc, char* argv[]) {
+  amdinfer::Server server;
+  const amdinfer::NativeClient client{&server};
+  const auto endpoint =
+    client.workerLoad("cplusplus", {{"model"}, {std::string{"echo"}}});
+  amdinfer::waitUntilModelReady(&client, endpoint);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  benchmark::RegisterBenchmark("ReadinessProbes", amdinfer::readinessProbes,
+                               &server, &endpoint)
+    ->ArgName("probes_per_second")
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Iterations(3)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  client.workerUnload(endpoint);
+  return 0;
+}
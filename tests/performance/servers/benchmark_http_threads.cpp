@@ -0,0 +1,159 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Measures the request rate of the HTTP server with a trivial model as
+ * the number of IO threads the server uses grows. Drogon can't be restarted
+ * in one process so each thread count gets its own server, run as a child
+ * process of this benchmark, and the same number of concurrent clients.
+ */
+
+#include <benchmark/benchmark.h>
+#include <signal.h>    // for sigaddset, sigemptyset, sigwait, kill
+#include <spawn.h>     // for posix_spawn
+#include <sys/wait.h>  // for waitpid
+
+#include <array>     // for array
+#include <cstdint>   // for uint32_t
+#include <iostream>  // for operator<<, cout
+#include <string>    // for string, stoul, to_string
+#include <vector>    // for vector
+
+#include "amdinfer/amdinfer.hpp"  // for HttpClient, Server, InferenceRequest
+
+extern char** environ;  // NOLINT(readability-redundant-declaration)
+
+namespace amdinfer {
+
+const auto kPort = 8998;
+const auto kAddress = "http://127.0.0.1:" + std::to_string(kPort);
+// enough concurrent clients to keep the largest server busy
+const auto kClients = 64;
+// passed to the child process to run the server instead of the benchmark
+const std::string kServeFlag = "--serve-io-threads=";
+
+// NOLINTNEXTLINE(google-runtime-references)
+void httpEcho(benchmark::State& st, const std::string* endpoint) {
+  // each benchmark thread is a separate client with its own connection
+  const HttpClient client{kAddress};
+
+  std::vector<uint32_t> data{1};
+  InferenceRequest request;
+  request.addInputTensor(data.data(), {1}, DataType::Uint32);
+
+  for ([[maybe_unused]] auto _ : st) {
+    auto response = client.modelInfer(*endpoint, request);
+    if (response.isError()) {
+      st.SkipWithError("Error response from the server");
+      break;
+    }
+  }
+  // reported as items_per_second i.e. requests per second
+  st.SetItemsProcessed(st.iterations());
+}
+
+/**
+ * @brief Run the HTTP server with the given number of IO threads until this
+ * process gets SIGTERM
+ *
+ * @param threads number of IO threads
+ * @return int exit code
+ */
+int serve(size_t threads) {
+  // block SIGTERM before the server starts its threads so they inherit the
+  // mask and the signal is only taken by sigwait below
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  HttpOptions options;
+  options.threads = threads;
+  Server server;
+  server.setHttpOptions(options);
+  server.startHttp(kPort);
+
+  int signal = 0;
+  sigwait(&signals, &signal);
+  return 0;
+}
+
+/**
+ * @brief Start a server with the given number of IO threads by running this
+ * executable again as a child process
+ *
+ * @param self the name this executable was run with
+ * @param threads number of IO threads
+ * @return pid_t the child's process ID
+ */
+pid_t startServer(const char* self, size_t threads) {
+  auto flag = kServeFlag + std::to_string(threads);
+  std::array<char*, 3> args{const_cast<char*>(self), flag.data(), nullptr};
+  pid_t pid = 0;
+  if (posix_spawn(&pid, "/proc/self/exe", nullptr, nullptr, args.data(),
+                  environ) != 0) {
+    throw runtime_error("Failed to start the server process");
+  }
+  return pid;
+}
+
+void stopServer(pid_t pid) {
+  kill(pid, SIGTERM);
+  waitpid(pid, nullptr, 0);
+}
+
+}  // namespace amdinfer
+
+int main(int argc, char* argv[]) {
+#ifdef PROTOCOL_HTTP
+  if (argc == 2) {
+    const std::string arg = argv[1];
+    if (arg.rfind(amdinfer::kServeFlag, 0) == 0) {
+      return amdinfer::serve(
+        std::stoul(arg.substr(amdinfer::kServeFlag.size())));
+    }
+  }
+
+  benchmark::Initialize(&argc, argv);
+  for (size_t threads = 1; threads <= kDefaultDrogonThreads; threads *= 2) {
+    const auto pid = amdinfer::startServer(argv[0], threads);
+
+    const amdinfer::HttpClient client{amdinfer::kAddress};
+    amdinfer::waitUntilServerReady(&client);
+    const auto endpoint =
+      client.workerLoad("cplusplus", {{"model"}, {std::string{"echo"}}});
+    amdinfer::waitUntilModelReady(&client, endpoint);
+
+    // each server runs separately so only one benchmark is registered at a time
+    const auto name = "HttpEcho/io_threads:" + std::to_string(threads);
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    benchmark::RegisterBenchmark(name.c_str(), amdinfer::httpEcho, &endpoint)
+      ->Threads(amdinfer::kClients)
+      ->UseRealTime()
+      ->Unit(benchmark::kMicrosecond);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::ClearRegisteredBenchmarks();
+
+    client.workerUnload(endpoint);
+    amdinfer::stopServer(pid);
+  }
+  benchmark::Shutdown();
+#else
+  (void)argc;  // suppress unused variable warning
+  (void)argv;  // suppress unused variable warning
+  std::cout << "This benchmark requires the HTTP protocol\n";
+#endif
+  return 0;
+}
@@ -0,0 +1,112 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <json/reader.h>  // for CharReaderBuilder, CharReader
+#include <json/value.h>   // for Value
+
+#include <cstdint>  // for int64_t
+#include <memory>   // for make_shared, unique_ptr
+#include <string>   // for string, to_string
+
+#include "amdinfer/build_options.hpp"           // for AMDINFER_ENABLE_SIMDJSON
+#include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
+#include "amdinfer/core/memory_pool/pool.hpp"   // for MemoryPool
+#include "amdinfer/servers/http_server.hpp"     // for getRequest
+#ifdef AMDINFER_ENABLE_SIMDJSON
+#include "amdinfer/servers/simdjson_request.hpp"  // for parseInferenceRequest
+#endif
+
+namespace amdinfer {
+
+/**
+ * @brief Make a KServe v2 request body with one FP32 input of the given size
+ *
+ * @param elements number of elements in the input tensor
+ * @return std::string
+ */
+std::string makeBody(int64_t elements) {
+  std::string body = R"({"id":"bench","inputs":[{"name":"input0","shape":[)";
+  body += std::to_string(elements);
+  body += R"(],"datatype":"FP32","parameters":{},"data":[)";
+  for (int64_t i = 0; i < elements; ++i) {
+    if (i != 0) {
+      body += ',';
+    }
+    body += std::to_string(static_cast<float>(i) * 0.25F);
+  }
+  body += "]}]}";
+  return body;
+}
+
+void releaseRequest(const InferenceRequestPtr& request,
+                    const MemoryPool* pool) {
+  for (const auto& input : request->getInputs()) {
+    pool->put(MemoryAllocators::Cpu, input.getData());
+  }
+}
+
+// NOLINTNEXTLINE(google-runtime-references)
+void jsoncppParse(benchmark::State& st) {
+  MemoryPool pool;
+  const auto body = makeBody(st.range(0));
+  Json::CharReaderBuilder builder;
+  const std::unique_ptr<Json::CharReader> reader{builder.newCharReader()};
+
+  for ([[maybe_unused]] auto _ : st) {
+    auto json = std::make_shared<Json::Value>();
+    std::string errors;
+    reader->parse(body.data(), body.data() + body.size(), json.get(), &errors);
+    auto request = getRequest(json, &pool);
+    benchmark::DoNotOptimize(request);
+    releaseRequest(request, &pool);
+  }
+  st.SetBytesProcessed(static_cast<int64_t>(st.iterations()) *
+                       static_cast<int64_t>(body.size()));
+}
+
+#ifdef AMDINFER_ENABLE_SIMDJSON
+// NOLINTNEXTLINE(google-runtime-references)
+void simdjsonParse(benchmark::State& st) {
+  MemoryPool pool;
+  const auto body = makeBody(st.range(0));
+
+  for ([[maybe_unused]] auto _ : st) {
+    auto request = parseInferenceRequest(body, &pool);
+    benchmark::DoNotOptimize(request);
+    releaseRequest(request, &pool);
+  }
+  st.SetBytesProcessed(static_cast<int64_t>(st.iterations()) *
+                       static_cast<int64_t>(body.size()));
+}
+#endif
+
+// number of elements in the input tensor
+const std::initializer_list<int64_t> kTensorSizes{16, 1024, 65536, 1048576};
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+BENCHMARK(jsoncppParse)
+  ->ArgsProduct({kTensorSizes})
+  ->Unit(benchmark::kMicrosecond);
+#ifdef AMDINFER_ENABLE_SIMDJSON
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+BENCHMARK(simdjsonParse)
+  ->ArgsProduct({kTensorSizes})
+  ->Unit(benchmark::kMicrosecond);
+#endif
+
+// NOLINTNEXTLINE
+BENCHMARK_MAIN();
+
+}  // namespace amdinfer
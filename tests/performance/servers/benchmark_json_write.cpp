@@ -0,0 +1,127 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <json/value.h>   // for Value
+#include <json/writer.h>  // for StreamWriterBuilder, writeString
+
+#include <cstddef>  // for byte
+#include <cstdint>  // for int64_t
+#include <cstring>  // for memcpy
+#include <string>   // for string
+#include <utility>  // for move
+#include <vector>   // for vector
+
+#include "amdinfer/clients/http_internal.hpp"    // for SetInputData
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/servers/json_writer.hpp"      // for writeInferenceResponse
+
+namespace amdinfer {
+
+InferenceResponse makeResponse(int64_t elements) {
+  std::vector<float> values(elements);
+  for (auto i = 0; i < elements; ++i) {
+    // use values with long decimal expansions to exercise number formatting
+    values[i] = static_cast<float>(i) / 3.0F;
+  }
+  std::vector<std::byte> data(values.size() * sizeof(float));
+  std::memcpy(data.data(), values.data(), data.size());
+
+  InferenceResponseOutput output;
+  output.setName("output0");
+  output.setDatatype(DataType::Fp32);
+  output.setShape({elements});
+  output.setData(std::move(data));
+
+  InferenceResponse response;
+  response.setModel("bench");
+  response.setID("bench");
+  response.addOutput(output);
+  return response;
+}
+
+/**
+ * @brief Report throughput as the tensor bytes serialized per second so the
+ * result doesn't depend on how verbose each writer's output is
+ */
+// NOLINTNEXTLINE(google-runtime-references)
+void setBytesProcessed(benchmark::State& st,
+                       const InferenceResponse& response) {
+  size_t bytes = 0;
+  for (const auto& output : response.getOutputs()) {
+    bytes += output.getSize() * output.getDatatype().size();
+  }
+  st.SetBytesProcessed(static_cast<int64_t>(st.iterations() * bytes));
+}
+
+// NOLINTNEXTLINE(google-runtime-references)
+void jsoncppWrite(benchmark::State& st) {
+  const auto response = makeResponse(st.range(0));
+  const Json::StreamWriterBuilder builder;
+
+  for ([[maybe_unused]] auto _ : st) {
+    // mirrors the DOM-based serialization that preceded JsonWriter
+    Json::Value ret;
+    ret["model_name"] = response.getModel();
+    ret["outputs"] = Json::arrayValue;
+    ret["id"] = response.getID();
+    for (const auto& output : response.getOutputs()) {
+      Json::Value json_output;
+      json_output["name"] = output.getName();
+      json_output["parameters"] = Json::objectValue;
+      json_output["data"] = Json::arrayValue;
+      json_output["shape"] = Json::arrayValue;
+      json_output["datatype"] = output.getDatatype().str();
+      for (const auto& index : output.getShape()) {
+        json_output["shape"].append(static_cast<Json::UInt>(index));
+      }
+      switchOverTypes(SetInputData(), output.getDatatype(),
+                      &(json_output["data"]), output.getData(),
+                      output.getSize());
+      ret["outputs"].append(json_output);
+    }
+    auto body = Json::writeString(builder, ret);
+    benchmark::DoNotOptimize(body);
+  }
+  setBytesProcessed(st, response);
+}
+
+// NOLINTNEXTLINE(google-runtime-references)
+void jsonWriterWrite(benchmark::State& st) {
+  const auto response = makeResponse(st.range(0));
+
+  for ([[maybe_unused]] auto _ : st) {
+    auto body = writeInferenceResponse(response);
+    benchmark::DoNotOptimize(body);
+  }
+  setBytesProcessed(st, response);
+}
+
+// number of elements in the output tensor
+const std::initializer_list<int64_t> kTensorSizes{16, 1024, 65536, 1048576};
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+BENCHMARK(jsoncppWrite)
+  ->ArgsProduct({kTensorSizes})
+  ->Unit(benchmark::kMicrosecond);
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+BENCHMARK(jsonWriterWrite)
+  ->ArgsProduct({kTensorSizes})
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK_MAIN();
+
+}  // namespace amdinfer
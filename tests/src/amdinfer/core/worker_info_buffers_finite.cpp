@@ -26,12 +26,13 @@
 #include <thread>   // for thread::id, thread
 #include <utility>  // for move
 
-#include "amdinfer/batching/batcher.hpp"  // for Batcher
-#include "amdinfer/buffers/buffer.hpp"    // IWYU pragma: keep
-#include "amdinfer/core/parameters.hpp"   // for ParameterMap
-#include "amdinfer/core/worker_info.hpp"  // for WorkerInfo
-#include "amdinfer/declarations.hpp"      // for BufferPtrs
-#include "amdinfer/util/queue.hpp"        // for BufferPtrsQueue, Blockin...
+#include "amdinfer/batching/batcher.hpp"   // for Batcher
+#include "amdinfer/buffers/buffer.hpp"     // IWYU pragma: keep
+#include "amdinfer/core/parameters.hpp"    // for ParameterMap
+#include "amdinfer/core/rate_limiter.hpp"  // IWYU pragma: keep
+#include "amdinfer/core/worker_info.hpp"   // for WorkerInfo
+#include "amdinfer/declarations.hpp"       // for BufferPtrs
+#include "amdinfer/util/queue.hpp"         // for BufferPtrsQueue, Blockin...
 
 namespace amdinfer {
 
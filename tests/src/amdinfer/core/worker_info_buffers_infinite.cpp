@@ -25,12 +25,13 @@
 #include <string>   // for allocator, string
 #include <thread>   // for thread::id, thread
 
-#include "amdinfer/batching/batcher.hpp"  // for Batcher
-#include "amdinfer/buffers/buffer.hpp"    // IWYU pragma: keep
-#include "amdinfer/core/parameters.hpp"   // for ParameterMap
-#include "amdinfer/core/worker_info.hpp"  // for WorkerInfo
-#include "amdinfer/declarations.hpp"      // for BufferPtrs
-#include "amdinfer/util/queue.hpp"        // for BufferPtrsQueue, BufferP...
+#include "amdinfer/batching/batcher.hpp"   // for Batcher
+#include "amdinfer/buffers/buffer.hpp"     // IWYU pragma: keep
+#include "amdinfer/core/parameters.hpp"    // for ParameterMap
+#include "amdinfer/core/rate_limiter.hpp"  // IWYU pragma: keep
+#include "amdinfer/core/worker_info.hpp"   // for WorkerInfo
+#include "amdinfer/declarations.hpp"       // for BufferPtrs
+#include "amdinfer/util/queue.hpp"         // for BufferPtrsQueue, BufferP...
 
 namespace amdinfer {
 
@@ -0,0 +1,63 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Implements helpers that fill model repositories for the tests
+ */
+
+#include "amdinfer/testing/model_repository.hpp"
+
+#include <dlfcn.h>  // for dlopen, dlinfo, dlclose
+#include <link.h>   // for link_map
+
+#include <fstream>  // for ofstream
+
+#include "amdinfer/core/exceptions.hpp"  // for file_not_found_error
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+std::string findLibrary(const std::string& library) {
+  void* handle = dlopen(library.c_str(), RTLD_LOCAL | RTLD_LAZY);
+  if (handle == nullptr) {
+    throw file_not_found_error(dlerror());
+  }
+  link_map* map = nullptr;
+  dlinfo(handle, RTLD_DI_LINKMAP, &map);
+  std::string path = map->l_name;
+  dlclose(handle);
+  return path;
+}
+
+void addEchoModel(const fs::path& repository, const std::string& model,
+                  const std::vector<std::string>& versions) {
+  const auto library = findLibrary("libecho.so");
+  for (const auto& version : versions) {
+    const auto model_dir = repository / model / version;
+    fs::create_directories(model_dir);
+    fs::create_symlink(library, model_dir / "libecho.so");
+  }
+
+  std::ofstream config{repository / model / "config.toml"};
+  config << "name = \"" << model << "\"\n"
+         << "platform = \"amdinfer_cpp\"\n\n"
+         << "[[inputs]]\nname = \"input\"\ndatatype = \"UINT32\"\n"
+         << "shape = [1]\n\n"
+         << "[[outputs]]\nname = \"output\"\ndatatype = \"UINT32\"\n"
+         << "shape = [1]\n";
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,52 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Defines helpers that fill model repositories for the tests
+ */
+
+#ifndef GUARD_SRC_AMDINFER_TESTING_MODEL_REPOSITORY
+#define GUARD_SRC_AMDINFER_TESTING_MODEL_REPOSITORY
+
+#include <filesystem>  // for path
+#include <string>      // for string
+#include <vector>      // for vector
+
+namespace amdinfer {
+
+/**
+ * @brief Find the absolute path to a shared library on the library search path
+ *
+ * @param library the name of the library
+ * @return std::string
+ * @throws file_not_found_error if the library can't be loaded
+ */
+std::string findLibrary(const std::string& library);
+
+/**
+ * @brief Add a model to a repository that uses the echo model with the
+ * CPlusPlus worker
+ *
+ * @param repository path to the repository
+ * @param model name of the model
+ * @param versions the versions of the model to add
+ */
+void addEchoModel(const std::filesystem::path& repository,
+                  const std::string& model,
+                  const std::vector<std::string>& versions = {"1"});
+
+}  // namespace amdinfer
+
+#endif  // GUARD_SRC_AMDINFER_TESTING_MODEL_REPOSITORY
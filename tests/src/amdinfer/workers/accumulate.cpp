@@ -0,0 +1,129 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Implements the Accumulate worker
+ */
+
+#include <cstddef>  // for byte
+#include <cstdint>  // for int32_t
+#include <memory>   // for unique_ptr
+#include <vector>   // for vector
+
+#include "amdinfer/batching/sequence.hpp"        // for SequenceBatcher
+#include "amdinfer/build_options.hpp"            // for AMDINFER_ENABLE_TRACING
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/observation/tracing.hpp"      // for Trace
+#include "amdinfer/workers/sequence_states.hpp"  // for SequenceStates
+#include "amdinfer/workers/worker.hpp"           // for Worker
+
+namespace amdinfer::workers {
+
+/**
+ * @brief The Accumulate worker keeps a running sum of the values sent in each
+ * sequence of requests and responds to each request with the sum so far
+ *
+ */
+class Accumulate : public SingleThreadedWorker {
+ public:
+  using SingleThreadedWorker::SingleThreadedWorker;
+  [[nodiscard]] std::vector<MemoryAllocators> getAllocators() const override;
+
+ private:
+  void doInit(ParameterMap* parameters) override;
+  void doAcquire(ParameterMap* parameters) override;
+  BatchPtr doRun(Batch* batch, const MemoryPool* pool) override;
+  void doRelease() override;
+  void doDestroy() override;
+
+  // workers define what batcher implementation should be used for them.
+  // if not explicitly defined here, a default value is used from worker.hpp.
+  using Worker::makeBatcher;
+  std::vector<std::unique_ptr<Batcher>> makeBatcher(int num,
+                                                    ParameterMap* parameters,
+                                                    MemoryPool* pool) override {
+    return this->makeBatcher<SequenceBatcher>(num, parameters, pool);
+  };
+
+  SequenceStates<int32_t> sums_;
+};
+
+std::vector<MemoryAllocators> Accumulate::getAllocators() const {
+  return {MemoryAllocators::Cpu};
+}
+
+void Accumulate::doInit(ParameterMap* parameters) {
+  if (parameters->has("batch_size")) {
+    batch_size_ = parameters->get<int32_t>("batch_size");
+  }
+}
+
+void Accumulate::doAcquire([[maybe_unused]] ParameterMap* parameters) {}
+
+BatchPtr Accumulate::doRun(Batch* batch,
+                           [[maybe_unused]] const MemoryPool* pool) {
+  ParameterMap parameters;
+  parameters.put("batch_size", static_cast<int32_t>(batch->size()));
+
+  for (auto j = 0U; j < batch->size(); ++j) {
+    const auto& request = batch->getRequest(j);
+    const auto& input = request->getInputs()[0];
+    auto& sum = sums_.get(*request);
+    const auto* values = static_cast<const int32_t*>(input.getData());
+    for (auto i = 0U; i < input.getSize(); ++i) {
+      sum += values[i];
+    }
+
+    InferenceResponse response;
+    response.setID(request->getID());
+    response.setModel("accumulate");
+    response.setParameters(parameters);
+
+    InferenceResponseOutput output;
+    output.setName("sum");
+    output.setDatatype(DataType::Int32);
+    output.setShape({1});
+    const auto* data = reinterpret_cast<const std::byte*>(&sum);
+    output.setData(std::vector<std::byte>(data, data + sizeof(sum)));
+    response.addOutput(output);
+
+#ifdef AMDINFER_ENABLE_TRACING
+    const auto& trace = batch->getTrace(j);
+    auto context = trace->propagate();
+    response.setContext(std::move(context));
+#endif
+
+    request->runCallbackOnce(response);
+  }
+  // okay because ensembles disabled for this worker
+  return nullptr;
+}
+
+void Accumulate::doRelease() {}
+void Accumulate::doDestroy() {}
+
+}  // namespace amdinfer::workers
+
+extern "C" {
+// using smart pointer here may cause problems inside shared object so managing
+// manually
+amdinfer::workers::Worker* getWorker() {
+  return new amdinfer::workers::Accumulate("Accumulate", "CPU", false);
+}
+}  // extern C
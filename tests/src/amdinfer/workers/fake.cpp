@@ -17,23 +17,29 @@
  * @brief Implements the Fake worker
  */
 
-#include <dlfcn.h>  // for dlopen
-
-#include <array>    // for array
-#include <cassert>  // for assert
-#include <cstddef>  // for size_t, byte
-#include <cstdint>  // for uint32_t, int32_t
-#include <cstring>  // for memcpy
-#include <memory>   // for unique_ptr, allocator
-#include <ratio>    // for micro
-#include <string>   // for string
-#include <thread>   // for thread
-#include <utility>  // for move
-#include <vector>   // for vector
-
-#include "amdinfer/batching/soft.hpp"    // for SoftBatcher
-#include "amdinfer/build_options.hpp"    // for AMDINFER_ENABLE_TRACING
-#include "amdinfer/core/data_types.hpp"  // for DataType, DataType::Uint32
+#include <dlfcn.h>   // for dlopen
+#include <unistd.h>  // for close
+
+#include <array>       // for array
+#include <cassert>     // for assert
+#include <cstddef>     // for size_t, byte
+#include <cstdint>     // for uint32_t, int32_t
+#include <cstdlib>     // for mkstemp
+#include <cstring>     // for memcpy
+#include <filesystem>  // for path, temp_directory_path
+#include <fstream>     // for ofstream
+#include <memory>      // for unique_ptr, allocator
+#include <ratio>       // for micro
+#include <string>      // for string
+#include <thread>      // for thread
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "amdinfer/batching/soft.hpp"        // for SoftBatcher
+#include "amdinfer/build_options.hpp"        // for AMDINFER_ENABLE_TRACING
+#include "amdinfer/core/artifact_cache.hpp"  // for ArtifactCache
+#include "amdinfer/core/data_types.hpp"      // for DataType, DataType::Uint32
+#include "amdinfer/core/exceptions.hpp"      // for runtime_error
 #include "amdinfer/core/inference_request.hpp"  // for InferenceRequest, Infe...
 #include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
 #include "amdinfer/core/parameters.hpp"          // for ParameterMap
@@ -42,6 +48,7 @@
 #include "amdinfer/observation/metrics.hpp"  // for Metrics
 #include "amdinfer/observation/tracing.hpp"  // for startFollowSpan, SpanPtr
 #include "amdinfer/util/containers.hpp"      // for containerSum
+#include "amdinfer/util/filesystem.hpp"      // for readFile
 #include "amdinfer/util/queue.hpp"           // for BufferPtrsQueue
 #include "amdinfer/util/string.hpp"          // for endsWith
 #include "amdinfer/util/thread.hpp"          // for setThreadName
@@ -62,7 +69,17 @@ class Fake : public SingleThreadedWorker {
 
  private:
   int delay_ = 0;
+  /// Milliseconds added to the delay for each request in the batch
+  int delay_per_request_ = 0;
   int loop_ = 0;
+  /// Milliseconds to sleep in each of init and acquire to simulate slow loads
+  int load_delay_ = 0;
+  /// Milliseconds to sleep while "compiling" the model file, if there is one
+  int compile_delay_ = 0;
+  /// Respond to every request with an error to exercise failure handling
+  bool fail_requests_ = false;
+  /// The compiled model: the contents of the model file reversed
+  std::string artifact_;
 
   void doInit(ParameterMap* parameters) override;
   void doAcquire(ParameterMap* parameters) override;
@@ -85,17 +102,69 @@ std::vector<MemoryAllocators> Fake::getAllocators() const {
 }
 
 void Fake::doInit(ParameterMap* parameters) {
+  if (parameters->has("batch_size")) {
+    batch_size_ = parameters->get<int32_t>("batch_size");
+  }
+
   if (parameters->has("delay")) {
     delay_ = parameters->get<int32_t>("delay");
   }
 
+  if (parameters->has("delay_per_request")) {
+    delay_per_request_ = parameters->get<int32_t>("delay_per_request");
+  }
+
   if (parameters->has("loop")) {
     loop_ = parameters->get<int32_t>("loop");
   }
+
+  if (parameters->has("load_delay")) {
+    load_delay_ = parameters->get<int32_t>("load_delay");
+  }
+
+  if (parameters->has("compile_delay")) {
+    compile_delay_ = parameters->get<int32_t>("compile_delay");
+  }
+
+  if (parameters->has("fail_requests")) {
+    fail_requests_ = parameters->get<bool>("fail_requests");
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(load_delay_));
 }
 
-void Fake::doAcquire([[maybe_unused]] ParameterMap* parameters) {
-  // nothing to acquire
+void Fake::doAcquire(ParameterMap* parameters) {
+  // nothing to acquire but it may pretend otherwise
+  std::this_thread::sleep_for(std::chrono::milliseconds(load_delay_));
+
+  if (!parameters->has("model")) {
+    return;
+  }
+  const std::filesystem::path model = parameters->get<std::string>("model");
+  auto compile = [this, &model](const std::filesystem::path& path) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(compile_delay_));
+    auto contents = util::readFile(model.string());
+    std::ofstream{path} << std::string{contents.rbegin(), contents.rend()};
+  };
+
+  if (ArtifactCache::enabled(*parameters)) {
+    auto cache = ArtifactCache::fromParameters(*parameters);
+    const auto key = ArtifactCache::makeKey(
+      model, "fake", {{"batch_size", std::to_string(batch_size_)}});
+    artifact_ = util::readFile(cache.get(key, compile).string());
+  } else {
+    // each load compiles to its own file so concurrent loads don't collide
+    const auto directory = std::filesystem::temp_directory_path();
+    auto artifact = (directory / "amdinfer_fake_XXXXXX").string();
+    const auto fd = mkstemp(artifact.data());
+    if (fd < 0) {
+      throw runtime_error("Cannot create a temporary file in " +
+                          directory.string());
+    }
+    close(fd);
+    compile(artifact);
+    artifact_ = util::readFile(artifact);
+    std::filesystem::remove(artifact);
+  }
 }
 
 BatchPtr Fake::doRun([[maybe_unused]] Batch* batch,
@@ -103,7 +172,16 @@ BatchPtr Fake::doRun([[maybe_unused]] Batch* batch,
   auto new_batch = batch->propagate();
   new_batch->addModel("fake");
 
-  std::this_thread::sleep_for(std::chrono::milliseconds(delay_));
+  const auto delay =
+    delay_ + delay_per_request_ * static_cast<int>(batch->size());
+  std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+
+  if (fail_requests_) {
+    for (const auto& request : batch->getRequests()) {
+      request->runCallbackError("Fake worker failed the request");
+    }
+    return nullptr;
+  }
 
   // busy loop to prevent optimization
   for (auto i = 0; i < loop_; ++i) {
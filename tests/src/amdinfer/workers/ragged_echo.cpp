@@ -0,0 +1,141 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file
+ * @brief Implements the RaggedEcho worker
+ */
+
+#include <cstddef>  // for byte, size_t
+#include <cstdint>  // for int32_t, int64_t
+#include <memory>   // for unique_ptr
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "amdinfer/batching/soft.hpp"            // for SoftBatcher
+#include "amdinfer/build_options.hpp"            // for AMDINFER_ENABLE_TRACING
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/declarations.hpp"             // for BufferPtr
+#include "amdinfer/observation/tracing.hpp"      // for Trace
+#include "amdinfer/workers/worker.hpp"           // for Worker
+
+namespace amdinfer::workers {
+
+/**
+ * @brief The RaggedEcho worker batches requests whose inputs differ in length
+ * and echoes each request's inputs back by slicing them out of the packed
+ * batch using the batch's offsets
+ *
+ */
+class RaggedEcho : public SingleThreadedWorker {
+ public:
+  using SingleThreadedWorker::SingleThreadedWorker;
+  [[nodiscard]] std::vector<MemoryAllocators> getAllocators() const override;
+
+ private:
+  void doInit(ParameterMap* parameters) override;
+  void doAcquire(ParameterMap* parameters) override;
+  BatchPtr doRun(Batch* batch, const MemoryPool* pool) override;
+  void doRelease() override;
+  void doDestroy() override;
+
+  // workers define what batcher implementation should be used for them.
+  // if not explicitly defined here, a default value is used from worker.hpp.
+  using Worker::makeBatcher;
+  std::vector<std::unique_ptr<Batcher>> makeBatcher(int num,
+                                                    ParameterMap* parameters,
+                                                    MemoryPool* pool) override {
+    return this->makeBatcher<SoftBatcher>(num, parameters, pool);
+  };
+};
+
+std::vector<MemoryAllocators> RaggedEcho::getAllocators() const {
+  return {MemoryAllocators::Cpu};
+}
+
+void RaggedEcho::doInit(ParameterMap* parameters) {
+  if (parameters->has("batch_size")) {
+    batch_size_ = parameters->get<int32_t>("batch_size");
+  }
+  // this worker only makes sense with ragged batches
+  parameters->put("ragged", true);
+}
+
+void RaggedEcho::doAcquire([[maybe_unused]] ParameterMap* parameters) {}
+
+BatchPtr RaggedEcho::doRun(Batch* batch,
+                           [[maybe_unused]] const MemoryPool* pool) {
+  const auto& input_buffers = batch->getInputBuffers();
+  std::vector<std::vector<size_t>> offsets;
+  offsets.reserve(input_buffers.size());
+  for (auto i = 0U; i < input_buffers.size(); ++i) {
+    offsets.push_back(batch->getInputOffsets(i));
+  }
+
+  ParameterMap parameters;
+  parameters.put("batch_size", static_cast<int32_t>(batch->size()));
+
+  for (auto j = 0U; j < batch->size(); ++j) {
+    const auto& request = batch->getRequest(j);
+
+    InferenceResponse response;
+    response.setID(request->getID());
+    response.setModel("raggedecho");
+    response.setParameters(parameters);
+
+    const auto& inputs = request->getInputs();
+    for (auto i = 0U; i < inputs.size(); ++i) {
+      const auto& input = inputs[i];
+      const auto element_size = input.getDatatype().size();
+      const auto begin = offsets[i][j] * element_size;
+      const auto end = offsets[i][j + 1] * element_size;
+      const auto* data = static_cast<std::byte*>(input_buffers[i]->data(0));
+
+      InferenceResponseOutput output;
+      output.setName(input.getName());
+      output.setDatatype(input.getDatatype());
+      output.setShape(
+        {static_cast<int64_t>(offsets[i][j + 1] - offsets[i][j])});
+      output.setData(std::vector<std::byte>(data + begin, data + end));
+      response.addOutput(output);
+    }
+
+#ifdef AMDINFER_ENABLE_TRACING
+    const auto& trace = batch->getTrace(j);
+    auto context = trace->propagate();
+    response.setContext(std::move(context));
+#endif
+
+    request->runCallbackOnce(response);
+  }
+  // okay because ensembles disabled for this worker
+  return nullptr;
+}
+
+void RaggedEcho::doRelease() {}
+void RaggedEcho::doDestroy() {}
+
+}  // namespace amdinfer::workers
+
+extern "C" {
+// using smart pointer here may cause problems inside shared object so managing
+// manually
+amdinfer::workers::Worker* getWorker() {
+  return new amdinfer::workers::RaggedEcho("RaggedEcho", "CPU", false);
+}
+}  // extern C
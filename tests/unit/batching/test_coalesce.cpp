@@ -0,0 +1,119 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>  // for copy
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, int64_t
+#include <memory>     // for make_shared, make_unique, shared_ptr
+#include <string>     // for string
+#include <utility>    // for move, pair
+#include <vector>     // for vector
+
+#include "amdinfer/batching/coalesce.hpp"        // for Coalescer
+#include "amdinfer/batching/soft.hpp"            // for SoftBatcher
+#include "amdinfer/buffers/buffer.hpp"           // for Buffer
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"    // for MemoryPool
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/core/request_container.hpp"   // for RequestContainer
+#include "gtest/gtest.h"                         // for Test, EXPECT_EQ
+
+namespace amdinfer {
+
+class UnitCoalesceFixture : public testing::Test {
+ protected:
+  /// Make a request with the given input data whose response is recorded
+  RequestContainer make(const std::string& id, std::vector<uint8_t> values) {
+    const auto size = static_cast<int64_t>(values.size());
+    const InferenceRequestInput input{nullptr, {size}, DataType::Uint8};
+    auto buffer = pool_.get({MemoryAllocators::Cpu}, input, 1);
+    auto* data = static_cast<uint8_t*>(buffer->data(0));
+    std::copy(values.begin(), values.end(), data);
+
+    auto request = std::make_shared<InferenceRequest>();
+    request->setID(id);
+    request->addInputTensor(data, {size}, DataType::Uint8);
+    request->setCallback([this, id](const InferenceResponse& response) {
+      responses_.emplace_back(id, response.getID());
+    });
+    RequestContainer container;
+    container.request = std::move(request);
+    return container;
+  }
+
+  static constexpr size_t kMaxBytes = 4;
+  MemoryPool pool_;
+  std::shared_ptr<Coalescer> coalescer_ =
+    std::make_shared<Coalescer>(kMaxBytes);
+  /// The request each response went to and the ID it had
+  std::vector<std::pair<std::string, std::string>> responses_;
+};
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitCoalesceFixture, Coalesce) {
+  auto first = make("first", {1, 2});
+  auto second = make("second", {1, 2});
+  auto different = make("different", {1, 3});
+  EXPECT_FALSE(coalescer_->attach(&first, &pool_));
+  EXPECT_TRUE(coalescer_->attach(&second, &pool_));
+  EXPECT_FALSE(coalescer_->attach(&different, &pool_));
+
+  InferenceResponse response;
+  response.setID("first");
+  first.request->runCallbackOnce(response);
+  EXPECT_EQ(responses_, (std::vector<std::pair<std::string, std::string>>{
+                          {"first", "first"}, {"second", "second"}}));
+
+  // once it has responded, the next identical request runs itself
+  auto third = make("third", {1, 2});
+  EXPECT_FALSE(coalescer_->attach(&third, &pool_));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitCoalesceFixture, Limits) {
+  // requests with too much data aren't coalesced
+  auto first = make("first", {1, 2, 3, 4, 5});
+  auto second = make("second", {1, 2, 3, 4, 5});
+  EXPECT_FALSE(coalescer_->attach(&first, &pool_));
+  EXPECT_FALSE(coalescer_->attach(&second, &pool_));
+
+  // nor are requests with different parameters
+  auto third = make("third", {1});
+  auto fourth = make("fourth", {1});
+  ParameterMap parameters;
+  parameters.put("key", "value");
+  fourth.request->setParameters(parameters);
+  EXPECT_FALSE(coalescer_->attach(&third, &pool_));
+  EXPECT_FALSE(coalescer_->attach(&fourth, &pool_));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitCoalesceFixture, Streaming) {
+  ParameterMap parameters;
+  parameters.put("coalesce_requests", true);
+  SoftBatcher batcher{&pool_, &parameters};
+  batcher.enqueue(std::make_unique<RequestContainer>(make("first", {1})));
+  batcher.enqueue(std::make_unique<RequestContainer>(make("second", {1})));
+  EXPECT_EQ(batcher.getQueueSize(), 1);
+
+  // requests attached to a streamed one would only get its first response
+  batcher.setStreaming(true);
+  batcher.enqueue(std::make_unique<RequestContainer>(make("third", {2})));
+  batcher.enqueue(std::make_unique<RequestContainer>(make("fourth", {2})));
+  EXPECT_EQ(batcher.getQueueSize(), 3);
+}
+
+}  // namespace amdinfer
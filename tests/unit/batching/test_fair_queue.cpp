@@ -0,0 +1,160 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>         // for atomic
+#include <chrono>         // for microseconds
+#include <memory>         // for make_unique
+#include <string>         // for string
+#include <thread>         // for thread
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "amdinfer/batching/fair_queue.hpp"     // for FairQueue
+#include "amdinfer/core/exceptions.hpp"         // for invalid_argument
+#include "amdinfer/core/request_container.hpp"  // for RequestContainer
+#include "amdinfer/util/queue.hpp"              // for BlockingQueue
+#include "gtest/gtest.h"                        // for Test, EXPECT_EQ
+
+namespace amdinfer {
+
+class UnitFairQueueFixture : public testing::Test {
+ protected:
+  /// Enqueue a request from a client
+  void send(const std::string& client) {
+    auto request = std::make_unique<RequestContainer>();
+    request->client = client;
+    input_.enqueue(std::move(request));
+  }
+
+  /// Get the clients of the waiting requests in the order they're handed out
+  std::vector<std::string> drain(FairQueue* queue) {
+    std::vector<std::string> clients;
+    RequestContainerPtr request;
+    while (queue->tryDequeue(&request) && request != nullptr) {
+      clients.push_back(request->client);
+    }
+    return clients;
+  }
+
+  BlockingQueue<RequestContainerPtr> input_;
+};
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitFairQueueFixture, Interleave) {
+  FairQueue queue{&input_, {}};
+  for (auto i = 0; i < 3; ++i) {
+    send("alice");
+  }
+  send("bob");
+  send("carol");
+  EXPECT_EQ(queue.size(), 5);
+
+  const std::vector<std::string> expected{"alice", "bob", "carol", "alice",
+                                          "alice"};
+  EXPECT_EQ(drain(&queue), expected);
+  EXPECT_EQ(queue.size(), 0);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitFairQueueFixture, Weights) {
+  FairQueue queue{&input_, {{"alice", 2}}};
+  for (auto i = 0; i < 4; ++i) {
+    send("alice");
+    send("bob");
+  }
+
+  // ties in finish time go to the request that arrived first
+  const std::vector<std::string> expected{"alice", "bob", "alice", "alice",
+                                          "bob",   "alice", "bob", "bob"};
+  EXPECT_EQ(drain(&queue), expected);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitFairQueueFixture, IdleClientStartsFromNow) {
+  FairQueue queue{&input_, {}};
+  for (auto i = 0; i < 4; ++i) {
+    send("alice");
+  }
+  RequestContainerPtr request;
+  ASSERT_TRUE(queue.tryDequeue(&request));
+  ASSERT_TRUE(queue.tryDequeue(&request));
+
+  // bob's requests start from the current virtual time, not from zero
+  send("bob");
+  send("bob");
+  const std::vector<std::string> expected{"alice", "bob", "alice", "bob"};
+  EXPECT_EQ(drain(&queue), expected);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitFairQueueFixture, Stop) {
+  FairQueue queue{&input_, {}};
+  send("alice");
+  input_.enqueue(nullptr);
+
+  // the stop signal is handed out after the requests before it
+  RequestContainerPtr request;
+  ASSERT_TRUE(queue.tryDequeue(&request));
+  EXPECT_NE(request, nullptr);
+  queue.dequeue(&request);
+  EXPECT_EQ(request, nullptr);
+
+  EXPECT_FALSE(queue.dequeue(&request, std::chrono::microseconds(100)));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitFairQueueFixture, Wake) {
+  FairQueue queue{&input_, {}};
+  const auto waiters = 3;
+  std::atomic<int> requests = 0;
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < waiters; ++i) {
+    threads.emplace_back([&] {
+      // one thread waits on the input queue and the others on the fair queue
+      RequestContainerPtr request;
+      queue.dequeue(&request);
+      while (request != nullptr) {
+        ++requests;
+        queue.dequeue(&request);
+      }
+    });
+  }
+
+  // every waiter is woken up for the requests and stop signals that arrive
+  for (auto i = 0; i < waiters; ++i) {
+    send("alice");
+  }
+  for (auto i = 0; i < waiters; ++i) {
+    input_.enqueue(nullptr);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(requests, waiters);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitFairQueue, ParseClientWeights) {
+  const auto weights = parseClientWeights("alice:2,bob:0.5");
+  const std::unordered_map<std::string, double> expected{{"alice", 2},
+                                                         {"bob", 0.5}};
+  EXPECT_EQ(weights, expected);
+
+  EXPECT_THROW(parseClientWeights("alice"), invalid_argument);
+  EXPECT_THROW(parseClientWeights("alice:0"), invalid_argument);
+  EXPECT_THROW(parseClientWeights("alice:fast"), invalid_argument);
+  EXPECT_THROW(parseClientWeights(":1"), invalid_argument);
+}
+
+}  // namespace amdinfer
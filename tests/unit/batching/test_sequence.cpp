@@ -0,0 +1,217 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <chrono>              // for milliseconds, steady_clock
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for int32_t, uint8_t
+#include <memory>              // for make_shared, make_unique
+#include <mutex>               // for mutex, lock_guard, unique_lock
+#include <optional>            // for optional
+#include <string>              // for string
+#include <thread>              // for sleep_until
+#include <utility>             // for move
+#include <vector>              // for vector
+
+#include "amdinfer/batching/sequence.hpp"        // for SequenceBatcher
+#include "amdinfer/buffers/buffer.hpp"           // for Buffer
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"    // for MemoryPool
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/core/request_container.hpp"   // for RequestContainer
+#include "gtest/gtest.h"                         // for Test, EXPECT_EQ
+
+namespace amdinfer {
+
+// timeout in us to read batches from the batcher
+constexpr auto kTimeoutUs = 1000 * 1000;
+// timeout in ms to wait for the batcher to respond with errors
+constexpr auto kTimeoutMs = 1000;
+
+class UnitSequenceBatcherFixture : public testing::Test {
+ protected:
+  /// Start the batcher, ending sequences after being idle for idle_timeout ms
+  void start(int32_t idle_timeout) {
+    ParameterMap parameters;
+    const int32_t timeout = 1000;
+    parameters.put("timeout", timeout);
+    parameters.put("sequence_idle_timeout", idle_timeout);
+    batcher_.emplace(&pool_, &parameters);
+    batcher_->setName("test");
+    batcher_->setBatchSize(2);
+    batcher_->start({MemoryAllocators::Cpu});
+  }
+
+  /// Stop the batcher
+  void stop() {
+    if (!stopped_) {
+      batcher_->enqueue(nullptr);
+      batcher_->end();
+      stopped_ = true;
+    }
+  }
+
+  void TearDown() override { stop(); }
+
+  /// Send a step of a sequence, saving its error in errors_ if it fails
+  void send(const std::string& id, bool start = false, bool end = false) {
+    const InferenceRequestInput input{nullptr, {1}, DataType::Uint8};
+    auto buffer = pool_.get({MemoryAllocators::Cpu}, input, 1);
+    auto request = std::make_shared<InferenceRequest>();
+    request->addInputTensor(buffer->data(0), {1}, DataType::Uint8);
+    ParameterMap parameters;
+    parameters.put("sequence_id", id);
+    parameters.put("sequence_start", start);
+    parameters.put("sequence_end", end);
+    request->setParameters(parameters);
+    request->setCallback([this](const InferenceResponse& response) {
+      if (response.isError()) {
+        const std::lock_guard lock{mutex_};
+        errors_.push_back(response.getError());
+        cv_.notify_all();
+      }
+    });
+    auto container = std::make_unique<RequestContainer>();
+    container->request = std::move(request);
+    batcher_->enqueue(std::move(container));
+  }
+
+  /// Get the next batch and the slots of its requests
+  std::vector<int32_t> next(BatchPtr* batch) {
+    std::vector<int32_t> slots;
+    if (batcher_->getOutputQueue()->wait_dequeue_timed(*batch, kTimeoutUs)) {
+      for (const auto& request : **batch) {
+        slots.push_back(
+          request->getParameters().get<int32_t>("sequence_slot"));
+      }
+    }
+    return slots;
+  }
+
+  /**
+   * @brief Respond to the batch's requests. The first request is responded to
+   * last so the batcher can't be woken up for its sequence's next step while
+   * the other sequences are still busy
+   */
+  static void respond(const Batch& batch) {
+    const auto& requests = batch.getRequests();
+    for (auto iter = requests.rbegin(); iter != requests.rend(); ++iter) {
+      (*iter)->runCallbackOnce(InferenceResponse{});
+    }
+  }
+
+  /// Wait until there are at least count errors and get them
+  std::vector<std::string> waitForErrors(size_t count) {
+    std::unique_lock lock{mutex_};
+    cv_.wait_for(lock, std::chrono::milliseconds{kTimeoutMs},
+                 [&] { return errors_.size() >= count; });
+    return errors_;
+  }
+
+  MemoryPool pool_;
+  std::optional<SequenceBatcher> batcher_;
+  bool stopped_ = false;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::string> errors_;
+};
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitSequenceBatcherFixture, Batching) {
+  const int32_t idle_timeout = 10000;
+  start(idle_timeout);
+  BatchPtr first;
+  BatchPtr second;
+  // each sequence gets its own slot
+  send("a", true);
+  EXPECT_EQ(next(&first), (std::vector<int32_t>{0}));
+  send("b", true);
+  EXPECT_EQ(next(&second), (std::vector<int32_t>{1}));
+  respond(*first);
+  respond(*second);
+
+  // a's step waits for b, which is between steps, to batch them together
+  send("a");
+  send("b");
+  EXPECT_EQ(next(&first), (std::vector<int32_t>{0, 1}));
+
+  // a's next step waits for its last one to respond
+  send("a", false, true);
+  EXPECT_FALSE(batcher_->getOutputQueue()->wait_dequeue_timed(second, 0));
+  respond(*first);
+  send("b");
+  EXPECT_EQ(next(&second), (std::vector<int32_t>{0, 1}));
+  respond(*second);
+
+  // a has ended so its slot can be used by a new sequence
+  send("c", true);
+  send("b");
+  EXPECT_EQ(next(&first), (std::vector<int32_t>{0, 1}));
+  respond(*first);
+  stop();
+  EXPECT_TRUE(waitForErrors(0).empty());
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitSequenceBatcherFixture, Errors) {
+  const int32_t idle_timeout = 100;
+  start(idle_timeout);
+  BatchPtr first;
+  BatchPtr second;
+  send("a");
+  send("a", true);
+  EXPECT_EQ(next(&first), (std::vector<int32_t>{0}));
+  send("b", true);
+  EXPECT_EQ(next(&second), (std::vector<int32_t>{1}));
+  respond(*first);
+  respond(*second);
+  const auto responded = std::chrono::steady_clock::now();
+  send("c", true);
+  EXPECT_EQ(waitForErrors(2),
+            (std::vector<std::string>{
+              "Sequence a hasn't started or has timed out",
+              "All 2 sequence slots are in use"}));
+
+  // a sequence that's idle for too long is ended
+  std::this_thread::sleep_until(responded +
+                                std::chrono::milliseconds{idle_timeout});
+  send("a");
+  EXPECT_EQ(waitForErrors(3),
+            (std::vector<std::string>{
+              "Sequence a hasn't started or has timed out",
+              "All 2 sequence slots are in use",
+              "Sequence a hasn't started or has timed out"}));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitSequenceBatcherFixture, Stop) {
+  const int32_t idle_timeout = 10000;
+  start(idle_timeout);
+  BatchPtr batch;
+  send("a", true);
+  EXPECT_EQ(next(&batch), (std::vector<int32_t>{0}));
+
+  // a's next step is still waiting for the last one when the batcher stops
+  send("a");
+  stop();
+  EXPECT_EQ(waitForErrors(1),
+            (std::vector<std::string>{
+              "Sequence a ended because its batcher stopped"}));
+  respond(*batch);
+}
+
+}  // namespace amdinfer
@@ -15,7 +15,8 @@
 
 #include <array>             // for array
 #include <cstddef>           // for size_t
-#include <cstdint>           // for uint8_t, uint64_t
+#include <cstdint>           // for uint8_t, int64_t, uint64_t
+#include <cstring>           // for memcpy
 #include <initializer_list>  // for initializer_list
 #include <memory>            // for allocator, make_unique
 #include <optional>          // for optional
@@ -28,6 +29,7 @@
 #include "amdinfer/build_options.hpp"           // for AMDINFER_ENABLE_LOGGING
 #include "amdinfer/core/data_types.hpp"         // for DataType, DataType::U...
 #include "amdinfer/core/inference_request.hpp"  // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
 #include "amdinfer/core/memory_pool/pool.hpp"   // for MemoryPool
 #include "amdinfer/core/parameters.hpp"         // for ParameterMap
 #include "amdinfer/core/request_container.hpp"  // for RequestContainer
@@ -225,4 +227,257 @@ const std::array kConfigs{
 INSTANTIATE_TEST_SUITE_P(Datatypes, UnitSoftBatcherFixture,
                          testing::ValuesIn(kConfigs));
 
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitSoftBatcher, Configure) {
+  MemoryPool pool;
+  ParameterMap parameters;
+  parameters.put("timeout", kTimeoutMs);
+  SoftBatcher batcher(&pool, &parameters);
+  batcher.setName("test");
+  const auto batch_size = 4;
+  batcher.setBatchSize(batch_size);
+  batcher.start({MemoryAllocators::Cpu});
+
+  const InferenceRequestInput input{nullptr, {1}, DataType::Uint8};
+  auto buffer = pool.get({MemoryAllocators::Cpu}, input, 1);
+  auto enqueue = [&](size_t count) {
+    for (auto i = 0U; i < count; ++i) {
+      auto request = std::make_shared<InferenceRequest>();
+      request->addInputTensor(buffer->data(0), {1}, DataType::Uint8);
+      auto container = std::make_unique<RequestContainer>();
+      container->request = std::move(request);
+      batcher.enqueue(std::move(container));
+    }
+  };
+
+  // the new batch size applies to the next batch
+  const auto new_batch_size = 2;
+  ParameterMap changes;
+  changes.put("batch_size", new_batch_size);
+  batcher.configure(changes);
+  enqueue(new_batch_size);
+  BatchPtr batch;
+  // well before the timeout, the batch is already full
+  ASSERT_TRUE(
+    batcher.getOutputQueue()->wait_dequeue_timed(batch, kTimeoutUs / 100));
+  EXPECT_EQ(batch->size(), new_batch_size);
+
+  // with a short timeout, a partial batch is sent without waiting long
+  const auto new_timeout = 1;
+  changes.put("timeout", new_timeout);
+  batcher.configure(changes);
+  enqueue(1);
+  ASSERT_TRUE(
+    batcher.getOutputQueue()->wait_dequeue_timed(batch, kTimeoutUs / 100));
+  EXPECT_EQ(batch->size(), 1);
+
+  batcher.enqueue(nullptr);
+  batcher.end();
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitSoftBatcher, SplitRequests) {
+  MemoryPool pool;
+  ParameterMap parameters;
+  parameters.put("timeout", kTimeoutMs);
+  parameters.put("split_requests", true);
+  SoftBatcher batcher(&pool, &parameters);
+  batcher.setName("test");
+  const auto batch_size = 2;
+  batcher.setBatchSize(batch_size);
+  batcher.start({MemoryAllocators::Cpu});
+
+  // each sample's two values are its index in all the requests' samples
+  uint8_t next = 0;
+  auto enqueue = [&](int64_t samples) {
+    const InferenceRequestInput input{nullptr, {samples, 2}, DataType::Uint8};
+    auto buffer = pool.get({MemoryAllocators::Cpu}, input, 1);
+    auto* data = static_cast<uint8_t*>(buffer->data(0));
+    for (auto i = 0; i < samples; ++i, ++next) {
+      data[i * 2] = next;
+      data[i * 2 + 1] = next;
+    }
+    auto request = std::make_shared<InferenceRequest>();
+    request->addInputTensor(data, {samples, 2}, DataType::Uint8);
+    auto container = std::make_unique<RequestContainer>();
+    container->request = std::move(request);
+    batcher.enqueue(std::move(container));
+  };
+
+  // the first request's last sample shares a batch with the second's first
+  const auto first = 5;
+  const auto second = 4;
+  enqueue(first);
+  enqueue(second);
+  // the batch with the single sample left is sent once the timeout expires
+  const std::vector<size_t> sizes{2, 2, 2, 2, 1};
+  uint8_t sample = 0;
+  for (const auto size : sizes) {
+    BatchPtr batch;
+    ASSERT_TRUE(
+      batcher.getOutputQueue()->wait_dequeue_timed(batch, kTimeoutUs));
+    ASSERT_EQ(batch->size(), size);
+    const auto* data =
+      static_cast<const uint8_t*>(batch->getInputBuffers()[0]->data(0));
+    for (auto i = 0U; i < size; ++i, ++sample) {
+      const auto& input = batch->getRequest(i)->getInputs()[0];
+      EXPECT_EQ(input.getShape(), std::vector<int64_t>({1, 2}));
+      EXPECT_EQ(data[i * 2], sample);
+      EXPECT_EQ(data[i * 2 + 1], sample);
+    }
+  }
+
+  batcher.enqueue(nullptr);
+  batcher.end();
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitSoftBatcher, Ragged) {
+  MemoryPool pool;
+  ParameterMap parameters;
+  parameters.put("timeout", kTimeoutMs);
+  parameters.put("ragged", true);
+  SoftBatcher batcher(&pool, &parameters);
+  batcher.setName("test");
+  const auto batch_size = 3;
+  batcher.setBatchSize(batch_size);
+  batcher.start({MemoryAllocators::Cpu});
+
+  // the batcher returns the requests' data to the pool so each request gets
+  // its own buffer
+  std::vector<BufferPtr> buffers;
+  auto enqueue = [&](const std::vector<uint8_t>& data, DataType datatype,
+                     bool* error) {
+    const auto length = static_cast<int64_t>(data.size());
+    const InferenceRequestInput input{nullptr, {length}, datatype};
+    auto& buffer = buffers.emplace_back(
+      pool.get({MemoryAllocators::Cpu}, input, 1));
+    std::memcpy(buffer->data(0), data.data(), data.size());
+    auto request = std::make_shared<InferenceRequest>();
+    request->addInputTensor(buffer->data(0), {length}, datatype);
+    request->setCallback([error](const InferenceResponse& response) {
+      *error = response.isError();
+    });
+    auto container = std::make_unique<RequestContainer>();
+    container->request = std::move(request);
+    batcher.enqueue(std::move(container));
+  };
+
+  bool error = false;
+  const std::vector<std::vector<uint8_t>> data{{1, 2}, {3, 4, 5, 6, 7}, {8}};
+  for (const auto& request_data : data) {
+    enqueue(request_data, DataType::Uint8, &error);
+  }
+
+  BatchPtr batch;
+  ASSERT_TRUE(batcher.getOutputQueue()->wait_dequeue_timed(batch, kTimeoutUs));
+  ASSERT_EQ(batch->size(), batch_size);
+  EXPECT_TRUE(batch->isRagged());
+  const auto offsets = batch->getInputOffsets(0);
+  EXPECT_EQ(offsets, (std::vector<size_t>{0, 2, 7, 8}));
+  // the requests are packed in order and point into the batch's buffer
+  const auto* packed =
+    static_cast<const uint8_t*>(batch->getInputBuffers()[0]->data(0));
+  EXPECT_EQ((std::vector<uint8_t>{packed, packed + offsets.back()}),
+            (std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8}));
+  for (auto i = 0U; i < batch_size; ++i) {
+    EXPECT_EQ(batch->getRequest(i)->getInputs()[0].getData(),
+              packed + offsets[i]);
+  }
+
+  // a request with different datatypes than the rest of the batch is rejected
+  // and its data is returned to the pool. It's bigger than the pool's blocks
+  // so it gets a block of its own that's handed out again once it's freed
+  bool mismatch_error = false;
+  const auto mismatch_length = 1 << 20;
+  enqueue({1}, DataType::Uint8, &error);
+  enqueue(std::vector<uint8_t>(mismatch_length), DataType::Uint32,
+          &mismatch_error);
+  const auto* mismatch_data = buffers.back()->data(0);
+  enqueue({2, 3}, DataType::Uint8, &error);
+  enqueue({4}, DataType::Uint8, &error);
+  ASSERT_TRUE(batcher.getOutputQueue()->wait_dequeue_timed(batch, kTimeoutUs));
+  EXPECT_EQ(batch->size(), batch_size);
+  EXPECT_EQ(batch->getInputOffsets(0), (std::vector<size_t>{0, 1, 3, 4}));
+  EXPECT_TRUE(mismatch_error);
+  EXPECT_FALSE(error);
+  const InferenceRequestInput mismatch_input{nullptr, {mismatch_length},
+                                             DataType::Uint32};
+  auto reused = pool.get({MemoryAllocators::Cpu}, mismatch_input, 1);
+  EXPECT_EQ(reused->data(0), mismatch_data);
+
+  batcher.enqueue(nullptr);
+  batcher.end();
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitSoftBatcher, Padding) {
+  for (const auto padding : {BatchPadding::Zeros, BatchPadding::Replicate}) {
+    MemoryPool pool;
+    ParameterMap parameters;
+    // a short timeout so partial batches are made quickly
+    const auto timeout = 10;
+    parameters.put("timeout", timeout);
+    SoftBatcher batcher(&pool, &parameters);
+    batcher.setName("test");
+    const auto batch_size = 4;
+    batcher.setBatchSize(batch_size);
+    batcher.setBatchSizes({4, 1, 2}, padding);
+    batcher.start({MemoryAllocators::Cpu});
+
+    std::vector<BufferPtr> buffers;
+    auto enqueue = [&](uint8_t value) {
+      const InferenceRequestInput input{nullptr, {2}, DataType::Uint8};
+      auto& buffer =
+        buffers.emplace_back(pool.get({MemoryAllocators::Cpu}, input, 1));
+      const std::array<uint8_t, 2> data{value, value};
+      std::memcpy(buffer->data(0), data.data(), data.size());
+      auto request = std::make_shared<InferenceRequest>();
+      request->addInputTensor(buffer->data(0), {2}, DataType::Uint8);
+      auto container = std::make_unique<RequestContainer>();
+      container->request = std::move(request);
+      batcher.enqueue(std::move(container));
+    };
+
+    // three requests are padded to the supported batch size of four
+    for (uint8_t i = 1; i <= 3; ++i) {
+      enqueue(i);
+    }
+    BatchPtr batch;
+    ASSERT_TRUE(
+      batcher.getOutputQueue()->wait_dequeue_timed(batch, kTimeoutUs));
+    ASSERT_EQ(batch->size(), 3);
+    EXPECT_EQ(batch->getPaddedSize(), batch_size);
+    const auto* data =
+      static_cast<const uint8_t*>(batch->getInputBuffers()[0]->data(0));
+    const uint8_t pad = padding == BatchPadding::Zeros ? 0 : 1;
+    EXPECT_EQ((std::vector<uint8_t>{data, data + 8}),
+              (std::vector<uint8_t>{1, 1, 2, 2, 3, 3, pad, pad}));
+
+    // a batch that's already a supported size isn't padded
+    for (uint8_t i = 1; i <= 2; ++i) {
+      enqueue(i);
+    }
+    ASSERT_TRUE(
+      batcher.getOutputQueue()->wait_dequeue_timed(batch, kTimeoutUs));
+    ASSERT_EQ(batch->size(), 2);
+    EXPECT_EQ(batch->getPaddedSize(), 2);
+
+    // lowering the batch size below a supported size still pads full batches
+    ParameterMap changes;
+    changes.put("batch_size", 3);
+    batcher.configure(changes);
+    for (uint8_t i = 1; i <= 3; ++i) {
+      enqueue(i);
+    }
+    ASSERT_TRUE(
+      batcher.getOutputQueue()->wait_dequeue_timed(batch, kTimeoutUs));
+    ASSERT_EQ(batch->size(), 3);
+    EXPECT_EQ(batch->getPaddedSize(), batch_size);
+
+    batcher.enqueue(nullptr);
+    batcher.end();
+  }
+}
+
 }  // namespace amdinfer
@@ -0,0 +1,135 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>   // for byte
+#include <cstdint>   // for uint8_t, int64_t
+#include <memory>    // for make_shared, make_unique
+#include <optional>  // for optional
+#include <utility>   // for move
+#include <vector>    // for vector
+
+#include "amdinfer/batching/split.hpp"           // for splitRequest
+#include "amdinfer/buffers/buffer.hpp"           // for Buffer
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"    // for MemoryPool
+#include "amdinfer/core/request_container.hpp"   // for RequestContainer
+#include "gtest/gtest.h"                         // for Test, EXPECT_EQ
+
+namespace amdinfer {
+
+class UnitSplitFixture : public testing::Test {
+ protected:
+  void SetUp() override {
+    // each sample's two values are its index and ten times its index
+    const InferenceRequestInput input{nullptr, {kSamples, 2}, DataType::Uint8};
+    auto buffer = pool_.get({MemoryAllocators::Cpu}, input, 1);
+    auto* data = static_cast<uint8_t*>(buffer->data(0));
+    for (auto i = 0; i < kSamples; ++i) {
+      data[i * 2] = i;
+      data[i * 2 + 1] = i * 10;
+    }
+
+    auto request = std::make_shared<InferenceRequest>();
+    request->setID("split");
+    request->addInputTensor(data, {kSamples, 2}, DataType::Uint8);
+    request->setCallback(
+      [this](const InferenceResponse& response) { response_ = response; });
+    container_.request = std::move(request);
+  }
+
+  /// Respond to a sample by echoing its input, or with an error
+  static void respond(const RequestContainer& sample, bool error = false) {
+    if (error) {
+      sample.request->runCallbackError("bad sample");
+      return;
+    }
+    const auto& input = sample.request->getInputs()[0];
+    const auto* data = static_cast<std::byte*>(input.getData());
+    InferenceResponseOutput output;
+    output.setName("output");
+    output.setDatatype(input.getDatatype());
+    output.setShape(input.getShape());
+    output.setData({data, data + input.getSize()});
+    InferenceResponse response;
+    response.addOutput(output);
+    sample.request->runCallbackOnce(response);
+  }
+
+  static constexpr int64_t kSamples = 5;
+  MemoryPool pool_;
+  RequestContainer container_;
+  std::optional<InferenceResponse> response_;
+};
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitSplitFixture, Split) {
+  auto samples = splitRequest(&container_, &pool_);
+  ASSERT_EQ(samples.size(), kSamples);
+  for (auto i = 0; i < kSamples; ++i) {
+    const auto& request = samples[i]->request;
+    EXPECT_EQ(request->getID(), "split");
+    const auto& input = request->getInputs()[0];
+    EXPECT_EQ(input.getShape(), std::vector<int64_t>({1, 2}));
+    const auto* data = static_cast<uint8_t*>(input.getData());
+    EXPECT_EQ(data[0], i);
+    EXPECT_EQ(data[1], i * 10);
+  }
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitSplitFixture, Reassemble) {
+  auto samples = splitRequest(&container_, &pool_);
+  ASSERT_EQ(samples.size(), kSamples);
+  // respond out of order to check the response is assembled in order
+  for (auto i = kSamples - 1; i >= 0; --i) {
+    EXPECT_FALSE(response_.has_value());
+    respond(*samples[i]);
+  }
+  ASSERT_TRUE(response_.has_value());
+  EXPECT_FALSE(response_->isError());
+  EXPECT_EQ(response_->getID(), "split");
+  const auto& output = response_->getOutputs()[0];
+  EXPECT_EQ(output.getShape(), std::vector<int64_t>({kSamples, 2}));
+  const auto* data = static_cast<uint8_t*>(output.getData());
+  for (auto i = 0; i < kSamples; ++i) {
+    EXPECT_EQ(data[i * 2], i);
+    EXPECT_EQ(data[i * 2 + 1], i * 10);
+  }
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitSplitFixture, PartialFailure) {
+  auto samples = splitRequest(&container_, &pool_);
+  ASSERT_EQ(samples.size(), kSamples);
+  for (auto i = 0; i < kSamples; ++i) {
+    respond(*samples[i], i == 2);
+  }
+  ASSERT_TRUE(response_.has_value());
+  EXPECT_TRUE(response_->isError());
+  EXPECT_EQ(response_->getError(), "Sample 2 of 5 failed: bad sample");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitSplitFixture, NoSplit) {
+  RequestContainer container;
+  container.request = std::make_shared<InferenceRequest>();
+  const InferenceRequestInput input{nullptr, {1, 2}, DataType::Uint8};
+  auto buffer = pool_.get({MemoryAllocators::Cpu}, input, 1);
+  container.request->addInputTensor(buffer->data(0), {1, 2}, DataType::Uint8);
+  EXPECT_TRUE(splitRequest(&container, &pool_).empty());
+}
+
+}  // namespace amdinfer
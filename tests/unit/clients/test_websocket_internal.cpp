@@ -0,0 +1,145 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>  // for byte
+#include <cstdint>  // for uint8_t, int32_t
+#include <cstring>  // for memcpy
+#include <string>   // for string
+#include <tuple>    // for ignore
+#include <vector>   // for vector
+
+#include "amdinfer/clients/websocket_internal.hpp"  // for encodeWsResponse
+#include "amdinfer/core/data_types.hpp"             // for DataType
+#include "amdinfer/core/exceptions.hpp"             // for invalid_argument
+#include "amdinfer/core/inference_request.hpp"      // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"     // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"       // for MemoryPool
+#include "amdinfer/core/parameters.hpp"             // for ParameterMap
+#include "gtest/gtest.h"                            // for Test, EXPECT_EQ
+
+namespace amdinfer {
+
+InferenceResponseOutput makeOutput(const std::string& name, DataType type,
+                                   const std::vector<int64_t>& shape,
+                                   const void* data, size_t size) {
+  InferenceResponseOutput output;
+  output.setName(name);
+  output.setDatatype(type);
+  output.setShape(shape);
+  std::vector<std::byte> buffer(size);
+  std::memcpy(buffer.data(), data, size);
+  output.setData(std::move(buffer));
+  return output;
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitWebsocketInternal, ResponseRoundTrip) {
+  const std::vector<float> image{1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F};
+  const std::string key = "frame0";
+
+  InferenceResponse response;
+  response.setID("id");
+  response.setModel("model");
+  ParameterMap parameters;
+  parameters.put("key", key);
+  parameters.put("count", 3);
+  parameters.put("fps", 29.97);
+  parameters.put("last", true);
+  response.setParameters(parameters);
+  response.addOutput(makeOutput("image", DataType::Fp32, {2, 3}, image.data(),
+                                image.size() * sizeof(float)));
+  response.addOutput(
+    makeOutput("key", DataType::Bytes, {6}, key.data(), key.size()));
+
+  const auto frame = encodeWsResponse(response);
+  const auto decoded = decodeWsResponse(frame);
+
+  ASSERT_FALSE(decoded.isError());
+  EXPECT_EQ(decoded.getID(), "id");
+  EXPECT_EQ(decoded.getModel(), "model");
+  const auto* decoded_parameters = decoded.getParameters();
+  ASSERT_NE(decoded_parameters, nullptr);
+  EXPECT_EQ(decoded_parameters->get<std::string>("key"), key);
+  EXPECT_EQ(decoded_parameters->get<int32_t>("count"), 3);
+  EXPECT_EQ(decoded_parameters->get<double>("fps"), 29.97);
+  EXPECT_TRUE(decoded_parameters->get<bool>("last"));
+
+  const auto& outputs = decoded.getOutputs();
+  ASSERT_EQ(outputs.size(), 2);
+  EXPECT_EQ(outputs[0].getName(), "image");
+  EXPECT_EQ(outputs[0].getDatatype(), DataType::Fp32);
+  EXPECT_EQ(outputs[0].getShape(), (std::vector<int64_t>{2, 3}));
+  const auto* data = static_cast<const float*>(outputs[0].getData());
+  EXPECT_EQ((std::vector<float>{data, data + image.size()}), image);
+  EXPECT_EQ(outputs[1].getName(), "key");
+  EXPECT_EQ(outputs[1].getDatatype(), DataType::Bytes);
+  EXPECT_EQ(
+    (std::string{static_cast<const char*>(outputs[1].getData()), key.size()}),
+    key);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitWebsocketInternal, ErrorResponse) {
+  const InferenceResponse response{"something went wrong"};
+  const auto decoded = decodeWsResponse(encodeWsResponse(response));
+  ASSERT_TRUE(decoded.isError());
+  EXPECT_EQ(decoded.getError(), "something went wrong");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitWebsocketInternal, RequestRoundTrip) {
+  std::vector<uint8_t> data{1, 2, 3, 4};
+  InferenceRequest request;
+  request.setID("request");
+  ParameterMap parameters;
+  parameters.put("key", "0");
+  request.setParameters(parameters);
+  request.addInputTensor(data.data(), {2, 2}, DataType::Uint8);
+  InferenceRequestOutput output;
+  output.setName("image");
+  request.addOutputTensor(output);
+
+  const auto frame = encodeWsRequest("invert_video", request);
+
+  const MemoryPool pool;
+  std::string model;
+  auto decoded = decodeWsRequest(frame, &pool, &model);
+  EXPECT_EQ(model, "invert_video");
+  EXPECT_EQ(decoded->getID(), "request");
+  EXPECT_EQ(decoded->getParameters().get<std::string>("key"), "0");
+  ASSERT_EQ(decoded->getOutputs().size(), 1);
+  EXPECT_EQ(decoded->getOutputs()[0].getName(), "image");
+
+  const auto& inputs = decoded->getInputs();
+  ASSERT_EQ(inputs.size(), 1);
+  EXPECT_EQ(inputs[0].getShape(), (std::vector<int64_t>{2, 2}));
+  EXPECT_EQ(inputs[0].getDatatype(), DataType::Uint8);
+  const auto* input_data = static_cast<const uint8_t*>(inputs[0].getData());
+  EXPECT_EQ((std::vector<uint8_t>{input_data, input_data + data.size()}), data);
+  pool.put(MemoryAllocators::Cpu, inputs[0].getData());
+
+  // every truncation of a valid frame must be rejected
+  for (size_t i = 0; i < frame.size(); ++i) {
+    EXPECT_THROW(std::ignore = decodeWsRequest(frame.substr(0, i), &pool,
+                                               &model),
+                 invalid_argument);
+  }
+  // as must a response frame sent as a request
+  EXPECT_THROW(
+    std::ignore = decodeWsRequest(encodeWsResponse(InferenceResponse{}), &pool,
+                                  &model),
+    invalid_argument);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,153 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <chrono>      // for milliseconds
+#include <filesystem>  // for path, temp_directory_path, remove_all
+#include <fstream>     // for ofstream, ifstream
+#include <iterator>    // for istreambuf_iterator
+#include <stdexcept>   // for runtime_error
+#include <string>      // for string
+#include <thread>      // for sleep_for
+
+#include "amdinfer/core/artifact_cache.hpp"  // for ArtifactCache
+#include "amdinfer/core/exceptions.hpp"      // for file_not_found_error
+#include "amdinfer/core/parameters.hpp"      // for ParameterMap
+#include "gtest/gtest.h"                     // for Test, EXPECT_EQ, TEST
+
+namespace fs = std::filesystem;
+
+namespace amdinfer {
+
+class UnitArtifactCacheFixture : public testing::Test {
+ protected:
+  void SetUp() override {
+    fs::remove_all(directory_);
+    fs::create_directories(directory_);
+    model_ = directory_ / "model.onnx";
+    std::ofstream{model_} << "model";
+  }
+
+  void TearDown() override { fs::remove_all(directory_); }
+
+  /// "Compile" the model by reversing it into an artifact of the given size
+  ArtifactCache::Compiler makeCompiler(size_t size) {
+    return [this, size](const fs::path& path) {
+      ++compiles_;
+      std::ifstream model{model_};
+      std::string contents{std::istreambuf_iterator<char>{model}, {}};
+      contents = std::string{contents.rbegin(), contents.rend()};
+      contents.resize(size, '.');
+      std::ofstream{path} << contents;
+    };
+  }
+
+  const fs::path directory_ =
+    fs::temp_directory_path() / "amdinfer_unit_artifact_cache";
+  fs::path model_;
+  int compiles_ = 0;
+};
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitArtifactCacheFixture, Key) {
+  const auto key = ArtifactCache::makeKey(model_, "fake", {{"batch", "4"}});
+  EXPECT_EQ(key, ArtifactCache::makeKey(model_, "fake", {{"batch", "4"}}));
+  EXPECT_NE(key, ArtifactCache::makeKey(model_, "other", {{"batch", "4"}}));
+  EXPECT_NE(key, ArtifactCache::makeKey(model_, "fake", {{"batch", "8"}}));
+
+  // the key follows the contents of the model, not its name
+  std::ofstream{model_} << "changed";
+  EXPECT_NE(key, ArtifactCache::makeKey(model_, "fake", {{"batch", "4"}}));
+
+  EXPECT_THROW(
+    (void)ArtifactCache::makeKey(directory_ / "missing", "fake", {}),
+    file_not_found_error);
+
+  // without a model file, the rest of the key still distinguishes artifacts
+  const auto no_model = ArtifactCache::makeKey({}, "fake", {{"batch", "4"}});
+  EXPECT_EQ(no_model, ArtifactCache::makeKey({}, "fake", {{"batch", "4"}}));
+  EXPECT_NE(no_model, ArtifactCache::makeKey({}, "fake", {{"batch", "8"}}));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitArtifactCacheFixture, Get) {
+  ArtifactCache cache{directory_ / "cache", 0};
+  const auto key = ArtifactCache::makeKey(model_, "fake", {});
+  EXPECT_FALSE(cache.contains(key));
+
+  const auto compile = makeCompiler(5);
+  const auto path = cache.get(key, compile);
+  EXPECT_EQ(compiles_, 1);
+  EXPECT_TRUE(cache.contains(key));
+  std::ifstream artifact{path};
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>{artifact}, {}),
+            "ledom");
+
+  EXPECT_EQ(cache.get(key, compile), path);
+  EXPECT_EQ(compiles_, 1);
+
+  // a failed compile leaves nothing behind
+  const auto other = ArtifactCache::makeKey(model_, "other", {});
+  EXPECT_THROW(cache.get(other,
+                         [](const fs::path& path) {
+                           std::ofstream{path} << "partial";
+                           throw std::runtime_error("failed");
+                         }),
+               std::runtime_error);
+  EXPECT_FALSE(cache.contains(other));
+  EXPECT_EQ(std::distance(fs::directory_iterator(directory_ / "cache"),
+                          fs::directory_iterator{}),
+            1);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitArtifactCacheFixture, Evict) {
+  const auto size = 1000;
+  ArtifactCache cache{directory_ / "cache", 2 * size + size / 2};
+  const auto compile = makeCompiler(size);
+  const auto first = ArtifactCache::makeKey(model_, "first", {});
+  const auto second = ArtifactCache::makeKey(model_, "second", {});
+  const auto third = ArtifactCache::makeKey(model_, "third", {});
+
+  const auto delay = std::chrono::milliseconds(10);
+  cache.get(first, compile);
+  std::this_thread::sleep_for(delay);
+  cache.get(second, compile);
+  std::this_thread::sleep_for(delay);
+  // using the first artifact makes the second the least recently used
+  cache.get(first, compile);
+  std::this_thread::sleep_for(delay);
+  cache.get(third, compile);
+
+  EXPECT_TRUE(cache.contains(first));
+  EXPECT_FALSE(cache.contains(second));
+  EXPECT_TRUE(cache.contains(third));
+  EXPECT_EQ(compiles_, 3);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitArtifactCacheFixture, FromParameters) {
+  ParameterMap parameters;
+  EXPECT_FALSE(ArtifactCache::enabled(parameters));
+  EXPECT_THROW((void)ArtifactCache::fromParameters(parameters),
+               invalid_argument);
+
+  parameters.put("artifact_cache", (directory_ / "cache").string());
+  parameters.put("artifact_cache_size", -1);
+  EXPECT_TRUE(ArtifactCache::enabled(parameters));
+  EXPECT_THROW((void)ArtifactCache::fromParameters(parameters),
+               invalid_argument);
+}
+
+}  // namespace amdinfer
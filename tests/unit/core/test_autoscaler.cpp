@@ -0,0 +1,104 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <chrono>    // for milliseconds
+#include <optional>  // for optional
+#include <tuple>     // for ignore
+
+#include "amdinfer/core/autoscaler.hpp"  // for Autoscaler, AutoscalePolicy
+#include "amdinfer/core/exceptions.hpp"  // for invalid_argument
+#include "amdinfer/core/parameters.hpp"  // for ParameterMap
+#include "gtest/gtest.h"                 // for Test, EXPECT_EQ, TEST
+
+namespace amdinfer {
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitAutoscaler, Policy) {
+  ParameterMap parameters;
+  EXPECT_FALSE(getAutoscalePolicy(parameters).has_value());
+
+  parameters.put("autoscale_max_workers", 4);
+  parameters.put("autoscale_spare_workers", 1);
+  parameters.put("autoscale_cooldown", 50);
+  auto policy = getAutoscalePolicy(parameters);
+  ASSERT_TRUE(policy.has_value());
+  EXPECT_EQ(policy->min_workers, 1);
+  EXPECT_EQ(policy->max_workers, 4);
+  EXPECT_EQ(policy->spare_workers, 1);
+  EXPECT_EQ(policy->queue_depth, 1);
+  EXPECT_EQ(policy->cooldown, std::chrono::milliseconds(50));
+
+  parameters.put("autoscale_min_workers", 5);
+  EXPECT_THROW(std::ignore = getAutoscalePolicy(parameters), invalid_argument);
+  parameters.put("autoscale_min_workers", 1);
+  parameters.put("autoscale_spare_workers", -1);
+  EXPECT_THROW(std::ignore = getAutoscalePolicy(parameters), invalid_argument);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitAutoscaler, Sample) {
+  AutoscalePolicy policy;
+  policy.max_workers = 3;
+  policy.queue_depth = 2;
+  policy.cooldown = std::chrono::milliseconds(100);
+
+  Autoscaler autoscaler;
+  autoscaler.add("model", policy);
+  const auto start = Autoscaler::Clock::now();
+  auto at = [&](int ms) { return start + std::chrono::milliseconds(ms); };
+
+  // workers are added one at a time without waiting, up to the maximum
+  EXPECT_EQ(autoscaler.sample("model", 1, 0, at(0)), 0);
+  EXPECT_EQ(autoscaler.sample("model", 1, 3, at(10)), 1);
+  EXPECT_EQ(autoscaler.sample("model", 2, 3, at(20)), 0);
+  EXPECT_EQ(autoscaler.sample("model", 2, 10, at(30)), 1);
+  EXPECT_EQ(autoscaler.sample("model", 3, 10, at(40)), 0);
+
+  // and retired one per cooldown once the queue is empty
+  EXPECT_EQ(autoscaler.sample("model", 3, 0, at(50)), 0);
+  EXPECT_EQ(autoscaler.sample("model", 3, 0, at(100)), 0);
+  EXPECT_EQ(autoscaler.sample("model", 3, 0, at(150)), -1);
+  EXPECT_EQ(autoscaler.sample("model", 2, 0, at(200)), 0);
+  EXPECT_EQ(autoscaler.sample("model", 2, 0, at(250)), -1);
+  EXPECT_EQ(autoscaler.sample("model", 1, 0, at(400)), 0);
+
+  // a burst during the cooldown restarts it
+  EXPECT_EQ(autoscaler.sample("model", 2, 0, at(500)), 0);
+  EXPECT_EQ(autoscaler.sample("model", 2, 4, at(550)), 0);
+  EXPECT_EQ(autoscaler.sample("model", 2, 0, at(600)), 0);
+  EXPECT_EQ(autoscaler.sample("model", 2, 0, at(700)), -1);
+
+  autoscaler.remove("model");
+  EXPECT_TRUE(autoscaler.endpoints().empty());
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitAutoscaler, Spare) {
+  AutoscalePolicy policy;
+  policy.max_workers = 4;
+  policy.spare_workers = 1;
+
+  Autoscaler autoscaler;
+  autoscaler.add("model", policy);
+  const auto now = Autoscaler::Clock::now();
+
+  // even when idle, one more worker than the busy one is kept
+  EXPECT_EQ(autoscaler.sample("model", 1, 0, now), 1);
+  EXPECT_EQ(autoscaler.sample("model", 2, 0, now), 0);
+  EXPECT_EQ(autoscaler.sample("model", 2, 2, now), 1);
+  EXPECT_EQ(autoscaler.sample("model", 3, 2, now), 0);
+}
+
+}  // namespace amdinfer
@@ -16,6 +16,7 @@
 
 #include <iostream>
 
+#include "amdinfer/core/exceptions.hpp"          // for invalid_argument
 #include "amdinfer/core/model_config.hpp"        // for ModelConfig
 #include "amdinfer/core/versioned_endpoint.hpp"  // for getVersionedEndpoint
 #include "gtest/gtest.h"  // for Message, TestPartResult, Test
@@ -153,4 +154,98 @@ TEST(UnitModelConfig, Chain) {
   }
 }
 
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitModelConfig, Warmup) {
+  constexpr std::string_view kTomlStr = R"(
+    name = "echo"
+    platform = "amdinfer_cpp"
+
+    [[inputs]]
+    name = "input"
+    datatype = "UINT32"
+    shape = [1]
+
+    [[outputs]]
+    name = "output"
+    datatype = "UINT32"
+    shape = [1]
+
+    [warmup]
+    batch_sizes = [1, 4]
+    count = 2
+    data = "warmup"
+  )"sv;
+
+  const auto toml = toml::parse(kTomlStr);
+  ModelConfig config{toml, ""};
+  config.setModelFiles("/models/echo/1");
+
+  ASSERT_EQ(config.size(), 1);
+  const auto& [model, parameters] = config.get(0);
+  EXPECT_EQ(parameters.get<std::string>("warmup_batch_sizes"), "1,4");
+  EXPECT_EQ(parameters.get<int32_t>("warmup_count"), 2);
+  // the data directory is relative to the model files
+  EXPECT_EQ(parameters.get<std::string>("warmup_data"),
+            "/models/echo/1/warmup");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitModelConfig, WarmupInvalid) {
+  constexpr std::string_view kTomlStr = R"(
+    name = "echo"
+    platform = "amdinfer_cpp"
+
+    [[inputs]]
+    name = "input"
+    datatype = "UINT32"
+    shape = [1]
+
+    [[outputs]]
+    name = "output"
+    datatype = "UINT32"
+    shape = [1]
+
+    [warmup]
+    batch_sizes = [0]
+  )"sv;
+
+  const auto toml = toml::parse(kTomlStr);
+  EXPECT_THROW(ModelConfig(toml, ""), invalid_argument);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitModelConfig, Autotune) {
+  constexpr std::string_view kTomlStr = R"(
+    name = "echo"
+    platform = "amdinfer_cpp"
+
+    [[inputs]]
+    name = "input"
+    datatype = "UINT32"
+    shape = [1]
+
+    [[outputs]]
+    name = "output"
+    datatype = "UINT32"
+    shape = [1]
+
+    [autotune]
+    latency = 20
+    batch_sizes = [1, 8]
+  )"sv;
+
+  const auto toml = toml::parse(kTomlStr);
+  ModelConfig config{toml, "1"};
+  config.setModelFiles("/models/echo/1");
+
+  ASSERT_EQ(config.size(), 1);
+  const auto& [model, parameters] = config.get(0);
+  EXPECT_EQ(parameters.get<double>("autotune_latency"), 20.0);
+  EXPECT_EQ(parameters.get<std::string>("autotune_batch_sizes"), "1,8");
+  EXPECT_EQ(parameters.get<int32_t>("autotune_rounds"), 5);
+  // the results are saved next to the configuration
+  EXPECT_EQ(parameters.get<std::string>("autotune_cache"),
+            "/models/echo/autotune_echo_1.toml");
+}
+
 }  // namespace amdinfer
@@ -0,0 +1,94 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>  // for seconds, milliseconds
+#include <string>  // for string
+
+#include "amdinfer/core/exceptions.hpp"    // for invalid_argument
+#include "amdinfer/core/parameters.hpp"    // for ParameterMap
+#include "amdinfer/core/rate_limiter.hpp"  // for RateLimiter, TokenBucket
+#include "gtest/gtest.h"                   // for Test, EXPECT_TRUE
+
+namespace amdinfer {
+
+// the rates are low enough that no tokens are added while the tests run
+constexpr double kSlowRate = 0.001;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitTokenBucket, Refill) {
+  const auto start = TokenBucket::Clock::now();
+  TokenBucket bucket{2, 2, start};
+  EXPECT_TRUE(bucket.full());
+  bucket.take();
+  bucket.take();
+  EXPECT_FALSE(bucket.ready());
+
+  bucket.refill(start + std::chrono::milliseconds(500));
+  EXPECT_TRUE(bucket.ready());
+  EXPECT_FALSE(bucket.full());
+
+  // the bucket never holds more than the burst
+  bucket.refill(start + std::chrono::seconds(10));
+  EXPECT_TRUE(bucket.full());
+  bucket.take();
+  bucket.take();
+  EXPECT_FALSE(bucket.ready());
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitRateLimiter, ModelLimit) {
+  RateLimiter limiter{kSlowRate, 2, 0, 0};
+  EXPECT_TRUE(limiter.admit("alice"));
+  EXPECT_TRUE(limiter.admit("bob"));
+  EXPECT_FALSE(limiter.admit("alice"));
+  EXPECT_FALSE(limiter.admit(""));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitRateLimiter, ClientLimit) {
+  RateLimiter limiter{0, 0, kSlowRate, 1};
+  EXPECT_TRUE(limiter.admit("alice"));
+  EXPECT_FALSE(limiter.admit("alice"));
+  EXPECT_TRUE(limiter.admit("bob"));
+  // requests without a client ID only count against the model's limit
+  EXPECT_TRUE(limiter.admit(""));
+  EXPECT_TRUE(limiter.admit(""));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitRateLimiter, RejectedClientKeepsModelTokens) {
+  RateLimiter limiter{kSlowRate, 2, kSlowRate, 1};
+  EXPECT_TRUE(limiter.admit("alice"));
+  EXPECT_FALSE(limiter.admit("alice"));
+  // alice's rejected request didn't use the model's last token
+  EXPECT_TRUE(limiter.admit("bob"));
+  EXPECT_FALSE(limiter.admit("carol"));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitRateLimiter, Make) {
+  ParameterMap parameters;
+  EXPECT_EQ(RateLimiter::make(parameters), nullptr);
+
+  parameters.put("rate_limit", 1);
+  EXPECT_NE(RateLimiter::make(parameters), nullptr);
+
+  parameters.put("client_rate_limit", -1.0);
+  EXPECT_THROW(RateLimiter::make(parameters), invalid_argument);
+
+  parameters.put("client_rate_limit", std::string{"fast"});
+  EXPECT_THROW(RateLimiter::make(parameters), invalid_argument);
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,171 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>  // for copy
+#include <cstddef>    // for byte, size_t
+#include <cstdint>    // for uint8_t, int64_t, uint64_t
+#include <memory>     // for make_shared, shared_ptr
+#include <string>     // for string
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "amdinfer/buffers/buffer.hpp"           // for Buffer
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/memory_pool/pool.hpp"    // for MemoryPool
+#include "amdinfer/core/request_container.hpp"   // for RequestContainer
+#include "amdinfer/core/response_cache.hpp"      // for ResponseCache
+#include "gtest/gtest.h"                         // for Test, EXPECT_EQ
+
+namespace amdinfer {
+
+class UnitResponseCacheFixture : public testing::Test {
+ protected:
+  /// Make a request for the given input whose responses are recorded
+  RequestContainer make(const std::string& id,
+                        const std::vector<uint8_t>* values) {
+    const auto size = static_cast<int64_t>(values->size());
+    const InferenceRequestInput input{nullptr, {size}, DataType::Uint8};
+    auto buffer = pool_.get({MemoryAllocators::Cpu}, input, 1);
+    auto* data = static_cast<uint8_t*>(buffer->data(0));
+    std::copy(values->begin(), values->end(), data);
+
+    auto request = std::make_shared<InferenceRequest>();
+    request->setID(id);
+    request->addInputTensor(data, {size}, DataType::Uint8);
+    request->setCallback([this](const InferenceResponse& response) {
+      responses_.push_back(response);
+    });
+    RequestContainer container;
+    container.request = std::move(request);
+    return container;
+  }
+
+  /// Respond to a request with an output of the given size
+  static void respond(const RequestContainer& request, size_t size) {
+    InferenceResponseOutput output;
+    output.setName("output");
+    output.setDatatype(DataType::Uint8);
+    output.setShape({static_cast<int64_t>(size)});
+    output.setData(std::vector<std::byte>(size, std::byte{1}));
+    InferenceResponse response;
+    response.setID(request.request->getID());
+    response.addOutput(output);
+    request.request->runCallbackOnce(response);
+  }
+
+  /// Send a request and respond to it if it isn't answered from the cache
+  bool send(uint64_t group, std::vector<uint8_t>* values, size_t size = 1) {
+    auto request = make("request", values);
+    if (cache_->respond(group, &request, &pool_)) {
+      return true;
+    }
+    respond(request, size);
+    return false;
+  }
+
+  // there are 16 shards so each gets 64 bytes
+  static constexpr size_t kMaxBytes = 1024;
+  MemoryPool pool_;
+  std::shared_ptr<ResponseCache> cache_ =
+    std::make_shared<ResponseCache>(kMaxBytes);
+  std::vector<InferenceResponse> responses_;
+};
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitResponseCacheFixture, Hit) {
+  std::vector<uint8_t> values{1, 2, 3};
+  std::vector<uint8_t> other{1, 2, 4};
+  EXPECT_FALSE(send(1, &values));
+  EXPECT_TRUE(send(1, &values));
+  EXPECT_FALSE(send(1, &other));
+  // another worker group doesn't see the first group's responses
+  EXPECT_FALSE(send(2, &values));
+
+  auto request = make("hit", &values);
+  ASSERT_TRUE(cache_->respond(1, &request, &pool_));
+  const auto& response = responses_.back();
+  EXPECT_EQ(response.getID(), "hit");
+  ASSERT_EQ(response.getOutputs().size(), 1);
+  EXPECT_EQ(response.getOutputs()[0].getShape(), (std::vector<int64_t>{1}));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitResponseCacheFixture, FreeInputs) {
+  std::vector<uint8_t> values{1, 2, 3};
+  EXPECT_FALSE(send(1, &values));
+
+  auto request = make("hit", &values);
+  auto* data = request.request->getInputs()[0].getData();
+  ASSERT_TRUE(cache_->respond(1, &request, &pool_));
+  // the hit's input buffer is back in the pool to be handed out again
+  const InferenceRequestInput input{nullptr, {3}, DataType::Uint8};
+  auto buffer = pool_.get({MemoryAllocators::Cpu}, input, 1);
+  EXPECT_EQ(buffer->data(0), data);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitResponseCacheFixture, Errors) {
+  std::vector<uint8_t> values{1, 2, 3};
+  auto request = make("error", &values);
+  EXPECT_FALSE(cache_->respond(1, &request, &pool_));
+  request.request->runCallbackError("failed");
+  // errors aren't cached
+  EXPECT_FALSE(send(1, &values));
+  EXPECT_TRUE(send(1, &values));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitResponseCacheFixture, Evict) {
+  // responses bigger than a shard are never cached
+  std::vector<uint8_t> values{1};
+  const size_t large = 100;
+  EXPECT_FALSE(send(1, &values, large));
+  EXPECT_FALSE(send(1, &values, large));
+
+  // a shard's least recently used responses are evicted to make room for new
+  // ones but the budget is big enough for some responses
+  std::vector<std::vector<uint8_t>> inputs;
+  const auto count = 64;
+  for (auto i = 0; i < count; ++i) {
+    inputs.push_back({static_cast<uint8_t>(i + 2)});
+  }
+  for (auto& input : inputs) {
+    send(1, &input);
+  }
+  auto hits = 0;
+  for (auto& input : inputs) {
+    hits += send(1, &input) ? 1 : 0;
+  }
+  EXPECT_GT(hits, 0);
+  EXPECT_LT(hits, count);
+
+  // shrinking the budget to zero evicts everything and disables the cache
+  cache_->setMaxBytes(0);
+  EXPECT_FALSE(send(1, &inputs.front()));
+  EXPECT_FALSE(send(1, &inputs.front()));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitResponseCacheFixture, Invalidate) {
+  std::vector<uint8_t> values{1, 2, 3};
+  EXPECT_FALSE(send(1, &values));
+  EXPECT_FALSE(send(2, &values));
+  cache_->invalidate(1);
+  EXPECT_FALSE(send(1, &values));
+  EXPECT_TRUE(send(2, &values));
+}
+
+}  // namespace amdinfer
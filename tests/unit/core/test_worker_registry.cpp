@@ -0,0 +1,35 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "amdinfer/core/worker_registry.hpp"  // for findWorker, registerWorker
+#include "gtest/gtest.h"                      // for Test, EXPECT_EQ, TEST
+
+namespace amdinfer {
+
+workers::Worker* makeNothing() { return nullptr; }
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitWorkerRegistry, FindWorker) {
+  EXPECT_EQ(findWorker("unitworker"), nullptr);
+
+  EXPECT_TRUE(registerWorker("UnitWorker", makeNothing));
+  // the name is case-insensitive and the configuration tag is ignored
+  EXPECT_EQ(findWorker("unitworker"), &makeNothing);
+  EXPECT_EQ(findWorker("UnitWorker-config"), &makeNothing);
+  EXPECT_EQ(findWorker("unit"), nullptr);
+
+  EXPECT_FALSE(registerWorker("unitworker", makeNothing));
+}
+
+}  // namespace amdinfer
@@ -0,0 +1,127 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <array>    // for array
+#include <cstddef>  // for byte, size_t
+#include <cstdint>  // for int8_t, uint8_t, int64_t
+#include <cstring>  // for memcpy
+#include <limits>   // for numeric_limits
+#include <string>   // for string
+#include <utility>  // for move
+#include <vector>   // for vector
+
+#include "amdinfer/core/data_types.hpp"          // for DataType, fp16
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/servers/json_writer.hpp"      // for JsonWriter
+#include "gtest/gtest.h"                         // for Test, EXPECT_EQ
+
+namespace amdinfer {
+
+template <typename T>
+std::string writeArray(DataType type, const std::vector<T>& data) {
+  JsonWriter writer;
+  writer.array(type, data.data(), data.size());
+  EXPECT_LE(writer.str().size(), estimateJsonSize(type, data.size()));
+  return std::move(writer).str();
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitJsonWriter, Strings) {
+  JsonWriter writer;
+  writer.string("plain");
+  writer.comma();
+  writer.string("quote\" backslash\\ newline\n return\r tab\t");
+  writer.comma();
+  writer.string(std::string{"\x01\x1f\0", 3});
+  writer.comma();
+  writer.key("key");
+  writer.string("");
+  EXPECT_EQ(writer.str(),
+            R"("plain",)"
+            R"("quote\" backslash\\ newline\n return\r tab\t",)"
+            R"("\u0001\u001f\u0000","key":"")");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitJsonWriter, Floats) {
+  const auto inf = std::numeric_limits<float>::infinity();
+  const std::vector<float> floats{0.5F, -2.0F, 1.0F / 3.0F,
+                                  std::numeric_limits<float>::quiet_NaN(), inf,
+                                  -inf};
+  EXPECT_EQ(writeArray(DataType::Fp32, floats),
+            "[0.5,-2,0.33333334,null,1e+9999,-1e+9999]");
+
+  const std::vector<double> doubles{0.1, std::numeric_limits<double>::lowest(),
+                                    std::numeric_limits<double>::quiet_NaN()};
+  EXPECT_EQ(writeArray(DataType::Fp64, doubles),
+            "[0.1,-1.7976931348623157e+308,null]");
+
+  const std::vector<fp16> halves{fp16{1.5F}, fp16{-0.25F}, fp16{65504.0F},
+                                 fp16{inf}};
+  EXPECT_EQ(writeArray(DataType::Fp16, halves), "[1.5,-0.25,65504,1e+9999]");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitJsonWriter, Integers) {
+  // 8-bit types are printed as numbers and not characters
+  const std::vector<int8_t> int8s{-128, 0, 127};
+  EXPECT_EQ(writeArray(DataType::Int8, int8s), "[-128,0,127]");
+  const std::vector<uint8_t> uint8s{0, 65, 255};
+  EXPECT_EQ(writeArray(DataType::Uint8, uint8s), "[0,65,255]");
+
+  const std::vector<int64_t> int64s{std::numeric_limits<int64_t>::min(), 0};
+  EXPECT_EQ(writeArray(DataType::Int64, int64s), "[-9223372036854775808,0]");
+
+  const std::array<bool, 2> bools{true, false};
+  JsonWriter writer;
+  writer.array(DataType::Bool, bools.data(), bools.size());
+  EXPECT_EQ(writer.str(), "[true,false]");
+
+  EXPECT_EQ(writeArray(DataType::Int32, std::vector<int32_t>{}), "[]");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitJsonWriter, Bytes) {
+  // string data is written as a single escaped string
+  const std::string data{"a \"b\"\n"};
+  JsonWriter writer;
+  writer.array(DataType::Bytes, data.data(), data.size());
+  EXPECT_EQ(writer.str(), R"(["a \"b\"\n"])");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitJsonWriter, Response) {
+  const std::vector<int8_t> values{-1, 2};
+  std::vector<std::byte> data(values.size());
+  std::memcpy(data.data(), values.data(), data.size());
+
+  InferenceResponseOutput output;
+  output.setName("out\"put");
+  output.setDatatype(DataType::Int8);
+  output.setShape({1, 2});
+  output.setData(std::move(data));
+
+  InferenceResponse response;
+  response.setModel("model");
+  response.setID("id");
+  response.addOutput(output);
+
+  EXPECT_EQ(writeInferenceResponse(response),
+            R"({"model_name":"model","outputs":[{"name":"out\"put",)"
+            R"("parameters":{},"data":[-1,2],"shape":[1,2],)"
+            R"("datatype":"INT8"}],"id":"id"})");
+}
+
+}  // namespace amdinfer
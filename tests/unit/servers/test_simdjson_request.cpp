@@ -0,0 +1,231 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <json/reader.h>  // for CharReaderBuilder, CharReader
+#include <json/value.h>   // for Value
+
+#include <cstring>  // for memcmp
+#include <limits>   // for numeric_limits
+#include <memory>   // for make_shared, unique_ptr
+#include <string>   // for string
+#include <tuple>    // for ignore
+#include <vector>   // for vector
+
+#include "amdinfer/core/exceptions.hpp"           // for invalid_argument
+#include "amdinfer/core/inference_request.hpp"    // for InferenceRequest
+#include "amdinfer/core/memory_pool/pool.hpp"     // for MemoryPool
+#include "amdinfer/servers/http_server.hpp"       // for getRequest
+#include "amdinfer/servers/simdjson_request.hpp"  // for parseInferenceRequest
+#include "gtest/gtest.h"                          // for Test, EXPECT_EQ
+
+namespace amdinfer {
+
+/// Parse the body with jsoncpp and the original request parser
+InferenceRequestPtr parseJsoncpp(const std::string& body,
+                                 const MemoryPool* pool) {
+  auto root = std::make_shared<Json::Value>();
+  const Json::CharReaderBuilder builder;
+  const std::unique_ptr<Json::CharReader> reader{builder.newCharReader()};
+  std::string errors;
+  if (!reader->parse(body.data(), body.data() + body.size(), root.get(),
+                     &errors)) {
+    throw invalid_argument(errors);
+  }
+  return getRequest(root, pool);
+}
+
+void freeInputs(const InferenceRequest& request, const MemoryPool* pool) {
+  for (const auto& input : request.getInputs()) {
+    pool->put(MemoryAllocators::Cpu, input.getData());
+  }
+}
+
+/// Parse the body with both parsers and check that they agree
+void expectSameRequest(const std::string& body) {
+  const MemoryPool pool;
+  const auto expected = parseJsoncpp(body, &pool);
+  const auto actual = parseInferenceRequest(body, &pool);
+
+  EXPECT_EQ(actual->getID(), expected->getID());
+  EXPECT_EQ(actual->getParameters().data(), expected->getParameters().data());
+
+  const auto& actual_inputs = actual->getInputs();
+  const auto& expected_inputs = expected->getInputs();
+  ASSERT_EQ(actual_inputs.size(), expected_inputs.size());
+  for (size_t i = 0; i < actual_inputs.size(); ++i) {
+    const auto& actual_input = actual_inputs[i];
+    const auto& expected_input = expected_inputs[i];
+    EXPECT_EQ(actual_input.getName(), expected_input.getName());
+    EXPECT_EQ(actual_input.getShape(), expected_input.getShape());
+    EXPECT_EQ(actual_input.getDatatype(), expected_input.getDatatype());
+    EXPECT_EQ(actual_input.getParameters().data(),
+              expected_input.getParameters().data());
+    const auto size =
+      actual_input.getSize() * actual_input.getDatatype().size();
+    EXPECT_EQ(std::memcmp(actual_input.getData(), expected_input.getData(),
+                          size),
+              0)
+      << "Data of " << actual_input.getName() << " differs";
+  }
+
+  const auto& actual_outputs = actual->getOutputs();
+  const auto& expected_outputs = expected->getOutputs();
+  ASSERT_EQ(actual_outputs.size(), expected_outputs.size());
+  for (size_t i = 0; i < actual_outputs.size(); ++i) {
+    EXPECT_EQ(actual_outputs[i].getName(), expected_outputs[i].getName());
+    EXPECT_EQ(actual_outputs[i].getParameters().data(),
+              expected_outputs[i].getParameters().data());
+  }
+
+  freeInputs(*actual, &pool);
+  freeInputs(*expected, &pool);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitSimdjsonRequest, Datatypes) {
+  expectSameRequest(R"({
+    "id": "datatypes",
+    "inputs": [
+      {"name": "bool", "shape": [2], "datatype": "BOOL",
+       "data": [true, false]},
+      {"name": "uint8", "shape": [3], "datatype": "UINT8",
+       "data": [0, 128, 255]},
+      {"name": "int8", "shape": [3], "datatype": "INT8",
+       "data": [-128, 0, 127]},
+      {"name": "int16", "shape": [2], "datatype": "INT16",
+       "data": [-32768, 32767]},
+      {"name": "uint32", "shape": [1], "datatype": "UINT32",
+       "data": [4294967295]},
+      {"name": "int64", "shape": [2], "datatype": "INT64",
+       "data": [-9223372036854775808, 9223372036854775807]},
+      {"name": "fp16", "shape": [2], "datatype": "FP16", "data": [1.5, -0.25]},
+      {"name": "fp32", "shape": [2, 2], "datatype": "FP32",
+       "data": [0.1, -2, 3.5e10, 1e-7]},
+      {"name": "fp64", "shape": [2], "datatype": "FP64",
+       "data": [0.1, -1.7976931348623157e308]},
+      {"name": "bytes", "shape": [11], "datatype": "BYTES",
+       "data": ["hello", "a\"b\n"]}
+    ]
+  })");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitSimdjsonRequest, KeyOrder) {
+  // keys in the reverse of the usual KServe order at every level
+  expectSameRequest(R"({
+    "outputs": [{"parameters": {"top_k": 5}, "name": "output0"}],
+    "inputs": [
+      {"data": [1, 2, 3], "parameters": {"binary": false},
+       "datatype": "INT32", "shape": [3], "name": "input0"},
+      {"parameters": {}, "shape": [1], "data": [4], "name": "input1",
+       "datatype": "INT32"}
+    ],
+    "parameters": {"priority": 1},
+    "id": "reversed"
+  })");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitSimdjsonRequest, Parameters) {
+  // non-negative integers are ints and all other numbers are doubles
+  expectSameRequest(R"({
+    "parameters": {"string": "value", "escaped": "a\tb", "true": true,
+                   "false": false, "int": 3, "zero": 0, "negative": -2,
+                   "double": 2.5},
+    "inputs": [
+      {"name": "input0", "shape": [1], "datatype": "FP32", "data": [1],
+       "parameters": {"string": "", "int": 2147483647, "double": -0.5}}
+    ]
+  })");
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitSimdjsonRequest, LargeIntegers) {
+  // integers that don't fit in an int are doubles rather than overflowing
+  const MemoryPool pool;
+  const std::string body = R"({
+    "parameters": {"int": 2147483647, "large": 2147483648,
+                   "uint64": 18446744073709551615},
+    "inputs": [{"name": "a", "shape": [1], "datatype": "INT32", "data": [1]}]
+  })";
+  const auto request = parseInferenceRequest(body, &pool);
+  const auto& parameters = request->getParameters();
+  EXPECT_EQ(parameters.get<int>("int"), std::numeric_limits<int>::max());
+  EXPECT_DOUBLE_EQ(parameters.get<double>("large"), 2147483648.0);
+  EXPECT_DOUBLE_EQ(parameters.get<double>("uint64"), 18446744073709551615.0);
+  freeInputs(*request, &pool);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitSimdjsonRequest, Malformed) {
+  const MemoryPool pool;
+  const std::string valid =
+    R"({"inputs": [{"name": "a", "shape": [2], "datatype": "INT32",)"
+    R"( "data": [1, 2]}]})";
+
+  auto request = parseInferenceRequest(valid, &pool);
+  const auto* address = request->getInputs()[0].getData();
+  freeInputs(*request, &pool);
+
+  const std::vector<std::string> bodies{
+    // invalid JSON
+    "",
+    "{",
+    R"({"inputs": [{"name": "a", "shape": [2], "datatype": "INT32", )"
+    R"("data": [1, 2]})",
+    // invalid requests
+    R"({"id": "no inputs"})",
+    R"({"inputs": {}})",
+    R"({"inputs": [1]})",
+    R"({"inputs": [{"shape": [1], "datatype": "INT32", "data": [1]}]})",
+    R"({"inputs": [{"name": "a", "datatype": "INT32", "data": [1]}]})",
+    R"({"inputs": [{"name": "a", "shape": [-1], "datatype": "INT32", )"
+    R"("data": [1]}]})",
+    R"({"inputs": [{"name": "a", "shape": [1], "data": [1]}]})",
+    R"({"inputs": [{"name": "a", "shape": [1], "datatype": "INT32"}]})",
+    R"({"inputs": [{"name": "a", "shape": [1], "datatype": "INT32", )"
+    R"("data": ["1"]}]})",
+    R"({"inputs": [{"name": "a", "shape": [1], "datatype": "INT32", )"
+    R"("data": [1], "parameters": {"list": []}}]})",
+    R"({"parameters": {"null": null}, "inputs": []})",
+    // errors after an input's buffer has been allocated
+    R"({"inputs": [{"name": "a", "shape": [2], "datatype": "INT32", )"
+    R"("data": [1, 2]}, {"name": "b", "shape": [1], "datatype": "FP32", )"
+    R"("data": [true]}]})",
+    R"({"inputs": [{"name": "a", "shape": [2], "datatype": "INT32", )"
+    R"("data": [1, 2]}], "outputs": 1})",
+  };
+  for (const auto& body : bodies) {
+    EXPECT_THROW(std::ignore = parseInferenceRequest(body, &pool),
+                 invalid_argument)
+      << body;
+  }
+
+  // data that doesn't fit the declared shape is rejected rather than written
+  // past the end of the buffer
+  EXPECT_THROW(std::ignore = parseInferenceRequest(
+                 R"({"inputs": [{"name": "a", "shape": [1], )"
+                 R"("datatype": "INT32", "data": [1, 2]}]})",
+                 &pool),
+               invalid_argument);
+
+  // every buffer allocated before the errors was returned to the pool so the
+  // same memory is handed out again
+  request = parseInferenceRequest(valid, &pool);
+  EXPECT_EQ(request->getInputs()[0].getData(), address);
+  freeInputs(*request, &pool);
+}
+
+}  // namespace amdinfer
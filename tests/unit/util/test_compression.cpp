@@ -14,12 +14,25 @@
 
 #include <array>   // for array
 #include <memory>  // for allocator
+#include <string>  // for string
 
-#include "amdinfer/util/compression.hpp"  // for zDecompress
+#include "amdinfer/build_options.hpp"    // for AMDINFER_ENABLE_ZSTD
+#include "amdinfer/core/exceptions.hpp"   // for invalid_argument
+#include "amdinfer/util/compression.hpp"  // for zDecompress, compress
 #include "gtest/gtest.h"                  // for Test, SuiteApiResolver, EXP...
 
 namespace amdinfer {
 
+std::string decompressAll(util::Encoding encoding, const std::string& data,
+                          size_t max_size) {
+  std::string decompressed;
+  util::decompress(encoding, data, max_size,
+                   [&](const char* chunk, size_t size) {
+                     decompressed.append(chunk, size);
+                   });
+  return decompressed;
+}
+
 // NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
 TEST(UnitUtilCompression, Decompression) {
   // compressed "amdinfer" with zlib in Python
@@ -32,6 +45,70 @@ TEST(UnitUtilCompression, Decompression) {
   auto decompressed_str = util::zDecompress(data, compressed_data.size());
 
   EXPECT_EQ(decompressed_str, "amdinfer");
+
+  // the server's fallback for unlabelled compressed bodies
+  const std::string compressed{data, compressed_data.size()};
+  EXPECT_EQ(decompressAll(util::Encoding::Deflate, compressed, 8), "amdinfer");
+  EXPECT_THROW(decompressAll(util::Encoding::Deflate, compressed, 7),
+               invalid_argument);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitUtilCompression, RoundTrip) {
+  std::string data;
+  for (auto i = 0; i < 10000; ++i) {
+    data += "amdinfer" + std::to_string(i);
+  }
+
+  for (const auto encoding : {util::Encoding::Gzip, util::Encoding::Deflate}) {
+    const auto compressed = util::compress(encoding, data, -1);
+    EXPECT_LT(compressed.size(), data.size());
+    EXPECT_EQ(util::decompressedSizeHint(encoding, compressed) == 0,
+              encoding == util::Encoding::Deflate);
+    EXPECT_EQ(decompressAll(encoding, compressed, data.size()), data);
+    // exceeding the maximum size is an error
+    EXPECT_THROW(decompressAll(encoding, compressed, data.size() - 1),
+                 invalid_argument);
+    // as is truncated data
+    EXPECT_THROW(decompressAll(encoding, compressed.substr(0, 10), data.size()),
+                 invalid_argument);
+  }
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitUtilCompression, DisabledEncodings) {
+  const std::string data{"amdinfer"};
+#ifndef AMDINFER_ENABLE_ZSTD
+  EXPECT_THROW(decompressAll(util::Encoding::Zstd, data, data.size()),
+               invalid_argument);
+#endif
+#ifndef AMDINFER_ENABLE_LZ4
+  EXPECT_THROW(decompressAll(util::Encoding::Lz4, data, data.size()),
+               invalid_argument);
+#endif
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitUtilCompression, ParseContentEncoding) {
+  EXPECT_EQ(util::parseContentEncoding(""), util::Encoding::Identity);
+  EXPECT_EQ(util::parseContentEncoding("identity"), util::Encoding::Identity);
+  EXPECT_EQ(util::parseContentEncoding("GZIP"), util::Encoding::Gzip);
+  EXPECT_EQ(util::parseContentEncoding(" deflate "), util::Encoding::Deflate);
+  EXPECT_THROW(util::parseContentEncoding("br"), invalid_argument);
+  EXPECT_THROW(util::parseContentEncoding("gzip, deflate"), invalid_argument);
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitUtilCompression, NegotiateEncoding) {
+  EXPECT_EQ(util::negotiateEncoding(""), util::Encoding::Identity);
+  EXPECT_EQ(util::negotiateEncoding("br"), util::Encoding::Identity);
+  EXPECT_EQ(util::negotiateEncoding("deflate"), util::Encoding::Deflate);
+  EXPECT_EQ(util::negotiateEncoding("deflate, gzip"), util::Encoding::Gzip);
+  EXPECT_EQ(util::negotiateEncoding("gzip;q=0, deflate"),
+            util::Encoding::Deflate);
+  EXPECT_EQ(util::negotiateEncoding("gzip;q=0.5, deflate;q=0.8"),
+            util::Encoding::Deflate);
+  EXPECT_NE(util::negotiateEncoding("*"), util::Encoding::Identity);
 }
 
 }  //  namespace amdinfer
@@ -0,0 +1,42 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstddef>  // for size_t
+#include <vector>   // for vector
+
+#include "amdinfer/core/exceptions.hpp"  // for invalid_argument
+#include "amdinfer/util/string.hpp"      // for parseBatchSizes
+#include "gtest/gtest.h"                 // for Test, EXPECT_EQ, EXPECT_THROW
+
+namespace amdinfer {
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST(UnitUtilString, ParseBatchSizes) {
+  EXPECT_EQ(util::parseBatchSizes("4", "sizes"), std::vector<size_t>{4});
+  EXPECT_EQ(util::parseBatchSizes("1,4,16", "sizes"),
+            (std::vector<size_t>{1, 4, 16}));
+  EXPECT_EQ(util::parseBatchSizes(" 1, 2 ,8 ", "sizes"),
+            (std::vector<size_t>{1, 2, 8}));
+
+  for (const auto* invalid :
+       {"", " ", "4abc", "abc", "4.5", "0", "-1", "1,,2", "1,", "+2", "1 2",
+        "99999999999999999999999"}) {
+    EXPECT_THROW((void)util::parseBatchSizes(invalid, "sizes"),
+                 invalid_argument)
+      << invalid;
+  }
+}
+
+}  // namespace amdinfer
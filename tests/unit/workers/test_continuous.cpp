@@ -0,0 +1,185 @@
+// Copyright 2023 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <atomic>              // for atomic
+#include <chrono>              // for milliseconds
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for byte
+#include <cstdint>             // for uint32_t
+#include <functional>          // for function
+#include <memory>              // for make_shared, make_unique
+#include <mutex>               // for mutex, lock_guard, unique_lock
+#include <string>      // for string
+#include <thread>      // for thread
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "amdinfer/batching/batch.hpp"           // for Batch, BatchPtr
+#include "amdinfer/core/data_types.hpp"          // for DataType
+#include "amdinfer/core/inference_request.hpp"   // for InferenceRequest
+#include "amdinfer/core/inference_response.hpp"  // for InferenceResponse
+#include "amdinfer/core/parameters.hpp"          // for ParameterMap
+#include "amdinfer/workers/worker.hpp"           // for ContinuousWorker
+#include "gtest/gtest.h"                         // for Test, EXPECT_EQ
+
+namespace amdinfer {
+
+// timeout in ms to wait for the worker's responses
+constexpr auto kTimeoutMs = 1000;
+
+/**
+ * @brief A toy autoregressive model: each request's input is the number of
+ * tokens to generate and each step emits the next token, counting from zero
+ */
+class Counter : public workers::ContinuousWorker {
+ public:
+  Counter() : ContinuousWorker("Counter", "cpu", false) {}
+
+  [[nodiscard]] std::vector<MemoryAllocators> getAllocators() const override {
+    return {MemoryAllocators::Cpu};
+  }
+
+  /// The number of steps run, across all sequences
+  std::atomic<int> steps = 0;
+
+ private:
+  void doInit(ParameterMap* parameters) override {
+    batch_size_ = parameters->get<int32_t>("batch_size");
+  }
+  void doAcquire([[maybe_unused]] ParameterMap* parameters) override {}
+  void doRelease() override {}
+  void doDestroy() override {}
+
+  void doStep(std::vector<workers::Sequence>& sequences,
+              [[maybe_unused]] const MemoryPool* pool) override {
+    for (auto& sequence : sequences) {
+      const auto& request = sequence.request;
+      const auto tokens =
+        *static_cast<uint32_t*>(request->getInputs()[0].getData());
+      auto token = static_cast<uint32_t>(sequence.step);
+
+      InferenceResponseOutput output;
+      output.setName("token");
+      output.setDatatype(DataType::Uint32);
+      output.setShape({1});
+      const auto* data = reinterpret_cast<std::byte*>(&token);
+      output.setData({data, data + sizeof(token)});
+      InferenceResponse response;
+      response.setID(request->getID());
+      response.addOutput(output);
+
+      if (sequence.step + 1 < tokens) {
+        request->runCallback(response);
+      } else {
+        request->runCallbackOnce(response);
+        sequence.finished = true;
+      }
+    }
+    steps++;
+  }
+};
+
+class UnitContinuousWorkerFixture : public testing::Test {
+ protected:
+  void SetUp() override {
+    ParameterMap parameters;
+    const int32_t batch_size = 2;
+    parameters.put("batch_size", batch_size);
+    worker_.init(&parameters);
+    thread_ = std::thread{[this]() { worker_.run(&queue_, nullptr); }};
+  }
+
+  void TearDown() override { stop(); }
+
+  /// Stop the worker once it has finished its sequences
+  void stop() {
+    if (thread_.joinable()) {
+      queue_.enqueue(nullptr);
+      thread_.join();
+    }
+  }
+
+  /// Make a request for the given number of tokens that logs its responses
+  InferenceRequestPtr makeRequest(const std::string& id, uint32_t tokens) {
+    auto& data = data_.emplace_back(std::make_unique<uint32_t>(tokens));
+    auto request = std::make_shared<InferenceRequest>();
+    request->setID(id);
+    request->addInputTensor(data.get(), {1}, DataType::Uint32);
+    request->setCallback([this](const InferenceResponse& response) {
+      const auto token =
+        *static_cast<uint32_t*>(response.getOutputs()[0].getData());
+      const std::lock_guard lock{mutex_};
+      log_.push_back(response.getID() + std::to_string(token));
+      if (on_response_) {
+        on_response_(response.getID() + std::to_string(token));
+      }
+      cv_.notify_all();
+    });
+    return request;
+  }
+
+  void enqueue(const std::vector<InferenceRequestPtr>& requests) {
+    auto batch = std::make_unique<Batch>();
+    for (const auto& request : requests) {
+      batch->addRequest(request);
+    }
+    queue_.enqueue(std::move(batch));
+  }
+
+  /// Wait until the log has the given number of responses or the timeout
+  std::vector<std::string> waitForLog(size_t size) {
+    std::unique_lock lock{mutex_};
+    cv_.wait_for(lock, std::chrono::milliseconds{kTimeoutMs},
+                 [&] { return log_.size() >= size; });
+    return log_;
+  }
+
+  Counter worker_;
+  BatchPtrQueue queue_;
+  std::thread thread_;
+  std::vector<std::unique_ptr<uint32_t>> data_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::string> log_;
+  std::function<void(const std::string&)> on_response_;
+};
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitContinuousWorkerFixture, Streaming) {
+  enqueue({makeRequest("a", 3)});
+  // every step's token is streamed back as it's generated
+  EXPECT_EQ(waitForLog(3), (std::vector<std::string>{"a0", "a1", "a2"}));
+}
+
+// NOLINTNEXTLINE(cert-err58-cpp, cppcoreguidelines-owning-memory)
+TEST_F(UnitContinuousWorkerFixture, JoinAndLeave) {
+  auto late = makeRequest("c", 1);
+  // c arrives while a and b are running and joins once b leaves
+  on_response_ = [&](const std::string& response) {
+    if (response == "a1") {
+      enqueue({late});
+    }
+  };
+  enqueue({makeRequest("a", 5), makeRequest("b", 2)});
+
+  // b and c finish without waiting for a, which is still running
+  EXPECT_EQ(waitForLog(8), (std::vector<std::string>{"a0", "b0", "a1", "b1",
+                                                     "a2", "c0", "a3", "a4"}));
+  // the last step is counted after its responses so wait for the worker to stop
+  stop();
+  EXPECT_EQ(worker_.steps, 5);
+}
+
+}  // namespace amdinfer
@@ -13,6 +13,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import base64
 import json
 
 import cv2
@@ -53,9 +54,10 @@ class TestInvertVideo:
         parameters_2.put("key", "0")
         request.parameters = parameters_2
 
-        self.ws_client.modelInferWs(self.endpoint, request)
-        response_str = self.ws_client.modelRecv()
-        response = json.loads(response_str)
+        self.ws_client.modelInferWsBinary(self.endpoint, request)
+        response = self.ws_client.modelRecvBinary()
+        assert not response.isError()
+        response = json.loads(bytes(response.getOutputs()[0].getStringData()))
 
         assert response["key"] == "0"
         assert float(response["data"]["img"]) == 15.0
@@ -64,12 +66,17 @@ class TestInvertVideo:
 
         cap = cv2.VideoCapture(video_path)
         for _ in range(count):
-            resp_str = self.ws_client.modelRecv()
-            resp = json.loads(resp_str)
-            resp_data = resp["data"]["img"].split(",")[1]
+            resp = self.ws_client.modelRecvBinary()
+            assert not resp.isError()
+            assert resp.getParameters().getString("key") == "0"
+            output = resp.getOutputs()[0]
+            assert output.name == "image"
+            assert output.datatype == amdinfer.DataType.UINT8
+            # the frame is sent as raw JPEG bytes
+            resp_data = base64.b64encode(bytes(output.getUint8Data()))
             _, frame = cap.read()
             frame = cv2.bitwise_not(frame)
-            compare_jpgs(resp_data.encode(), frame)
+            compare_jpgs(resp_data, frame)
 
     def test_invert_video_0(self):
         requested_frames_count = 100